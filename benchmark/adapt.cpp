@@ -0,0 +1,69 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares calling a delegate that wraps another delegate of a compatible signature, as created by
+// `create(std::move(other))`, with a delegate created by `adapt<F>(std::move(other))`, which calls
+// the function object of the other delegate with a single indirect call.
+
+#include <rome/delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Message {
+    int value;
+};
+
+struct Handler {
+    int* state;
+    void* padding;  // prevents small object optimization
+    void operator()(const Message& msg) const {
+        *state += msg.value;
+    }
+};
+
+using inner_delegate = rome::delegate<void(const Message&)>;
+using outer_delegate = rome::event_delegate<void(Message)>;
+
+template<typename Factory>
+void benchmarkCalls(const char* name, std::vector<int>& states, Factory factory) {
+    std::vector<outer_delegate> delegates;
+    delegates.reserve(states.size());
+    for (auto& state : states) {
+        delegates.push_back(factory(inner_delegate{Handler{&state, nullptr}}));
+    }
+    benchmark::run(name, states.size(), [&delegates](std::size_t /*unused*/) {
+        const Message msg{1};
+        for (const auto& dgt : delegates) {
+            dgt(msg);
+        }
+    });
+    benchmark::do_not_optimize(states.front());
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t count = 4096;
+
+    std::minstd_rand random{42};
+    std::vector<int> states(count);
+    for (auto& state : states) {
+        state = static_cast<int>(random() % 100U);
+    }
+
+    benchmarkCalls("create(std::move(other))", states,
+        [](inner_delegate&& other) { return outer_delegate::create(std::move(other)); });
+    benchmarkCalls("adapt<F>(std::move(other))", states, [](inner_delegate&& other) {
+        return outer_delegate::adapt<Handler>(std::move(other));
+    });
+}
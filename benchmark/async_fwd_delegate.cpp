@@ -0,0 +1,198 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares a `rome::async_fwd_delegate`, which stores the arguments in a preallocated slot and
+// posts a `rome::command_delegate<void()>`, with posting a `std::function<void()>` capturing the
+// arguments. The arguments are an `int` and a `std::string` too long for the small string
+// optimization.
+//   - post and run: posting 1k calls and running them in the same thread, time per call.
+//   - latency: posting one call to a worker thread and waiting until it was executed, time per
+//     call.
+
+#include <rome/async_fwd_delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t callCount = 1000;
+
+using Task  = std::function<void()>;
+using Async = rome::async_fwd_delegate<void(int, const std::string&)>;
+
+// Runs the posted tasks when requested.
+template<typename T>
+class ManualExecutor {
+    std::vector<T> tasks_;
+
+  public:
+    ManualExecutor() {
+        tasks_.reserve(callCount);
+    }
+
+    void post(T&& task) {
+        tasks_.push_back(std::move(task));
+    }
+
+    void run_all() {
+        for (auto& task : tasks_) {
+            task();
+        }
+        tasks_.clear();
+    }
+};
+
+// Runs the posted tasks in a worker thread.
+template<typename T>
+class ThreadExecutor {
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<T> tasks_;
+    bool stop_ = false;
+    std::thread worker_{[this]() { work(); }};
+
+    void work() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            wakeup_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+  public:
+    ThreadExecutor()                      = default;
+    ThreadExecutor(const ThreadExecutor&) = delete;
+    ThreadExecutor(ThreadExecutor&&)      = delete;
+
+    auto operator=(const ThreadExecutor&) -> ThreadExecutor& = delete;
+    auto operator=(ThreadExecutor&&) -> ThreadExecutor&      = delete;
+
+    ~ThreadExecutor() {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wakeup_.notify_one();
+        worker_.join();
+    }
+
+    void post(T&& task) {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.push_back(std::move(task));
+        }
+        wakeup_.notify_one();
+    }
+};
+
+// The target of the calls.
+struct Handler {
+    std::atomic<std::size_t> calls{0U};
+    std::size_t length = 0;
+
+    void handle(int value, const std::string& text) {
+        length += text.size() + static_cast<std::size_t>(value);
+        calls.fetch_add(1U, std::memory_order_release);
+    }
+
+    void wait_for(const std::size_t count) const {
+        while (calls.load(std::memory_order_acquire) < count) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+const std::string text = "a text too long for the small string optimization";
+
+void benchmarkPostAndRun() {
+    Handler handler;
+    {
+        ManualExecutor<Task> executor;
+        benchmark::run("post and run std::function", callCount,
+            [&executor, &handler](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    executor.post([&handler, i, copy = text]() {
+                        handler.handle(static_cast<int>(i), copy);
+                    });
+                }
+                executor.run_all();
+            });
+    }
+    {
+        ManualExecutor<Async::task_type> executor;
+        Async async{callCount,
+            Async::executor_type::create<ManualExecutor<Async::task_type>,
+                &ManualExecutor<Async::task_type>::post>(executor),
+            Async::delegate_type::create<Handler, &Handler::handle>(handler)};
+        benchmark::run("post and run rome::async_fwd_delegate", callCount,
+            [&executor, &async](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    (void)async(static_cast<int>(i), text);
+                }
+                executor.run_all();
+            });
+    }
+    benchmark::do_not_optimize(handler.length);
+}
+
+void benchmarkLatency() {
+    Handler handler;
+    {
+        ThreadExecutor<Task> executor;
+        benchmark::run("latency std::function", callCount,
+            [&executor, &handler](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    const auto count = handler.calls.load(std::memory_order_relaxed);
+                    executor.post([&handler, i, copy = text]() {
+                        handler.handle(static_cast<int>(i), copy);
+                    });
+                    handler.wait_for(count + 1);
+                }
+            });
+    }
+    {
+        ThreadExecutor<Async::task_type> executor;
+        Async async{callCount,
+            Async::executor_type::create<ThreadExecutor<Async::task_type>,
+                &ThreadExecutor<Async::task_type>::post>(executor),
+            Async::delegate_type::create<Handler, &Handler::handle>(handler)};
+        benchmark::run("latency rome::async_fwd_delegate", callCount,
+            [&async, &handler](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    const auto count = handler.calls.load(std::memory_order_relaxed);
+                    (void)async(static_cast<int>(i), text);
+                    handler.wait_for(count + 1);
+                }
+            });
+    }
+    benchmark::do_not_optimize(handler.length);
+}
+
+}  // namespace
+
+int main() {
+    benchmarkPostAndRun();
+    benchmarkLatency();
+}
@@ -0,0 +1,186 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares a lock-free `rome::broadcast_ring` with a ring protected by a `std::mutex`, for 1 to 16
+// consumer threads. Each value is a small market data tick with the time it was published.
+//   - throughput: publishing 10k ticks and waiting until all consumers have read them, time per
+//     tick.
+//   - p99 latency: the 99th percentile of the time from publishing a tick until a consumer reads
+//     it, over all ticks and consumers of one throughput run.
+
+#include <rome/broadcast_ring.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t tickCount = 10000;
+constexpr std::size_t capacity  = 1024;
+
+using clock = std::chrono::steady_clock;
+
+struct Tick {
+    std::int64_t published = 0;  // nanoseconds since the epoch of `clock`
+    std::int64_t price     = 0;
+    std::int64_t quantity  = 0;
+};
+
+auto now() -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch())
+        .count();
+}
+
+// The same interface as `rome::broadcast_ring`, every access locks one mutex.
+template<typename T>
+class LockedRing {
+    std::mutex mutex_;
+    std::vector<T> values_;
+    std::vector<std::size_t> sequences_;
+    std::vector<rome::event_delegate<void(const T&)>> delegates_;
+    std::size_t published_ = 0;
+
+    auto has_space() const -> bool {
+        return std::all_of(sequences_.begin(), sequences_.end(),
+            [this](std::size_t sequence) { return published_ - sequence < values_.size(); });
+    }
+
+  public:
+    explicit LockedRing(const std::size_t capacity) : values_(capacity) {
+    }
+
+    template<typename D>
+    auto connect(D&& target) -> std::size_t {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        sequences_.push_back(published_);
+        delegates_.emplace_back(std::forward<D>(target));
+        return delegates_.size() - 1;
+    }
+
+    void publish(const T& value) {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (!has_space()) {
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+        }
+        values_[published_ % values_.size()] = value;
+        ++published_;
+    }
+
+    auto pending(const std::size_t index) -> std::size_t {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        return published_ - sequences_[index];
+    }
+
+    auto poll(const std::size_t index) -> std::size_t {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        const auto from = sequences_[index];
+        for (auto i = from; i != published_; ++i) {
+            delegates_[index](values_[i % values_.size()]);
+        }
+        sequences_[index] = published_;
+        return published_ - from;
+    }
+};
+
+// Records the latency of each tick read.
+struct Consumer {
+    std::vector<std::int64_t> latencies;
+    std::int64_t volume = 0;
+
+    Consumer() {
+        latencies.reserve(tickCount);
+    }
+
+    void on_tick(const Tick& tick) {
+        latencies.push_back(now() - tick.published);
+        volume += tick.quantity;
+    }
+};
+
+template<typename Ring>
+void benchmarkRing(const std::string& name, const std::size_t consumerCount) {
+    Ring ring{capacity};
+    std::vector<std::unique_ptr<Consumer>> consumers;
+    for (std::size_t c = 0; c < consumerCount; ++c) {
+        consumers.push_back(std::make_unique<Consumer>());
+        (void)ring.connect(
+            rome::event_delegate<void(const Tick&)>::create<Consumer, &Consumer::on_tick>(
+                *consumers.back()));
+    }
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (std::size_t c = 0; c < consumerCount; ++c) {
+        threads.emplace_back([&ring, &stop, c]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (ring.poll(c) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    benchmark::run((name + " throughput " + std::to_string(consumerCount)).c_str(), tickCount,
+        [&ring, &consumers](std::size_t iterations) {
+            for (auto& consumer : consumers) {
+                consumer->latencies.clear();
+            }
+            for (std::size_t i = 0; i < iterations; ++i) {
+                ring.publish(Tick{now(), static_cast<std::int64_t>(i), 1});
+            }
+            for (std::size_t c = 0; c < consumers.size(); ++c) {
+                while (ring.pending(c) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    std::atomic_thread_fence(std::memory_order_acquire);  // the latencies are complete
+
+    // the latencies of the last run
+    std::vector<std::int64_t> latencies;
+    for (const auto& consumer : consumers) {
+        latencies.insert(latencies.end(), consumer->latencies.begin(), consumer->latencies.end());
+    }
+    const auto p99Index = latencies.size() * 99 / 100;
+    std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(p99Index),
+        latencies.end());
+    std::cout << std::left << std::setw(48)
+              << (name + " p99 latency " + std::to_string(consumerCount)) << std::right
+              << std::setw(10) << latencies[p99Index] << " ns\n";
+
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& consumer : consumers) {
+        benchmark::do_not_optimize(consumer->volume);
+    }
+}
+
+}  // namespace
+
+int main() {
+    for (const std::size_t consumerCount : {1U, 2U, 4U, 8U, 16U}) {
+        benchmarkRing<LockedRing<Tick>>("mutex ring", consumerCount);
+        benchmarkRing<rome::broadcast_ring<Tick>>("rome::broadcast_ring", consumerCount);
+    }
+}
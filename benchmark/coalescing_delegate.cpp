@@ -0,0 +1,110 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares forwarding every sensor value to its consumer by a `rome::event_delegate` with
+// coalescing the values by a `rome::coalescing_delegate`, which is flushed once per control
+// cycle of 10 values.
+//   - produce: time per value, including the calls of the consumer.
+//   - produce, concurrent flush: time per value stored by the producer, while another thread
+//     flushes continuously.
+// After the times, the number of consumer calls (wakeups) per 10k values is printed.
+
+#include <rome/coalescing_delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+constexpr std::size_t valueCount     = 10000;
+constexpr std::size_t valuesPerCycle = 10;
+
+// A low-pass filter as example of a consumer.
+struct Consumer {
+    float state       = 0.0F;
+    std::size_t calls = 0;
+
+    void consume(float value) {
+        state = 0.9F * state + 0.1F * value;
+        ++calls;
+    }
+};
+
+auto benchmarkForward() -> std::size_t {
+    Consumer consumer;
+    const auto sensor =
+        rome::event_delegate<void(float)>::create<Consumer, &Consumer::consume>(consumer);
+    benchmark::run("produce rome::event_delegate", valueCount, [&sensor](std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            sensor(static_cast<float>(i));
+        }
+    });
+    benchmark::do_not_optimize(consumer.state);
+    return consumer.calls;
+}
+
+auto benchmarkCoalesce() -> std::size_t {
+    Consumer consumer;
+    rome::coalescing_delegate<void(float)> sensor{
+        rome::event_delegate<void(float)>::create<Consumer, &Consumer::consume>(consumer)};
+    benchmark::run("produce rome::coalescing_delegate", valueCount,
+        [&sensor](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                sensor(static_cast<float>(i));
+                if (i % valuesPerCycle == valuesPerCycle - 1) {
+                    (void)sensor.flush();
+                }
+            }
+        });
+    benchmark::do_not_optimize(consumer.state);
+    return consumer.calls;
+}
+
+auto benchmarkConcurrentFlush() -> std::size_t {
+    Consumer consumer;
+    rome::coalescing_delegate<void(float)> sensor{
+        rome::event_delegate<void(float)>::create<Consumer, &Consumer::consume>(consumer)};
+    std::atomic<bool> running{true};
+    std::thread flusher{[&sensor, &running]() {
+        while (running.load(std::memory_order_relaxed)) {
+            (void)sensor.flush();
+        }
+    }};
+    benchmark::run("produce concurrent rome::coalescing_delegate", valueCount,
+        [&sensor](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                sensor(static_cast<float>(i));
+            }
+        });
+    running.store(false, std::memory_order_relaxed);
+    flusher.join();
+    benchmark::do_not_optimize(consumer.state);
+    return consumer.calls;
+}
+
+// Returns the number of consumer calls per `valueCount` values. Each benchmark produces its values
+// 11 times, once to warm up and 10 times measured.
+auto perValueCount(const std::size_t calls) -> double {
+    return static_cast<double>(calls) / 11.0;
+}
+
+}  // namespace
+
+int main() {
+    const auto forwardCalls    = benchmarkForward();
+    const auto coalesceCalls   = benchmarkCoalesce();
+    const auto concurrentCalls = benchmarkConcurrentFlush();
+    std::cout << "wakeups per 10k values rome::event_delegate: " << perValueCount(forwardCalls)
+              << "\nwakeups per 10k values rome::coalescing_delegate: "
+              << perValueCount(coalesceCalls)
+              << "\nwakeups per 10k values concurrent rome::coalescing_delegate: "
+              << perValueCount(concurrentCalls) << '\n';
+}
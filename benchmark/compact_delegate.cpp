@@ -0,0 +1,82 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares calling all delegates in an array of `rome::delegate`, which has the size of three
+// pointers, with an array of `rome::compact_delegate`, which has the size of two pointers but needs
+// one more dependent load per call. A small array fits into the cache and shows the call latency,
+// a large array does not and shows the effect of the smaller memory footprint.
+
+#include <rome/compact_delegate.hpp>
+#include <rome/delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Add {
+    int summand;
+    auto operator()(int value) const -> int {
+        return value + summand;
+    }
+};
+
+struct Xor {
+    int mask;
+    auto operator()(int value) const -> int {
+        return value ^ mask;
+    }
+};
+
+template<typename Delegate>
+auto createDelegates(const std::size_t count) -> std::vector<Delegate> {
+    std::minstd_rand random{42};
+    std::vector<Delegate> delegates;
+    delegates.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto value = static_cast<int>(random() % 7U) + 1;
+        if (random() % 2U == 0U) {
+            delegates.emplace_back(Add{value});
+        }
+        else {
+            delegates.emplace_back(Xor{value});
+        }
+    }
+    return delegates;
+}
+
+template<typename Delegate>
+void benchmarkCalls(const char* name, const std::size_t count) {
+    const auto delegates = createDelegates<Delegate>(count);
+    benchmark::run(name, count, [&delegates](std::size_t /*unused*/) {
+        int value = 1;
+        for (const auto& dgt : delegates) {
+            value = dgt(value);
+        }
+        benchmark::do_not_optimize(value);
+    });
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t smallCount = 4096;
+    constexpr std::size_t largeCount = 4194304;
+
+    std::cout << "sizeof(rome::delegate)         = " << sizeof(rome::delegate<int(int)>) << '\n'
+              << "sizeof(rome::compact_delegate) = " << sizeof(rome::compact_delegate<int(int)>)
+              << '\n';
+
+    benchmarkCalls<rome::delegate<int(int)>>("rome::delegate, 4K", smallCount);
+    benchmarkCalls<rome::compact_delegate<int(int)>>("rome::compact_delegate, 4K", smallCount);
+    benchmarkCalls<rome::delegate<int(int)>>("rome::delegate, 4M", largeCount);
+    benchmarkCalls<rome::compact_delegate<int(int)>>("rome::compact_delegate, 4M", largeCount);
+}
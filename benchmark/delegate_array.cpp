@@ -0,0 +1,91 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares calling all targets of a `std::vector` of `rome::delegate`s, an array of structures,
+// with a `rome::delegate_array`, which stores its invoking functions, deleting functions and
+// storages in separate columns. The calls only read the invoking functions and the storages. The
+// targets are of four different types in random order, `sort_by_target` groups them.
+
+#include <rome/delegate.hpp>
+#include <rome/delegate_array.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+template<int factor>
+struct Scale {
+    float* sum;
+    void operator()(float value) const {
+        *sum += value * static_cast<float>(factor);
+    }
+};
+
+// Appends `count` targets of random type to `targets`, by calling `append` with each target.
+template<typename Append>
+void createTargets(const std::size_t count, float* sum, Append append) {
+    std::minstd_rand random{42};
+    for (std::size_t i = 0; i < count; ++i) {
+        switch (random() % 4U) {
+        case 0:
+            append(Scale<1>{sum});
+            break;
+        case 1:
+            append(Scale<2>{sum});
+            break;
+        case 2:
+            append(Scale<3>{sum});
+            break;
+        default:
+            append(Scale<4>{sum});
+            break;
+        }
+    }
+}
+
+void benchmarkCount(const std::size_t count, const char* suffix) {
+    float sum = 0.0F;
+
+    std::vector<rome::delegate<void(float)>> vector;
+    vector.reserve(count);
+    createTargets(count, &sum, [&vector](auto target) { vector.emplace_back(target); });
+    auto name = std::string{"std::vector<rome::delegate>, "} + suffix;
+    benchmark::run(name.c_str(), count, [&](std::size_t /*unused*/) {
+        for (const auto& dgt : vector) {
+            dgt(1.0F);
+        }
+        benchmark::do_not_optimize(sum);
+    });
+
+    rome::delegate_array<void(float)> array;
+    array.reserve(count);
+    createTargets(count, &sum, [&array](auto target) { array.push_back(target); });
+    name = std::string{"rome::delegate_array, "} + suffix;
+    benchmark::run(name.c_str(), count, [&](std::size_t /*unused*/) {
+        array.invoke_all(1.0F);
+        benchmark::do_not_optimize(sum);
+    });
+
+    array.sort_by_target();
+    name = std::string{"rome::delegate_array sorted, "} + suffix;
+    benchmark::run(name.c_str(), count, [&](std::size_t /*unused*/) {
+        array.invoke_all(1.0F);
+        benchmark::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main() {
+    benchmarkCount(4096, "4K");
+    benchmarkCount(4194304, "4M");
+}
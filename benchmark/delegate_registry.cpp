@@ -0,0 +1,103 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares a `rome::delegate_registry`, whose connections are generational slot indices, with a
+// registry tracking its connections by `std::weak_ptr`s to shared `std::function`s.
+//   - churn: connecting and disconnecting one target, time per connect and disconnect.
+//   - validate: checking whether a connection is still connected, time per check.
+//   - emit: calling 10k targets, time per target.
+
+#include <rome/delegate_registry.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t targetCount = 10000;
+
+// A registry as it is often written, the connections are weak pointers to the targets.
+class SharedRegistry {
+    std::vector<std::shared_ptr<std::function<void(int)>>> targets_;
+
+  public:
+    using connection = std::weak_ptr<std::function<void(int)>>;
+
+    template<typename F>
+    auto connect(F target) -> connection {
+        targets_.push_back(std::make_shared<std::function<void(int)>>(std::move(target)));
+        return targets_.back();
+    }
+
+    auto contains(const connection& conn) const noexcept -> bool {
+        return !conn.expired();
+    }
+
+    auto disconnect(const connection& conn) -> bool {
+        // searches from the back, the benchmark disconnects the last connected target
+        const auto target = conn.lock();
+        const auto it     = std::find(targets_.rbegin(), targets_.rend(), target);
+        if (target == nullptr || it == targets_.rend()) {
+            return false;
+        }
+        *it = std::move(targets_.back());
+        targets_.pop_back();
+        return true;
+    }
+
+    void operator()(int value) const {
+        for (const auto& target : targets_) {
+            (*target)(value);
+        }
+    }
+};
+
+using RomeRegistry = rome::delegate_registry<void(int)>;
+
+template<typename Registry>
+void benchmarkRegistry(const char* churnName, const char* validateName, const char* emitName) {
+    int sum = 0;
+    Registry registry;
+    std::vector<typename Registry::connection> connections;
+    for (std::size_t i = 0; i < targetCount; ++i) {
+        connections.push_back(registry.connect([&sum](int value) { sum += value; }));
+    }
+
+    benchmark::run(churnName, targetCount, [&registry, &sum](std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const auto conn = registry.connect([&sum](int value) { sum -= value; });
+            (void)registry.disconnect(conn);
+        }
+    });
+
+    benchmark::run(validateName, targetCount, [&registry, &connections](std::size_t /*unused*/) {
+        std::size_t count = 0;
+        for (const auto& conn : connections) {
+            count += registry.contains(conn) ? 1U : 0U;
+        }
+        benchmark::do_not_optimize(count);
+    });
+
+    benchmark::run(emitName, targetCount, [&registry, &sum](std::size_t /*unused*/) {
+        registry(1);
+        benchmark::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main() {
+    benchmarkRegistry<SharedRegistry>("churn std::weak_ptr<std::function>",
+        "validate std::weak_ptr<std::function>", "emit std::weak_ptr<std::function>");
+    benchmarkRegistry<RomeRegistry>("churn rome::delegate_registry",
+        "validate rome::delegate_registry", "emit rome::delegate_registry");
+}
@@ -0,0 +1,103 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares dispatching frames by their ID to one of 200 handlers with a
+// `std::unordered_map<std::uint32_t, std::function<void(const Frame&)>>` and with a
+// `rome::dispatch_table`, which looks up the handler with a perfect hash function computed at
+// compile time. The IDs are sparse and the frames arrive in a pseudo-random order.
+
+#include <rome/dispatch_table.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t handlerCount = 200;
+
+struct Frame {
+    std::uint32_t id;
+    std::uint32_t payload;
+};
+
+// Returns the sparse, pseudo-random 24 bit ID of the handler at `index`.
+constexpr auto frameId(const std::size_t index) noexcept -> std::uint32_t {
+    std::uint64_t value = index + 0x9E3779B97F4A7C15U;
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9U;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBU;
+    return static_cast<std::uint32_t>((value ^ (value >> 31U)) & 0xFFFFFFU);
+}
+
+template<typename Indices>
+struct table_of;
+
+template<std::size_t... indices>
+struct table_of<std::index_sequence<indices...>> {
+    using type = rome::dispatch_table<std::uint32_t, void(const Frame&), frameId(indices)...>;
+};
+
+using Table = table_of<std::make_index_sequence<handlerCount>>::type;
+
+struct Accumulate {
+    std::uint32_t* sum;
+    std::uint32_t factor;
+    void operator()(const Frame& frame) const {
+        *sum += frame.payload * factor;
+    }
+};
+
+template<std::size_t... indices>
+void assign(Table& table, std::uint32_t* sum, std::index_sequence<indices...> /*unused*/) {
+    (void)std::initializer_list<int>{
+        (table.get<frameId(indices)>() = Accumulate{sum, std::uint32_t{indices}}, 0)...};
+}
+
+auto createFrames(const std::size_t count) -> std::vector<Frame> {
+    std::minstd_rand random{42};
+    std::vector<Frame> frames;
+    frames.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        frames.push_back({frameId(random() % handlerCount), static_cast<std::uint32_t>(i)});
+    }
+    return frames;
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t count = 4096;
+    const auto frames           = createFrames(count);
+    std::uint32_t sum           = 0U;
+
+    std::unordered_map<std::uint32_t, std::function<void(const Frame&)>> map;
+    for (std::size_t i = 0; i < handlerCount; ++i) {
+        map.emplace(frameId(i), Accumulate{&sum, static_cast<std::uint32_t>(i)});
+    }
+    benchmark::run("std::unordered_map<std::function>", count, [&](std::size_t /*unused*/) {
+        for (const auto& frame : frames) {
+            map.find(frame.id)->second(frame);
+        }
+        benchmark::do_not_optimize(sum);
+    });
+
+    Table table;
+    assign(table, &sum, std::make_index_sequence<handlerCount>{});
+    benchmark::run("rome::dispatch_table", count, [&](std::size_t /*unused*/) {
+        for (const auto& frame : frames) {
+            table(frame.id, frame);
+        }
+        benchmark::do_not_optimize(sum);
+    });
+}
@@ -0,0 +1,106 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares publishing messages of three topics to four subscribers each with a bus looking up the
+// subscribers in a `std::unordered_map<std::type_index, std::vector<std::function<...>>>` and with
+// a `rome::event_bus`, which resolves the topic at compile time. Measures the time per publish.
+
+#include <rome/event_bus.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Position {
+    int x;
+    int y;
+};
+
+struct Speed {
+    int value;
+};
+
+struct Heading {
+    int degrees;
+};
+
+// A bus as it is often written, the subscribers get a type erased pointer to the message.
+class MapBus {
+    std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> topics_;
+
+  public:
+    // The handlers stay subscribed for the lifetime of the bus.
+    struct Subscription {
+        void release() noexcept {
+        }
+    };
+
+    template<typename Topic, typename F>
+    auto subscribe(F handler) -> Subscription {
+        topics_[typeid(Topic)].emplace_back([handler](const void* message) {
+            handler(*static_cast<const Topic*>(message));
+        });
+        return {};
+    }
+
+    template<typename Topic>
+    void publish(const Topic& message) const {
+        const auto it = topics_.find(typeid(Topic));
+        if (it != topics_.end()) {
+            for (const auto& handler : it->second) {
+                handler(&message);
+            }
+        }
+    }
+};
+
+using RomeBus = rome::event_bus<8, Position, Speed, Heading>;
+
+template<typename Bus>
+void subscribeAll(Bus& bus, int& sum) {
+    for (int i = 0; i < 4; ++i) {
+        bus.template subscribe<Position>([&sum](const Position& msg) { sum += msg.x + msg.y; })
+            .release();
+        bus.template subscribe<Speed>([&sum](const Speed& msg) { sum += msg.value; }).release();
+        bus.template subscribe<Heading>([&sum](const Heading& msg) { sum -= msg.degrees; })
+            .release();
+    }
+}
+
+template<typename Bus>
+void benchmarkPublish(const char* name, const Bus& bus, const int& sum) {
+    constexpr std::size_t count = 3000;
+    benchmark::run(name, count, [&bus, &sum](std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; i += 3) {
+            const auto value = static_cast<int>(i);
+            bus.publish(Position{value, 1});
+            bus.publish(Speed{value});
+            bus.publish(Heading{value});
+        }
+        benchmark::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main() {
+    int sum = 0;
+
+    MapBus mapBus;
+    subscribeAll(mapBus, sum);
+    benchmarkPublish("std::unordered_map<std::function>", mapBus, sum);
+
+    RomeBus romeBus;
+    subscribeAll(romeBus, sum);
+    benchmarkPublish("rome::event_bus", romeBus, sum);
+}
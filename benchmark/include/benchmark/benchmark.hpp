@@ -0,0 +1,53 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Provides a minimal harness to measure the time per iteration of a function.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace benchmark {
+
+// Prevents that the compiler optimizes away the computation of `value`.
+template<typename T>
+void do_not_optimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    const volatile auto* pValue = &value;
+    (void)pValue;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Calls `body(iterations)` repeatedly and prints the fastest measured time per iteration.
+// `body` shall run the benchmarked code `iterations` times.
+template<typename Body>
+void run(const char* name, const std::size_t iterations, Body&& body) {
+    constexpr int repetitions = 10;
+    using clock               = std::chrono::steady_clock;
+
+    auto best = std::numeric_limits<double>::max();
+    body(iterations);  // warm up
+    for (int i = 0; i < repetitions; ++i) {
+        const auto start = clock::now();
+        body(iterations);
+        const auto stop = clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(10) << best / static_cast<double>(iterations)
+              << " ns/iteration\n";
+}
+
+}  // namespace benchmark
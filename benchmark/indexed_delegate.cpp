@@ -0,0 +1,134 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares an update loop over 10M entities, each with its own handler. The handlers are either
+// `rome::delegate`s or `rome::compact_delegate`s bound to their entity, or
+// `rome::indexed_delegate`s storing the index of their entity. Neither the entities nor the
+// handlers fit into the cache. With grouped handlers the indirect calls are predictable and the
+// loop is bound by the memory traffic, which mainly depends on the size of a handler. With random
+// handlers the mispredictions dominate.
+
+#include <rome/compact_delegate.hpp>
+#include <rome/delegate.hpp>
+#include <rome/indexed_delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Entity {
+    float position = 0.0F;
+    float speed    = 1.0F;
+
+    void move(float dt) {
+        position += speed * dt;
+    }
+    void bounce(float dt) {
+        speed    = -speed;
+        position += speed * dt;
+    }
+};
+
+using Delegate        = rome::delegate<void(float)>;
+using CompactDelegate = rome::compact_delegate<void(float)>;
+using IndexedDelegate = rome::indexed_delegate<void(float), Entity>;
+
+constexpr std::size_t entityCount = 10000000;
+
+auto createEntities() -> std::vector<Entity> {
+    return std::vector<Entity>(entityCount);
+}
+
+// Returns whether entity `i` moves or bounces, either in random order or grouped, the latter
+// keeps the indirect calls predictable.
+auto createKinds(const bool random) -> std::vector<bool> {
+    std::minstd_rand generator{42};
+    std::vector<bool> kinds(entityCount);
+    for (std::size_t i = 0; i < entityCount; ++i) {
+        kinds[i] = random ? generator() % 2U == 0U : i < entityCount / 2;
+    }
+    return kinds;
+}
+
+template<typename Delegate>
+auto createBoundHandlers(std::vector<Entity>& entities, const std::vector<bool>& kinds)
+    -> std::vector<Delegate> {
+    std::vector<Delegate> handlers;
+    handlers.reserve(entityCount);
+    for (std::size_t i = 0; i < entityCount; ++i) {
+        handlers.push_back(kinds[i] ? Delegate::template create<Entity, &Entity::move>(entities[i])
+                                    : Delegate::template create<Entity, &Entity::bounce>(
+                                        entities[i]));
+    }
+    return handlers;
+}
+
+auto createIndexedHandlers(const std::vector<bool>& kinds) -> std::vector<IndexedDelegate> {
+    std::vector<IndexedDelegate> handlers;
+    handlers.reserve(entityCount);
+    for (std::size_t i = 0; i < entityCount; ++i) {
+        const auto index = static_cast<std::uint32_t>(i);
+        handlers.push_back(kinds[i] ? IndexedDelegate::create<&Entity::move>(index)
+                                    : IndexedDelegate::create<&Entity::bounce>(index));
+    }
+    return handlers;
+}
+
+template<typename Handlers>
+void benchmarkBound(const char* name, std::vector<Entity>& entities, const Handlers& handlers) {
+    benchmark::run(name, entityCount, [&](std::size_t /*unused*/) {
+        for (const auto& handler : handlers) {
+            handler(0.01F);
+        }
+        benchmark::do_not_optimize(entities.front());
+    });
+}
+
+void benchmarkAll(const char* order, std::vector<Entity>& entities, const bool random) {
+    const auto kinds = createKinds(random);
+    std::string name;
+    {
+        const auto handlers = createBoundHandlers<Delegate>(entities, kinds);
+        name                = std::string{"rome::delegate, "} + order;
+        benchmarkBound(name.c_str(), entities, handlers);
+    }
+    {
+        const auto handlers = createBoundHandlers<CompactDelegate>(entities, kinds);
+        name                = std::string{"rome::compact_delegate, "} + order;
+        benchmarkBound(name.c_str(), entities, handlers);
+    }
+    {
+        const auto handlers = createIndexedHandlers(kinds);
+        auto* arena         = entities.data();
+        name                = std::string{"rome::indexed_delegate, "} + order;
+        benchmark::run(name.c_str(), entityCount, [&](std::size_t /*unused*/) {
+            for (const auto& handler : handlers) {
+                handler(arena, 0.01F);
+            }
+            benchmark::do_not_optimize(entities.front());
+        });
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "bytes per handler: rome::delegate " << sizeof(Delegate)
+              << ", rome::compact_delegate " << sizeof(CompactDelegate)
+              << ", rome::indexed_delegate " << sizeof(IndexedDelegate) << '\n';
+
+    auto entities = createEntities();
+    benchmarkAll("10M grouped", entities, false);
+    benchmarkAll("10M random", entities, true);
+}
@@ -0,0 +1,101 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares a `rome::intrusive_event`, whose slots are embedded into the subscribers, with a
+// `std::list<std::function<void(int)>>`, which allocates a node per connection.
+//   - churn: connecting and disconnecting one subscriber, time per connect and disconnect.
+//   - emit: calling 10k subscribers, time per subscriber.
+
+#include <rome/intrusive_event.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+
+namespace {
+
+constexpr std::size_t subscriberCount = 10000;
+
+struct Subscriber {
+    int* sum;
+    rome::intrusive_slot<void(int)> slot{[this](int value) { *sum += value; }};
+
+    explicit Subscriber(int* output) : sum{output} {
+    }
+};
+
+void benchmarkChurn() {
+    int sum = 0;
+    {
+        std::list<std::function<void(int)>> event;
+        Subscriber subscriber{&sum};
+        benchmark::run("churn std::list<std::function>", subscriberCount,
+            [&event, &subscriber](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    const auto it = event.emplace(
+                        event.end(), [&subscriber](int value) { *subscriber.sum += value; });
+                    event.erase(it);
+                }
+                benchmark::do_not_optimize(event);
+            });
+    }
+    {
+        rome::intrusive_event<void(int)> event;
+        Subscriber subscriber{&sum};
+        benchmark::run("churn rome::intrusive_event", subscriberCount,
+            [&event, &subscriber](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    event.connect(subscriber.slot);
+                    subscriber.slot.disconnect();
+                }
+                benchmark::do_not_optimize(event);
+            });
+    }
+}
+
+void benchmarkEmit() {
+    int sum = 0;
+    // not movable, as the slots are linked
+    std::deque<Subscriber> subscribers;
+    for (std::size_t i = 0; i < subscriberCount; ++i) {
+        subscribers.emplace_back(&sum);
+    }
+    {
+        std::list<std::function<void(int)>> event;
+        for (auto& subscriber : subscribers) {
+            event.emplace_back([&subscriber](int value) { *subscriber.sum += value; });
+        }
+        benchmark::run("emit std::list<std::function>", subscriberCount,
+            [&event, &sum](std::size_t /*unused*/) {
+                for (const auto& function : event) {
+                    function(1);
+                }
+                benchmark::do_not_optimize(sum);
+            });
+    }
+    {
+        rome::intrusive_event<void(int)> event;
+        for (auto& subscriber : subscribers) {
+            event.connect(subscriber.slot);
+        }
+        benchmark::run("emit rome::intrusive_event", subscriberCount,
+            [&event, &sum](std::size_t /*unused*/) {
+                event(1);
+                benchmark::do_not_optimize(sum);
+            });
+    }
+}
+
+}  // namespace
+
+int main() {
+    benchmarkChurn();
+    benchmarkEmit();
+}
@@ -0,0 +1,58 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares calling a `rome::delegate` indirectly with `invoke_as<F>(args...)` at a monomorphic call
+// site, i.e., where all delegates are assigned a function object of the same type. The guarded
+// direct call of `invoke_as` can be inlined, the indirect call cannot.
+
+#include <rome/delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Adapter {
+    int* state;
+    auto operator()(int value) const -> int {
+        *state += value;
+        return *state & 0xFF;
+    }
+};
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t count = 4096;
+
+    std::minstd_rand random{42};
+    std::vector<int> states(count);
+    std::vector<rome::delegate<int(int)>> delegates;
+    delegates.reserve(count);
+    for (auto& state : states) {
+        state = static_cast<int>(random() % 100U);
+        delegates.emplace_back(Adapter{&state});
+    }
+
+    benchmark::run("rome::delegate::operator()", count, [&delegates](std::size_t /*unused*/) {
+        int value = 1;
+        for (const auto& dgt : delegates) {
+            value = dgt(value);
+        }
+        benchmark::do_not_optimize(value);
+    });
+    benchmark::run("rome::delegate::invoke_as", count, [&delegates](std::size_t /*unused*/) {
+        int value = 1;
+        for (const auto& dgt : delegates) {
+            value = dgt.invoke_as<Adapter>(value);
+        }
+        benchmark::do_not_optimize(value);
+    });
+}
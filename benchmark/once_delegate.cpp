@@ -0,0 +1,73 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares consuming a `rome::once_delegate`, which calls and destroys its target through one
+// indirect call, with calling a `rome::delegate` and dropping its target afterwards, two indirect
+// calls. The targets are a lambda small enough for the small buffer optimization and a lambda
+// allocated on the heap.
+//   - time per creation, call and destruction of a target.
+
+#include <rome/once_delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t callCount = 1000;
+
+struct Small {
+    int* sum;
+    void operator()(const int value) {
+        *sum += value;
+    }
+};
+
+struct Large {
+    int* sum;
+    std::array<int, 8> values = {1, 2, 3, 4, 5, 6, 7, 8};
+    void operator()(const int value) {
+        *sum += value + values[static_cast<std::size_t>(value) % values.size()];
+    }
+};
+
+void consume(rome::delegate<void(int)>& dgt, const int value) {
+    dgt(value);
+    dgt = nullptr;
+}
+
+void consume(rome::once_delegate<void(int)>& dgt, const int value) {
+    std::move(dgt)(value);
+}
+
+// Creates a delegate, then calls it and destroys its target.
+template<typename Delegate, typename Target>
+void run(const char* name) {
+    Delegate dgt;
+    int sum = 0;
+    benchmark::run(name, callCount, [&dgt, &sum](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            dgt = Delegate{Target{&sum}};
+            consume(dgt, static_cast<int>(i));
+        }
+    });
+    benchmark::do_not_optimize(sum);
+}
+
+}  // namespace
+
+int main() {
+    using Delegate     = rome::delegate<void(int)>;
+    using OnceDelegate = rome::once_delegate<void(int)>;
+    run<Delegate, Small>("rome::delegate small, call and drop");
+    run<OnceDelegate, Small>("rome::once_delegate small, consume");
+    run<Delegate, Large>("rome::delegate large, call and drop");
+    run<OnceDelegate, Large>("rome::once_delegate large, consume");
+}
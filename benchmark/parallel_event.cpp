@@ -0,0 +1,153 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures how calling 256 CPU-heavy event delegates with a `rome::parallel_event` scales with the
+// concurrency, from 1 to the number of cores, compared with calling them serially. The tasks run in
+// a fixed thread pool with one thread less than the number of cores, the calling thread is the
+// remaining one.
+//   - time per call of all event delegates.
+
+#include <rome/parallel_event.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t subscriberCount = 256;
+constexpr std::size_t callCount       = 10;
+
+using Event = rome::parallel_event<void(const std::string&)>;
+
+// Runs the tasks in a fixed number of worker threads.
+class ThreadPool {
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<Event::task_type> tasks_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+
+    void work() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            wakeup_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+  public:
+    explicit ThreadPool(const std::size_t threadCount) {
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this]() { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&)      = delete;
+
+    auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+    auto operator=(ThreadPool&&) -> ThreadPool&      = delete;
+
+    ~ThreadPool() {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wakeup_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void post(Event::task_type&& task) {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.push_back(std::move(task));
+        }
+        wakeup_.notify_one();
+    }
+};
+
+// A CPU-heavy subscriber, hashes the text many times.
+struct Subscriber {
+    std::uint64_t result = 0;
+
+    void on_event(const std::string& text) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (int round = 0; round < 200; ++round) {
+            for (const char c : text) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+            }
+        }
+        result = hash;
+    }
+};
+
+const std::string text = "a text too long for the small string optimization";
+
+}  // namespace
+
+int main() {
+    const auto cores = (std::max)(std::thread::hardware_concurrency(), 1U);
+    std::vector<Subscriber> subscribers(subscriberCount);
+
+    {
+        std::vector<Event::delegate_type> delegates;
+        for (auto& subscriber : subscribers) {
+            delegates.push_back(
+                Event::delegate_type::create<Subscriber, &Subscriber::on_event>(subscriber));
+        }
+        benchmark::run("serial", callCount, [&delegates](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                for (const auto& dgt : delegates) {
+                    dgt(text);
+                }
+            }
+        });
+    }
+
+    ThreadPool pool{cores - 1};
+    std::vector<std::size_t> concurrencies;
+    for (std::size_t concurrency = 1; concurrency < cores; concurrency *= 2) {
+        concurrencies.push_back(concurrency);
+    }
+    concurrencies.push_back(cores);
+    for (const auto concurrency : concurrencies) {
+        Event event{Event::executor_type::create<ThreadPool, &ThreadPool::post>(pool), concurrency};
+        for (auto& subscriber : subscribers) {
+            (void)event.push_back(
+                Event::delegate_type::create<Subscriber, &Subscriber::on_event>(subscriber));
+        }
+        benchmark::run(("rome::parallel_event concurrency " + std::to_string(concurrency)).c_str(),
+            callCount, [&event](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    event(text);
+                }
+            });
+    }
+
+    for (const auto& subscriber : subscribers) {
+        benchmark::do_not_optimize(subscriber.result);
+    }
+}
@@ -0,0 +1,129 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares a `rome::priority_event`, which inserts each event delegate at its position, with an
+// event that appends each event delegate to a `std::vector` and sorts it again. Both call the same
+// `rome::event_delegate`s in the same flat order.
+//   - connect: connecting 1k targets with random priorities, time per connect.
+//   - reprioritize: changing the priority of a random target, time per change.
+//   - emit: calling 1k targets, time per target.
+
+#include <rome/priority_event.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t targetCount = 1000;
+constexpr int priorityCount       = 16;
+
+// A pseudo random sequence, identical for both events.
+class Random {
+    std::uint32_t state_ = 12345U;
+
+  public:
+    auto next(const std::uint32_t bound) noexcept -> std::uint32_t {
+        state_ = state_ * 1664525U + 1013904223U;
+        return (state_ >> 8U) % bound;
+    }
+};
+
+// An event as it is often written, sorting all event delegates after each change.
+class SortedVectorEvent {
+    struct entry {
+        int priority;
+        std::uint64_t id;
+        rome::event_delegate<void(int)> delegate;
+    };
+
+    std::vector<entry> entries_;
+    std::uint64_t lastId_ = 0U;
+
+    void sort() {
+        std::stable_sort(entries_.begin(), entries_.end(),
+            [](const entry& lhs, const entry& rhs) { return lhs.priority > rhs.priority; });
+    }
+
+  public:
+    using connection = std::uint64_t;
+
+    template<typename F>
+    auto connect(F target, const int priority) -> connection {
+        entries_.push_back(entry{priority, ++lastId_, std::move(target)});
+        sort();
+        return lastId_;
+    }
+
+    auto set_priority(const connection& conn, const int priority) -> bool {
+        const auto it = std::find_if(entries_.begin(), entries_.end(),
+            [conn](const entry& e) { return e.id == conn; });
+        if (it == entries_.end()) {
+            return false;
+        }
+        it->priority = priority;
+        sort();
+        return true;
+    }
+
+    void operator()(int value) const {
+        for (const auto& e : entries_) {
+            e.delegate(value);
+        }
+    }
+};
+
+using RomeEvent = rome::priority_event<void(int)>;
+
+template<typename Event>
+void benchmarkEvent(const char* connectName, const char* reprioritizeName, const char* emitName) {
+    int sum = 0;
+
+    benchmark::run(connectName, targetCount, [&sum](std::size_t iterations) {
+        Random random;
+        Event event;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            (void)event.connect([&sum](int value) { sum += value; },
+                static_cast<int>(random.next(priorityCount)));
+        }
+        benchmark::do_not_optimize(event);
+    });
+
+    Random random;
+    Event event;
+    std::vector<typename Event::connection> connections;
+    for (std::size_t i = 0; i < targetCount; ++i) {
+        connections.push_back(event.connect([&sum](int value) { sum += value; },
+            static_cast<int>(random.next(priorityCount))));
+    }
+
+    benchmark::run(reprioritizeName, targetCount,
+        [&event, &connections, &random](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                auto& conn = connections[random.next(targetCount)];
+                (void)event.set_priority(conn, static_cast<int>(random.next(priorityCount)));
+            }
+        });
+
+    benchmark::run(emitName, targetCount, [&event, &sum](std::size_t /*unused*/) {
+        event(1);
+        benchmark::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main() {
+    benchmarkEvent<SortedVectorEvent>("connect sorted std::vector",
+        "reprioritize sorted std::vector", "emit sorted std::vector");
+    benchmarkEvent<RomeEvent>("connect rome::priority_event", "reprioritize rome::priority_event",
+        "emit rome::priority_event");
+}
@@ -0,0 +1,97 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares calling a `rome::delegate`, which calls its target indirectly through a function
+// pointer, with calling a `rome::variant_delegate`, which dispatches on the index of the stored
+// target type. Each delegate is assigned one of four target types in a pseudo-random order.
+// Build with retpolines to see the additional cost of indirect calls in hardened builds.
+
+#include <rome/delegate.hpp>
+#include <rome/variant_delegate.hpp>
+
+#include <benchmark/benchmark.hpp>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Add {
+    int summand;
+    auto operator()(int value) const -> int {
+        return value + summand;
+    }
+};
+
+struct Multiply {
+    int factor;
+    auto operator()(int value) const -> int {
+        return value * factor;
+    }
+};
+
+struct Xor {
+    int mask;
+    auto operator()(int value) const -> int {
+        return value ^ mask;
+    }
+};
+
+struct Shift {
+    int bits;
+    auto operator()(int value) const -> int {
+        return value >> bits;
+    }
+};
+
+template<typename Delegate>
+auto createDelegates(const std::size_t count) -> std::vector<Delegate> {
+    std::minstd_rand random{42};
+    std::vector<Delegate> delegates;
+    delegates.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto value = static_cast<int>(random() % 7U) + 1;
+        switch (random() % 4U) {
+            case 0:
+                delegates.emplace_back(Add{value});
+                break;
+            case 1:
+                delegates.emplace_back(Multiply{value});
+                break;
+            case 2:
+                delegates.emplace_back(Xor{value});
+                break;
+            default:
+                delegates.emplace_back(Shift{value});
+                break;
+        }
+    }
+    return delegates;
+}
+
+template<typename Delegate>
+void benchmarkCalls(const char* name, const std::size_t count) {
+    const auto delegates = createDelegates<Delegate>(count);
+    benchmark::run(name, count, [&delegates](std::size_t /*unused*/) {
+        int value = 1;
+        for (const auto& dgt : delegates) {
+            value = dgt(value);
+        }
+        benchmark::do_not_optimize(value);
+    });
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t count = 4096;
+
+    benchmarkCalls<rome::delegate<int(int)>>("rome::delegate", count);
+    benchmarkCalls<rome::variant_delegate<int(int), Add, Multiply, Xor, Shift>>(
+        "rome::variant_delegate", count);
+}
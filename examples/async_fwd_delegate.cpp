@@ -0,0 +1,40 @@
+#include <iostream>
+#include <rome/async_fwd_delegate.hpp>
+#include <string>
+#include <vector>
+
+using Logger = rome::async_fwd_delegate<void(int, const std::string&)>;
+
+// A simple executor running its tasks when requested, e.g. once per cycle of the main loop.
+class Executor {
+    std::vector<Logger::task_type> tasks_;
+
+  public:
+    void post(Logger::task_type&& task) {
+        tasks_.push_back(std::move(task));
+    }
+
+    void run_all() {
+        for (auto& task : tasks_) {
+            task();
+        }
+        tasks_.clear();
+    }
+};
+
+int main() {
+    Executor executor;
+    Logger log{16, Logger::executor_type::create<Executor, &Executor::post>(executor),
+        [](int level, const std::string& text) {
+            std::cout << "log " << level << ": " << text << '\n';
+        }};
+
+    {
+        std::string text = "started";
+        log(1, text);  // copies the text, returns immediately
+    }
+    log(2, "running");
+    std::cout << "pending " << log.pending() << '\n';
+    executor.run_all();
+    std::cout << "pending " << log.pending() << '\n';
+}
@@ -0,0 +1,60 @@
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <rome/broadcast_ring.hpp>
+#include <thread>
+#include <vector>
+
+struct Tick {
+    int price    = 0;
+    int quantity = 0;
+};
+
+struct Volume {
+    int total = 0;
+    void on_tick(const Tick& tick) {
+        total += tick.quantity;
+    }
+};
+
+struct HighestPrice {
+    int highest = 0;
+    void on_tick(const Tick& tick) {
+        highest = tick.price > highest ? tick.price : highest;
+    }
+};
+
+int main() {
+    using Ring = rome::broadcast_ring<Tick>;
+    Ring ring{64};
+
+    Volume volume;
+    HighestPrice highestPrice;
+    (void)ring.connect(Ring::delegate_type::create<Volume, &Volume::on_tick>(volume));
+    (void)ring.connect(
+        Ring::delegate_type::create<HighestPrice, &HighestPrice::on_tick>(highestPrice));
+
+    // each consumer reads the ticks in its own thread
+    std::atomic<bool> done{false};
+    std::vector<std::thread> consumers;
+    for (std::size_t i = 0; i < ring.consumer_count(); ++i) {
+        consumers.emplace_back([&ring, &done, i]() {
+            while (!done.load() || ring.pending(i) != 0) {
+                if (ring.poll(i) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= 1000; ++i) {
+        ring.publish(Tick{100 + i % 7, i});
+    }
+    done.store(true);
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    std::cout << "volume " << volume.total << '\n';
+    std::cout << "highest price " << highestPrice.highest << '\n';
+}
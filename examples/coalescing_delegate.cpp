@@ -0,0 +1,16 @@
+#include <iostream>
+#include <rome/coalescing_delegate.hpp>
+
+int main() {
+    rome::coalescing_delegate<void(float)> sensor{
+        [](float value) { std::cout << "control cycle with " << value << '\n'; }};
+
+    for (int cycle = 0; cycle < 3; ++cycle) {
+        // the sensor fires several times per control cycle, only the newest value is kept
+        for (int i = 1; i <= 10; ++i) {
+            sensor(static_cast<float>(cycle) + 0.1F * static_cast<float>(i));
+        }
+        sensor.flush();
+    }
+    std::cout << std::boolalpha << sensor.flush() << '\n';  // nothing new
+}
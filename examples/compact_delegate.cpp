@@ -0,0 +1,31 @@
+#include <iostream>
+#include <rome/compact_delegate.hpp>
+#include <vector>
+
+struct Print {
+    void operator()(int i) const {
+        std::cout << "print " << i << '\n';
+    }
+};
+
+struct Accumulate {
+    int* sum;
+    void operator()(int i) const {
+        *sum += i;
+        std::cout << "sum " << *sum << '\n';
+    }
+};
+
+int main() {
+    int sum = 0;
+    std::vector<rome::compact_delegate<void(int), rome::target_is_optional>> handlers;
+    handlers.emplace_back(Print{});
+    handlers.emplace_back(Accumulate{&sum});
+    handlers.emplace_back(nullptr);
+    handlers.emplace_back([](int i) { std::cout << "lambda " << i << '\n'; });
+    for (int i = 1; i <= 2; ++i) {
+        for (const auto& handler : handlers) {
+            handler(i);  // the empty handler does nothing
+        }
+    }
+}
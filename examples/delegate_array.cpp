@@ -0,0 +1,33 @@
+#include <iostream>
+#include <rome/delegate_array.hpp>
+
+struct Print {
+    void operator()(int i) const {
+        std::cout << "print " << i << '\n';
+    }
+};
+
+struct Square {
+    void operator()(int i) const {
+        std::cout << "square " << i * i << '\n';
+    }
+};
+
+void negate(int i) {
+    std::cout << "negate " << -i << '\n';
+}
+
+int main() {
+    rome::delegate_array<void(int)> handlers;
+    handlers.push_back(Print{});
+    handlers.push_back(Square{});
+    handlers.push_back<&negate>();
+    handlers.push_back(Print{});
+    handlers.invoke_all(3);
+
+    handlers.invoke(1, 4);
+
+    // groups both Print targets, the order of the groups is unspecified
+    handlers.sort_by_target();
+    std::cout << "size " << handlers.size() << '\n';
+}
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <rome/delegate_bundle.hpp>
+
+struct Motor {
+    void start() {
+        std::cout << "motor started\n";
+    }
+    void stop() {
+        std::cout << "motor stopped\n";
+    }
+};
+
+struct Lamp {
+    void on() {
+        std::cout << "lamp on\n";
+    }
+    void off() {
+        std::cout << "lamp off\n";
+    }
+};
+
+// Any object that can be started and stopped, without a common base class.
+using Switchable = rome::delegate_bundle<void(), void()>;
+
+void cycle(const Switchable& device) {
+    device.get<0>()();
+    device.get<1>()();
+}
+
+int main() {
+    Motor motor;
+    Lamp lamp;
+    cycle(Switchable::of<Motor>::methods<&Motor::start, &Motor::stop>::create(motor));
+    cycle(Switchable::of<Lamp>::methods<&Lamp::on, &Lamp::off>::create(lamp));
+}
@@ -0,0 +1,21 @@
+#include <iostream>
+#include <rome/delegate_registry.hpp>
+
+using Registry = rome::delegate_registry<void(int)>;
+
+int main() {
+    Registry onTick;
+    const auto logger = onTick.connect([](int tick) { std::cout << "log " << tick << '\n'; });
+    {
+        const auto scoped =
+            onTick.connect_scoped([](int tick) { std::cout << "scoped " << tick << '\n'; });
+        onTick(1);
+    }  // disconnected by `scoped`
+    onTick(2);
+
+    onTick.disconnect(logger);
+    const auto other = onTick.connect([](int tick) { std::cout << "other " << tick << '\n'; });
+    // the stale connection is detected, although its slot is reused by `other`
+    std::cout << std::boolalpha << onTick.contains(logger) << ' ' << onTick.contains(other) << '\n';
+    onTick(3);
+}
@@ -0,0 +1,36 @@
+#include <cstdint>
+#include <iostream>
+#include <rome/dispatch_table.hpp>
+
+struct Frame {
+    std::uint16_t id;
+    int value;
+};
+
+enum : std::uint16_t { speedId = 0x101, temperatureId = 0x2A0, statusId = 0x7FF };
+
+void printSpeed(const Frame& frame) {
+    std::cout << "speed " << frame.value << '\n';
+}
+
+using Decoder =
+    rome::dispatch_table<std::uint16_t, void(const Frame&), speedId, temperatureId, statusId>;
+
+int main() {
+    Decoder decoder;
+    decoder.get<speedId>()       = Decoder::delegate_type::create<&printSpeed>();
+    decoder.get<temperatureId>() = [](const Frame& frame) {
+        std::cout << "temperature " << frame.value << '\n';
+    };
+    decoder.get<statusId>() = [](const Frame& frame) {
+        std::cout << "status " << frame.value << '\n';
+    };
+    decoder.fallback() = [](const Frame& frame) {
+        std::cout << "unknown frame " << std::hex << frame.id << std::dec << '\n';
+    };
+
+    const Frame frames[] = {{0x2A0, 21}, {0x101, 80}, {0x555, 0}, {0x7FF, 1}};
+    for (const auto& frame : frames) {
+        decoder(frame.id, frame);
+    }
+}
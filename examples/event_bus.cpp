@@ -0,0 +1,35 @@
+#include <iostream>
+#include <rome/event_bus.hpp>
+#include <string>
+
+struct UserLoggedIn {
+    std::string name;
+};
+
+struct UserLoggedOut {
+    std::string name;
+};
+
+// Up to 8 subscribers per topic.
+using Bus = rome::event_bus<8, UserLoggedIn, UserLoggedOut>;
+
+int main() {
+    Bus bus;
+    int online = 0;
+    auto counter = bus.subscribe<UserLoggedIn>([&online](const UserLoggedIn&) { ++online; });
+    auto greeter = bus.subscribe<UserLoggedIn>(
+        [](const UserLoggedIn& msg) { std::cout << "welcome " << msg.name << '\n'; });
+    auto farewell = bus.subscribe<UserLoggedOut>([&online](const UserLoggedOut& msg) {
+        --online;
+        std::cout << "goodbye " << msg.name << '\n';
+    });
+
+    bus.publish(UserLoggedIn{"alice"});
+    bus.publish(UserLoggedIn{"bob"});
+    std::cout << online << " online\n";
+
+    bus.unsubscribe(greeter);
+    bus.publish(UserLoggedIn{"carol"});  // only counted
+    bus.publish(UserLoggedOut{"bob"});
+    std::cout << online << " online\n";
+}
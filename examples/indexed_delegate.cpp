@@ -0,0 +1,33 @@
+#include <iostream>
+#include <rome/indexed_delegate.hpp>
+#include <vector>
+
+struct Entity {
+    int position;
+
+    void step(int distance) {
+        position += distance;
+        std::cout << "step to " << position << '\n';
+    }
+    void jump(int distance) {
+        position += 2 * distance;
+        std::cout << "jump to " << position << '\n';
+    }
+};
+
+int main() {
+    using Handler = rome::indexed_delegate<void(int), Entity>;
+
+    std::vector<Entity> entities = {{0}, {10}, {20}};
+    std::vector<Handler> handlers = {
+        Handler::create<&Entity::step>(0),
+        Handler::create<&Entity::jump>(1),
+        Handler::create<&Entity::step>(2),
+    };
+    entities.push_back({30});  // may reallocate, but the handlers only store indices
+    handlers.push_back(Handler::create<&Entity::jump>(3));
+
+    for (const auto& handler : handlers) {
+        handler(entities.data(), 1);
+    }
+}
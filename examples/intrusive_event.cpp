@@ -0,0 +1,31 @@
+#include <iostream>
+#include <rome/intrusive_event.hpp>
+#include <string>
+#include <utility>
+
+using TemperatureChanged = rome::intrusive_event<void(int)>;
+
+// The slot is part of the display, connecting it does not allocate any memory.
+class Display {
+    std::string name_;
+    rome::intrusive_slot<void(int)> slot_{[this](int celsius) { show(celsius); }};
+
+    void show(int celsius) const {
+        std::cout << name_ << ": " << celsius << " C\n";
+    }
+
+  public:
+    Display(std::string name, TemperatureChanged& event) : name_{std::move(name)} {
+        event.connect(slot_);
+    }
+};
+
+int main() {
+    TemperatureChanged temperatureChanged;
+    Display panel{"panel", temperatureChanged};
+    {
+        Display remote{"remote", temperatureChanged};
+        temperatureChanged(21);
+    }  // `remote` is disconnected by its destruction
+    temperatureChanged(22);
+}
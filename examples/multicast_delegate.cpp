@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <iostream>
+#include <rome/multicast_delegate.hpp>
+#include <string>
+
+struct Request {
+    std::string user;
+    int size;
+};
+
+struct Max {
+    auto operator()(int lhs, int rhs) const -> int {
+        return std::max(lhs, rhs);
+    }
+};
+
+int main() {
+    rome::multicast_delegate<bool(const Request&), rome::combiners::all_of> validate;
+    validate.push_back([](const Request& r) {
+        std::cout << "check user\n";
+        return !r.user.empty();
+    });
+    validate.push_back([](const Request& r) {
+        std::cout << "check size\n";
+        return r.size <= 100;
+    });
+
+    using MaxCost = rome::combiners::fold<int, Max>;
+    rome::multicast_delegate<int(const Request&), MaxCost> estimateCost{MaxCost{0}};
+    estimateCost.push_back([](const Request& r) { return r.size; });
+    estimateCost.push_back([](const Request& r) { return 10 * static_cast<int>(r.user.size()); });
+
+    std::cout << std::boolalpha;
+    std::cout << validate(Request{"", 10}) << '\n';  // stops after the first check
+    std::cout << validate(Request{"bob", 10}) << '\n';
+    std::cout << "cost " << estimateCost(Request{"bob", 10}) << '\n';
+
+    rome::multicast_delegate<bool(const Request&), rome::combiners::all_of> noChecks;
+    try {
+        (void)noChecks(Request{"bob", 10});
+    } catch (const rome::bad_delegate_call& e) {
+        std::cout << e.what() << '\n';
+    }
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <rome/once_delegate.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Completion = rome::once_delegate<void(std::vector<char>&&)>;
+
+// Reads asynchronously, completes each request once with the filled buffer.
+class Reader {
+    std::vector<std::pair<std::vector<char>, Completion>> requests_;
+
+  public:
+    void read(std::vector<char>&& buffer, Completion&& onDone) {
+        requests_.emplace_back(std::move(buffer), std::move(onDone));
+    }
+
+    void poll(const std::string& data) {
+        for (auto& request : requests_) {
+            request.first.assign(data.begin(), data.end());
+            std::move(request.second)(std::move(request.first));  // consumes the completion
+            std::cout << "completion empty: " << std::boolalpha << (request.second == nullptr)
+                      << '\n';
+        }
+        requests_.clear();
+    }
+};
+
+int main() {
+    Reader reader;
+    std::vector<char> buffer;
+    buffer.reserve(64);
+    const auto* const memory = buffer.data();
+
+    // the move-only completion owns the caller's state until it is consumed
+    std::vector<char> received;
+    reader.read(std::move(buffer),
+        [&received, prefix = std::string{"received: "}](std::vector<char>&& filled) {
+            std::cout << prefix << std::string(filled.begin(), filled.end()) << '\n';
+            received = std::move(filled);
+        });
+    reader.poll("hello");
+    std::cout << "same buffer: " << (received.data() == memory) << '\n';
+}
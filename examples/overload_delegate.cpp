@@ -0,0 +1,39 @@
+#include <iostream>
+#include <rome/overload_delegate.hpp>
+#include <string>
+
+struct Connect {
+    std::string host;
+};
+
+struct Send {
+    std::string payload;
+};
+
+struct Disconnect {};
+
+// Handles all messages of the protocol with one function object.
+struct Session {
+    int sent = 0;
+    void operator()(const Connect& msg) {
+        std::cout << "connect to " << msg.host << '\n';
+    }
+    void operator()(const Send& msg) {
+        ++sent;
+        std::cout << "send '" << msg.payload << "'\n";
+    }
+    void operator()(const Disconnect& /*unused*/) {
+        std::cout << "disconnect after " << sent << " messages\n";
+    }
+};
+
+using MessageHandler =
+    rome::overload_delegate<void(const Connect&), void(const Send&), void(const Disconnect&)>;
+
+int main() {
+    MessageHandler handler = Session{};
+    handler(Connect{"localhost"});
+    handler(Send{"hello"});
+    handler(Send{"world"});
+    handler(Disconnect{});
+}
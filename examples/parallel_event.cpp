@@ -0,0 +1,119 @@
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <rome/parallel_event.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using Event = rome::parallel_event<void(const std::vector<int>&)>;
+
+// A minimal thread pool running the posted tasks.
+class ThreadPool {
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<Event::task_type> tasks_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+
+    void work() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            wakeup_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+  public:
+    explicit ThreadPool(const std::size_t threadCount) {
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wakeup_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void post(Event::task_type&& task) {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.push_back(std::move(task));
+        }
+        wakeup_.notify_one();
+    }
+};
+
+// Each statistic is computed by its own subscriber, possibly in another thread.
+struct Statistic {
+    std::string name;
+    long long result = 0;
+    long long (*compute)(const std::vector<int>&);
+
+    void on_samples(const std::vector<int>& samples) {
+        result = compute(samples);
+    }
+};
+
+long long sum(const std::vector<int>& samples) {
+    long long result = 0;
+    for (const auto sample : samples) {
+        result += sample;
+    }
+    return result;
+}
+
+long long sumOfSquares(const std::vector<int>& samples) {
+    long long result = 0;
+    for (const auto sample : samples) {
+        result += static_cast<long long>(sample) * sample;
+    }
+    return result;
+}
+
+long long maximum(const std::vector<int>& samples) {
+    long long result = 0;
+    for (const auto sample : samples) {
+        result = sample > result ? sample : result;
+    }
+    return result;
+}
+
+int main() {
+    ThreadPool pool{2};
+    Event event{Event::executor_type::create<ThreadPool, &ThreadPool::post>(pool), 3};
+
+    std::vector<Statistic> statistics = {
+        {"sum", 0, &sum}, {"sum of squares", 0, &sumOfSquares}, {"maximum", 0, &maximum}};
+    for (auto& statistic : statistics) {
+        event.push_back(
+            Event::delegate_type::create<Statistic, &Statistic::on_samples>(statistic));
+    }
+
+    std::vector<int> samples;
+    for (int i = 1; i <= 1000; ++i) {
+        samples.push_back(i % 100);
+    }
+    event(samples);  // returns when all subscribers have returned
+
+    for (const auto& statistic : statistics) {
+        std::cout << statistic.name << ": " << statistic.result << '\n';
+    }
+}
@@ -0,0 +1,13 @@
+#include <iostream>
+#include <rome/priority_event.hpp>
+
+int main() {
+    rome::priority_event<void(int)> onUpdate;
+    onUpdate.connect([](int id) { std::cout << "business logic " << id << '\n'; });
+    auto audit = onUpdate.connect([](int id) { std::cout << "audit " << id << '\n'; }, -10);
+    onUpdate.connect([](int id) { std::cout << "invalidate cache " << id << '\n'; }, 10);
+    onUpdate(1);
+
+    onUpdate.set_priority(audit, 20);  // audit first from now on
+    onUpdate(2);
+}
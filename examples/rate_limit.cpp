@@ -0,0 +1,42 @@
+#include <chrono>
+#include <iostream>
+#include <rome/rate_limit.hpp>
+
+// A clock advanced by hand, to make the output predictable. Use e.g. `std::chrono::steady_clock`.
+struct ManualClock {
+    using rep        = long long;
+    using period     = std::milli;
+    using duration   = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<ManualClock>;
+
+    static constexpr bool is_steady = true;
+    static time_point current;
+
+    static auto now() noexcept -> time_point {
+        return current;
+    }
+};
+
+ManualClock::time_point ManualClock::current{};
+
+int main() {
+    using namespace std::chrono_literals;
+
+    rome::throttled<rome::event_delegate<void(int)>, ManualClock> redraw{
+        100ms, [](int frame) { std::cout << "redraw " << frame << '\n'; }};
+    rome::debounced<rome::event_delegate<void(int)>, ManualClock> save{
+        500ms, [](int frame) { std::cout << "save " << frame << '\n'; }};
+
+    // an event storm, one event every 30 ms
+    for (int frame = 0; frame < 10; ++frame) {
+        redraw(frame);
+        save(frame);
+        save.poll();
+        ManualClock::current += 30ms;
+    }
+    // quiet
+    for (int i = 0; i < 20; ++i) {
+        save.poll();
+        ManualClock::current += 30ms;
+    }
+}
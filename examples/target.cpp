@@ -0,0 +1,19 @@
+#include <iostream>
+#include <rome/delegate.hpp>
+
+struct Counter {
+    int count = 0;
+    void operator()() {
+        ++count;
+    }
+};
+
+int main() {
+    rome::delegate<void()> d = Counter{};
+    d();
+    d.invoke_as<Counter>();  // calls `Counter::operator()` directly
+    std::cout << "count: " << d.target<Counter>()->count << '\n';
+    std::cout << std::boolalpha << "is counter: " << (d.target<Counter>() != nullptr) << '\n';
+    d = []() {};
+    std::cout << std::boolalpha << "is counter: " << (d.target<Counter>() != nullptr) << '\n';
+}
@@ -0,0 +1,28 @@
+#include <iostream>
+#include <rome/variant_delegate.hpp>
+
+struct Print {
+    void operator()(int i) const {
+        std::cout << "print " << i << '\n';
+    }
+};
+
+struct Accumulate {
+    int* sum;
+    void operator()(int i) const {
+        *sum += i;
+        std::cout << "sum " << *sum << '\n';
+    }
+};
+
+int main() {
+    int sum = 0;
+    rome::variant_delegate<void(int), rome::target_is_optional, Print, Accumulate> d;
+    d(1);  // does nothing
+    d = Print{};
+    d(2);
+    d = Accumulate{&sum};
+    d(3);
+    d(4);
+    // d = [](int) {};  // does not compile, not one of the target types
+}
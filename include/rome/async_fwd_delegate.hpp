@@ -0,0 +1,200 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::async_fwd_delegate<void(Args...), Behavior>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_ASYNC_FWD_DELEGATE_HPP
+#define ROME_ASYNC_FWD_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+// Calls its target later by a task posted to an executor. The caller returns immediately. The
+// arguments are copied or moved into a slot of a preallocated bounded queue, the task posted is a
+// `rome::command_delegate<void()>` calling back into the `rome::async_fwd_delegate`, thus posting
+// does not allocate. See the documentation in `doc/async_fwd_delegate.md`.
+template<typename Signature, typename Behavior = target_is_expected>
+class async_fwd_delegate {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with return type 'void'.");
+};
+
+template<typename... Args, typename Behavior>
+class async_fwd_delegate<void(Args...), Behavior> {
+    static_assert(detail::delegate::all_of<detail::delegate::is_storable<Args>...>,
+        "Invalid parameter 'Signature'. The decayed argument types must be default constructible "
+        "and assignable from the arguments.");
+
+  public:
+    using delegate_type = fwd_delegate<void(Args...), Behavior>;
+    // The task posted to the executor for each call.
+    using task_type = command_delegate<void()>;
+    // Posts a task to the executor. Shall not throw.
+    using executor_type = command_delegate<void(task_type&&)>;
+
+  private:
+    using arguments_type = std::tuple<std::decay_t<Args>...>;
+
+    // A slot of the bounded queue. The sequence tells whether the slot is free for the producer
+    // at position `sequence`, or filled for the consumer at position `sequence - 1`.
+    struct slot {
+        std::atomic<std::size_t> sequence{0U};
+        arguments_type arguments;
+        bool filled = false;  // false if storing the arguments threw
+    };
+
+    delegate_type delegate_;
+    executor_type executor_;
+    std::size_t mask_;
+    std::unique_ptr<slot[]> slots_;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::atomic<std::size_t> tail_{0U};
+    std::atomic<std::size_t> head_{0U};
+
+    // Claims the next free slot, or returns nullptr if the queue is full.
+    auto claim() noexcept -> slot* {
+        auto pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& entry     = slots_[pos & mask_];
+            const auto diff = static_cast<std::ptrdiff_t>(
+                entry.sequence.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return &entry;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<std::size_t... indices>
+    void call(arguments_type& arguments, std::index_sequence<indices...> /*unused*/) {
+        delegate_(static_cast<Args&&>(std::get<indices>(arguments))...);
+    }
+
+    // The task: calls the target with the oldest stored arguments. Each task consumes exactly one
+    // slot, which was filled before the task was posted, unless another producer filling an
+    // older slot has not finished yet.
+    void run_one() {
+        const auto pos = head_.fetch_add(1U, std::memory_order_relaxed);
+        auto& entry    = slots_[pos & mask_];
+        while (entry.sequence.load(std::memory_order_acquire) != pos + 1) {
+            std::this_thread::yield();
+        }
+
+        // drops the stored arguments and frees the slot, also if the target throws, so that the
+        // objects passed are not kept alive until the slot is reused
+        struct release {
+            slot& entry;
+            std::size_t next;
+            ~release() {
+                entry.arguments = arguments_type{};
+                entry.filled    = false;
+                entry.sequence.store(next, std::memory_order_release);
+            }
+        } const releaseSlot{entry, pos + mask_ + 1};
+        if (entry.filled) {
+            call(entry.arguments, std::index_sequence_for<Args...>{});
+        }
+    }
+
+    void post() noexcept {
+        executor_(task_type::template create<async_fwd_delegate, &async_fwd_delegate::run_one>(
+            *this));
+    }
+
+  public:
+    // Creates an asynchronous delegate with its `rome::fwd_delegate` created from `target`, e.g. a
+    // function object or a `rome::fwd_delegate`. `executor` posts the tasks. At most `capacity`
+    // calls, rounded up to a power of two, can be pending at a time.
+    template<typename T, typename E>
+    async_fwd_delegate(const std::size_t capacity, E&& executor, T&& target)
+        : delegate_{std::forward<T>(target)}
+        , executor_{std::forward<E>(executor)}
+        , mask_{detail::delegate::ceil_power_of_two(capacity) - 1}
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+        , slots_{std::make_unique<slot[]>(mask_ + 1)} {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Tasks refer to the `rome::async_fwd_delegate`, it can neither be copied nor moved.
+    async_fwd_delegate(const async_fwd_delegate&) = delete;
+    async_fwd_delegate(async_fwd_delegate&&)      = delete;
+    ~async_fwd_delegate()                         = default;
+
+    auto operator=(const async_fwd_delegate&) -> async_fwd_delegate& = delete;
+    auto operator=(async_fwd_delegate&&) -> async_fwd_delegate&      = delete;
+
+    // Returns the number of calls that can be pending at a time.
+    auto capacity() const noexcept -> std::size_t {
+        return mask_ + 1;
+    }
+
+    // Returns the number of calls whose tasks were not yet started. Is only a snapshot if calls
+    // are made or executed concurrently.
+    auto pending() const noexcept -> std::size_t {
+        // the head never passes the tail, read it first
+        const auto head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    // Stores the arguments and posts a task calling the target with them. Returns false if
+    // `capacity()` calls are pending, the call is dropped then. Does nothing if the target is
+    // empty and `Behavior` is `rome::target_is_optional`, throws `rome::bad_delegate_call` if it
+    // is `rome::target_is_expected`. Can be called from several threads at a time.
+    auto operator()(Args... args) -> bool {
+        if (!delegate_) {
+            if (std::is_same<Behavior, target_is_expected>::value) {
+                detail::delegate::throw_bad_delegate_call();
+            }
+            return true;
+        }
+        auto* const entry = claim();
+        if (entry == nullptr) {
+            return false;
+        }
+
+        // publishes the slot and posts its task, also if storing the arguments throws, as the
+        // tasks consume the slots in order
+        struct publish {
+            async_fwd_delegate& self;
+            slot& entry;
+            std::size_t pos;
+            ~publish() {
+                entry.sequence.store(pos + 1, std::memory_order_release);
+                self.post();
+            }
+        } const publishSlot{*this, *entry, entry->sequence.load(std::memory_order_relaxed)};
+        entry->filled    = false;
+        entry->arguments = std::forward_as_tuple(std::forward<Args>(args)...);
+        entry->filled    = true;
+        return true;
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_ASYNC_FWD_DELEGATE_HPP
@@ -0,0 +1,200 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::broadcast_ring<T>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_BROADCAST_RING_HPP
+#define ROME_BROADCAST_RING_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rome {
+
+namespace detail {
+    namespace broadcast_ring {
+        // Assumed size of a cache line. Sequences written by different threads are kept at least
+        // this far apart from other data, so that they do not share a cache line.
+        constexpr std::size_t cacheLineSize = 64U;
+
+        // A sequence with a full cache line of padding before and after it. Wherever the sequence
+        // is placed, no other data shares a cache line with it. Aligning it to a cache line
+        // instead would need the over-aligned `new` of C++17 for the heap allocated consumers.
+        struct padded_sequence {
+            char paddingBefore[cacheLineSize];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+            std::atomic<std::size_t> value{0U};
+            char paddingAfter[cacheLineSize];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        };
+    }  // namespace broadcast_ring
+}  // namespace detail
+
+
+// Passes each value published by one producer thread to all consumers, each calling its
+// `rome::event_delegate<void(const T&)>` in its own thread. The values are stored in a
+// preallocated ring, each consumer reads them behind its own sequence, without locks. See the
+// documentation in `doc/broadcast_ring.md`.
+template<typename T>
+class broadcast_ring {
+    static_assert(std::is_same<T, std::decay_t<T>>::value,
+        "Invalid parameter 'T'. The template parameter 'T' must be a value type, neither const, a "
+        "reference, an array nor a function.");
+    static_assert(std::is_default_constructible<T>::value,
+        "Invalid parameter 'T'. The type 'T' must be default constructible.");
+
+  public:
+    using value_type    = T;
+    using delegate_type = event_delegate<void(const T&)>;
+
+  private:
+    using padded_sequence = detail::broadcast_ring::padded_sequence;
+
+    // The sequence is the position of the next value the consumer reads. It is written by the
+    // consumer and read by the producer. The event delegate is followed by padding, as its target
+    // may be written by the consumer as well.
+    struct consumer {
+        padded_sequence sequence;
+        delegate_type delegate;
+        char padding[detail::broadcast_ring::cacheLineSize];  // NOLINT
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<T[]> values_;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::vector<std::unique_ptr<consumer>> consumers_;
+    padded_sequence published_;  // the position of the next value published
+    // Used by the producer only: the lowest consumer sequence seen last.
+    std::size_t minSequence_ = 0U;
+
+    // Returns whether the value at position `next` can be published without overwriting a value
+    // not yet read by all consumers. Reads the consumer sequences only if the lowest one read
+    // before does not suffice.
+    auto has_space(const std::size_t next) noexcept -> bool {
+        if (next - minSequence_ <= mask_) {
+            return true;
+        }
+        auto minSequence = next;
+        for (const auto& c : consumers_) {
+            minSequence =
+                (std::min)(minSequence, c->sequence.value.load(std::memory_order_acquire));
+        }
+        minSequence_ = minSequence;
+        return next - minSequence_ <= mask_;
+    }
+
+  public:
+    // Creates a ring for `capacity` values, rounded up to a power of two. The producer waits once
+    // `capacity()` values are not yet read by the slowest consumer.
+    explicit broadcast_ring(const std::size_t capacity)
+        : mask_{detail::delegate::ceil_power_of_two(capacity) - 1}
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+        , values_{std::make_unique<T[]>(mask_ + 1)} {
+    }
+
+    // Consumers refer to the `rome::broadcast_ring`, it can neither be copied nor moved.
+    broadcast_ring(const broadcast_ring&) = delete;
+    broadcast_ring(broadcast_ring&&)      = delete;
+    ~broadcast_ring()                     = default;
+
+    auto operator=(const broadcast_ring&) -> broadcast_ring& = delete;
+    auto operator=(broadcast_ring&&) -> broadcast_ring&      = delete;
+
+    auto capacity() const noexcept -> std::size_t {
+        return mask_ + 1;
+    }
+
+    auto consumer_count() const noexcept -> std::size_t {
+        return consumers_.size();
+    }
+
+    // Adds a consumer calling the event delegate created from `target`, e.g. a function object or
+    // a `rome::event_delegate`, and returns its index. The consumer receives the values published
+    // afterwards. Shall be called by the producer thread before the consumer threads are started.
+    template<typename D>
+    auto connect(D&& target) -> std::size_t {
+        auto added      = std::make_unique<consumer>();
+        added->delegate = delegate_type{std::forward<D>(target)};
+        added->sequence.value.store(
+            published_.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        consumers_.push_back(std::move(added));
+        return consumers_.size() - 1;
+    }
+
+    // Producer: publishes `value` to all consumers. Returns false and drops the value if the
+    // slowest consumer has not yet read the value `capacity()` positions before. Lock-free.
+    template<typename U>
+    auto try_publish(U&& value) -> bool {
+        const auto next = published_.value.load(std::memory_order_relaxed);
+        if (!has_space(next)) {
+            return false;
+        }
+        values_[next & mask_] = std::forward<U>(value);
+        published_.value.store(next + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer: publishes `value` to all consumers. Yields until the slowest consumer has read the
+    // value `capacity()` positions before.
+    template<typename U>
+    void publish(U&& value) {
+        const auto next = published_.value.load(std::memory_order_relaxed);
+        while (!has_space(next)) {
+            std::this_thread::yield();
+        }
+        values_[next & mask_] = std::forward<U>(value);
+        published_.value.store(next + 1, std::memory_order_release);
+    }
+
+    // Consumer: returns the number of published values the consumer `index` has not yet read.
+    auto pending(const std::size_t index) const noexcept -> std::size_t {
+        return published_.value.load(std::memory_order_acquire)
+               - consumers_[index]->sequence.value.load(std::memory_order_relaxed);
+    }
+
+    // Consumer: calls the event delegate of consumer `index` with all values published and not yet
+    // read, in order. The values are read in one batch, the sequence is updated once afterwards.
+    // Returns the number of values read. If the event delegate throws, the values up to the one
+    // passed are read. Shall only be called by the thread of the consumer.
+    auto poll(const std::size_t index) -> std::size_t {
+        auto& c         = *consumers_[index];
+        const auto from = c.sequence.value.load(std::memory_order_relaxed);
+        const auto to   = published_.value.load(std::memory_order_acquire);
+        if (from == to) {
+            return 0U;
+        }
+
+        // releases the values read, also if the event delegate throws
+        struct release {
+            std::atomic<std::size_t>& sequence;
+            std::size_t next;
+            ~release() {
+                sequence.store(next, std::memory_order_release);
+            }
+        } releaseValues{c.sequence.value, from};
+        while (releaseValues.next != to) {
+            const auto& value = values_[releaseValues.next & mask_];
+            ++releaseValues.next;
+            c.delegate(value);
+        }
+        return to - from;
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_BROADCAST_RING_HPP
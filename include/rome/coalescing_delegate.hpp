@@ -0,0 +1,126 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::coalescing_delegate<void(Args...)>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_COALESCING_DELEGATE_HPP
+#define ROME_COALESCING_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+// An event delegate that keeps only the newest arguments it is called with and calls its target
+// with them at most once per `flush()`. The arguments are passed from one producer to one consumer
+// through a lock-free triple buffer. See the documentation in `doc/coalescing_delegate.md`.
+template<typename Signature>
+class coalescing_delegate {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with return type 'void'.");
+};
+
+template<typename... Args>
+class coalescing_delegate<void(Args...)> {
+    static_assert(detail::delegate::all_of<detail::delegate::is_storable<Args>...>,
+        "Invalid parameter 'Signature'. The decayed argument types must be default constructible "
+        "and assignable from the arguments.");
+
+  public:
+    using delegate_type = event_delegate<void(Args...)>;
+
+  private:
+    using arguments_type = std::tuple<std::decay_t<Args>...>;
+
+    // `state_` holds the index of the buffer shared between producer and consumer, and whether it
+    // holds arguments not yet passed to the target.
+    static constexpr std::uint8_t indexMask = 0x03U;
+    static constexpr std::uint8_t freshBit  = 0x04U;
+
+    std::array<arguments_type, 3> buffers_ = {};
+    std::atomic<std::uint8_t> state_{1U};
+    std::uint8_t back_  = 0U;  // written by the producer only
+    std::uint8_t front_ = 2U;  // read by the consumer only
+    delegate_type delegate_;
+
+    template<std::size_t... indices>
+    void call(arguments_type& arguments, std::index_sequence<indices...> /*unused*/) const {
+        delegate_(static_cast<Args&&>(std::get<indices>(arguments))...);
+    }
+
+  public:
+    coalescing_delegate() noexcept = default;
+
+    // Creates a coalescing delegate with its event delegate created from `target`, e.g. a function
+    // object or a `rome::event_delegate`.
+    template<typename T,
+        std::enable_if_t<!std::is_same<coalescing_delegate, std::decay_t<T>>::value, int> = 0>
+    explicit coalescing_delegate(T&& target) noexcept(
+        std::is_nothrow_constructible<delegate_type, T>::value)
+        : delegate_{std::forward<T>(target)} {
+    }
+
+    coalescing_delegate(const coalescing_delegate&) = delete;
+    coalescing_delegate(coalescing_delegate&&)      = delete;
+    ~coalescing_delegate()                          = default;
+
+    auto operator=(const coalescing_delegate&) -> coalescing_delegate& = delete;
+    auto operator=(coalescing_delegate&&) -> coalescing_delegate&      = delete;
+
+    // Returns the event delegate called by `flush()`. Shall only be accessed by the consumer.
+    auto delegate() noexcept -> delegate_type& {
+        return delegate_;
+    }
+
+    auto delegate() const noexcept -> const delegate_type& {
+        return delegate_;
+    }
+
+    // Producer: stores `args` as the newest arguments, replacing the ones not yet flushed. Does not
+    // call the target. Wait-free.
+    void operator()(Args... args) noexcept(
+        std::is_nothrow_assignable<arguments_type&, std::tuple<Args&&...>>::value) {
+        buffers_[back_] = std::forward_as_tuple(std::forward<Args>(args)...);
+        back_ = static_cast<std::uint8_t>(
+            state_.exchange(static_cast<std::uint8_t>(back_ | freshBit), std::memory_order_acq_rel)
+            & indexMask);
+    }
+
+    // Consumer: returns whether there are arguments that were not yet flushed.
+    auto pending() const noexcept -> bool {
+        return (state_.load(std::memory_order_acquire) & freshBit) != 0U;
+    }
+
+    // Consumer: calls the target once with the newest arguments, if there are arguments that
+    // were not yet flushed. Returns whether the target was called. Wait-free, except for the call.
+    auto flush() -> bool {
+        if (!pending()) {
+            return false;
+        }
+        front_ = static_cast<std::uint8_t>(
+            state_.exchange(front_, std::memory_order_acq_rel) & indexMask);
+        call(buffers_[front_], std::index_sequence_for<Args...>{});
+        return true;
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_COALESCING_DELEGATE_HPP
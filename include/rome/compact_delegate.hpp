@@ -0,0 +1,477 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::compact_delegate<Ret(Args...), Behavior>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_COMPACT_DELEGATE_HPP
+#define ROME_COMPACT_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+namespace detail {
+    namespace compact_delegate {
+        using delegate::storage_type;
+
+        // The operations on a target of a compact delegate. One constant table exists per target
+        // type and signature, the compact delegate only stores its address.
+        template<typename Ret, typename... Args>
+        struct ops {
+            Ret (*invoke)(storage_type&, Args...);
+            void (*destroy)(storage_type&) noexcept;
+        };
+
+        // The operations used when no target is assigned.
+        template<bool shallThrow, typename Ret, typename... Args>
+        struct empty_ops {
+            static constexpr ops<Ret, Args...> value = {
+                delegate::empty_invoker<shallThrow, Ret, Args...>::value, &delegate::do_nothing<>};
+        };
+
+        template<bool shallThrow, typename Ret, typename... Args>
+        constexpr ops<Ret, Args...> empty_ops<shallThrow, Ret, Args...>::value;
+
+        // The operations used for a function object of type `Functor`.
+        template<typename Functor, typename Ret, typename... Args>
+        struct functor_ops {
+            using access = delegate::stored_functor<Functor>;
+
+            static constexpr ops<Ret, Args...> value = {
+                access::template invoker<Ret, Args...>(), access::deleter()};
+        };
+
+        template<typename Functor, typename Ret, typename... Args>
+        constexpr ops<Ret, Args...> functor_ops<Functor, Ret, Args...>::value;
+
+        // The operations used for a target that is fully described by the stored value and the
+        // invoking function `invokeTarget`, e.g. a function or a member function and its object.
+        template<typename Invoker, Invoker invokeTarget>
+        struct non_functor_ops;
+
+        template<typename Ret, typename... Args, Ret (*invokeTarget)(storage_type&, Args...)>
+        struct non_functor_ops<Ret (*)(storage_type&, Args...), invokeTarget> {
+            static constexpr ops<Ret, Args...> value = {invokeTarget, &delegate::do_nothing<>};
+        };
+
+        template<typename Ret, typename... Args, Ret (*invokeTarget)(storage_type&, Args...)>
+        constexpr ops<Ret, Args...>
+            non_functor_ops<Ret (*)(storage_type&, Args...), invokeTarget>::value;
+    }  // namespace compact_delegate
+
+
+    // Implements the actual behavior of all compact delegates. Same as `delegate_core`, but the
+    // invoking and the destroying function are replaced by a pointer to a constant table holding
+    // both. This saves one pointer per delegate at the cost of one more dependent load per call.
+    template<typename Signature, bool shallThrowWhenEmpty>
+    class compact_delegate_core;
+
+    template<typename Ret, typename... Args, bool shallThrowWhenEmpty>
+    class compact_delegate_core<Ret(Args...), shallThrowWhenEmpty> {
+        using storage_type = delegate::storage_type;
+        using ops_type     = compact_delegate::ops<Ret, Args...>;
+
+        static constexpr const ops_type* emptyOps =
+            &compact_delegate::empty_ops<shallThrowWhenEmpty, Ret, Args...>::value;
+
+        // storage_ needs to be writable by `operator()(Args...) const` while small object
+        // optimization is used
+        alignas(delegate::storage_alignment) mutable storage_type storage_ = nullptr;
+        const ops_type* ops_                                               = emptyOps;
+
+      public:
+        constexpr compact_delegate_core() noexcept                   = default;
+        compact_delegate_core(const compact_delegate_core&) noexcept = delete;
+        ROME_DELEGATE_CPP20_CONSTEXPR compact_delegate_core(compact_delegate_core&& orig) noexcept {
+            orig.swap(*this);
+        }
+
+        // Creates a compact delegate core with a target that is fully described by the value of
+        // `storage` and the operations `targetOps`. Thus, the target needs no destruction.
+        constexpr compact_delegate_core(storage_type storage, const ops_type* targetOps) noexcept
+            : storage_{storage}, ops_{targetOps} {
+        }
+
+        ROME_DELEGATE_CPP20_CONSTEXPR ~compact_delegate_core() {
+            ops_->destroy(storage_);
+        }
+
+        auto operator=(const compact_delegate_core&) noexcept -> compact_delegate_core& = delete;
+        ROME_DELEGATE_CPP20_CONSTEXPR auto operator=(compact_delegate_core&& orig) noexcept
+            -> compact_delegate_core& {
+            compact_delegate_core{std::move(orig)}.swap(*this);
+            return *this;
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return ops_ != emptyOps;
+        }
+
+        auto operator()(Args... args) const -> Ret {
+            return ops_->invoke(storage_, static_cast<Args>(args)...);
+        }
+
+        ROME_DELEGATE_CPP20_CONSTEXPR void swap(compact_delegate_core& other) noexcept {
+            using std::swap;
+            swap(storage_, other.storage_);
+            swap(ops_, other.ops_);
+        }
+
+        ROME_DELEGATE_CPP20_CONSTEXPR void drop_target() noexcept {
+            compact_delegate_core{}.swap(*this);
+        }
+
+        // Returns the address of the assigned function object if it is of type `Functor`, or
+        // nullptr otherwise. Compares the address of the operations with the one for `Functor`.
+        template<typename Functor>
+        auto target() const noexcept -> Functor* {
+            if (ops_ != &compact_delegate::functor_ops<Functor, Ret, Args...>::value) {
+                return nullptr;
+            }
+            return delegate::stored_functor<Functor>::address(storage_);
+        }
+
+        // Does not store the stateless function object constructed from `args`. It is recreated
+        // on each call. The compact delegate core must be empty.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<delegate::is_stateless<Functor>, int> = 0>
+        constexpr void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            (void)Functor(std::forward<CtorArgs>(args)...);
+            ops_ = &compact_delegate::functor_ops<Functor, Ret, Args...>::value;
+        }
+
+        // Constructs the function object from `args` inside the local storage. The compact
+        // delegate core must be empty.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            // NOLINTNEXTLINE(bugprone-multi-level-implicit-pointer-conversion)
+            (void)::new (&storage_) Functor(std::forward<CtorArgs>(args)...);
+            ops_ = &compact_delegate::functor_ops<Functor, Ret, Args...>::value;
+        }
+
+        // Constructs the function object from `args` in a dynamically allocated storage. The
+        // compact delegate core must be empty.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && !delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) {
+            storage_ = new Functor(std::forward<CtorArgs>(args)...);
+            ops_     = &compact_delegate::functor_ops<Functor, Ret, Args...>::value;
+        }
+    };
+
+    template<typename Ret, typename... Args, bool shallThrowWhenEmpty>
+    constexpr const compact_delegate::ops<Ret, Args...>*
+        compact_delegate_core<Ret(Args...), shallThrowWhenEmpty>::emptyOps;
+
+
+    // Provides common compact delegate behavior using the 'curiously recurring template pattern',
+    // like `base_delegate`.
+    template<typename DerivedDelegate>
+    class base_compact_delegate;
+
+    template<template<typename, typename> class DerivedDelegate, typename Ret, typename... Args,
+        typename Behavior>
+    class base_compact_delegate<DerivedDelegate<Ret(Args...), Behavior>> {
+        using delegate_type = DerivedDelegate<Ret(Args...), Behavior>;
+        using core_type     = compact_delegate_core<Ret(Args...),
+            !std::is_same<Behavior, target_is_optional>::value>;
+        using invoker       = delegate::non_functor_invoker<Ret(Args...)>;
+        core_type core_     = {};
+
+        template<typename Invoker, Invoker invokeTarget>
+        static constexpr auto ops() noexcept -> const compact_delegate::ops<Ret, Args...>* {
+            return &compact_delegate::non_functor_ops<Invoker, invokeTarget>::value;
+        }
+
+        template<typename F>
+        static constexpr void assert_target_type() noexcept {
+            static_assert(std::is_class<F>::value && std::is_same<F, std::decay_t<F>>::value,
+                "Invalid target type 'F'. The type must be the decayed type of a function object "
+                "(a class type with a function call operator, e.g. a lambda).");
+            static_assert(delegate::is_callable_by<F, Ret(Args...)>,
+                "Invalid target type 'F'. The function call signature of the type must be "
+                "compatible with the signature of the delegate.");
+        }
+
+        constexpr explicit base_compact_delegate(core_type&& core) noexcept
+            : core_{std::move(core)} {
+        }
+
+      public:
+        constexpr base_compact_delegate() noexcept = default;
+
+        constexpr explicit operator bool() const noexcept {
+            return core_.operator bool();
+        }
+
+        auto operator()(Args... args) const -> Ret {
+            return core_.operator()(static_cast<Args>(args)...);
+        }
+
+        void swap(delegate_type& other) noexcept {
+            core_.swap(other.core_);
+        }
+
+        void drop_target() noexcept {
+            core_.drop_target();
+        }
+
+        // Returns a pointer to the target if it is a function object of type `F`, nullptr
+        // otherwise.
+        template<typename F>
+        auto target() noexcept -> F* {
+            assert_target_type<F>();
+            return core_.template target<F>();
+        }
+
+        template<typename F>
+        auto target() const noexcept -> const F* {
+            assert_target_type<F>();
+            return core_.template target<F>();
+        }
+
+        // Replaces the target by a function object of type `F` constructed in place from `args`.
+        // The current target is kept if the construction throws.
+        template<typename F, typename... CtorArgs>
+        auto emplace(CtorArgs&&... args) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<F>(std::forward<CtorArgs>(args)...)))
+            -> F& {
+            assert_target_type<F>();
+            core_type core;
+            core.template emplace<F>(std::forward<CtorArgs>(args)...);
+            core_.swap(core);
+            return *core_.template target<F>();
+        }
+
+        // Creates a new compact delegate targeting a function object of type `F` constructed in
+        // place from `args`.
+        template<typename F, typename... CtorArgs>
+        static constexpr auto create_in_place(CtorArgs&&... args) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<F>(std::forward<CtorArgs>(args)...)))
+            -> delegate_type {
+            assert_target_type<F>();
+            base_compact_delegate dgt;
+            dgt.core_.template emplace<F>(std::forward<CtorArgs>(args)...);
+            return {std::move(dgt)};
+        }
+
+        // Creates a new compact delegate targeting the passed function or static member function.
+        template<Ret (*pFunction)(Args...)>
+        static constexpr auto create() noexcept -> delegate_type {
+            using invoke_type = Ret (*)(delegate::storage_type&, Args...);
+            return {base_compact_delegate{core_type{nullptr,
+                ops<invoke_type, &invoker::template invoke_function<pFunction>>()}}};
+        }
+
+        // Creates a new compact delegate targeting the non-static member function and related
+        // object. Does NOT take ownership of the passed object `obj`.
+        template<typename C, Ret (C::*pMethod)(Args...)>
+        static constexpr auto create(C& obj) noexcept -> delegate_type {
+            using invoke_type = Ret (*)(delegate::storage_type&, Args...);
+            return {base_compact_delegate{core_type{static_cast<void*>(&obj),
+                ops<invoke_type, &invoker::template invoke_member_function<C, pMethod>>()}}};
+        }
+
+        // Creates a new compact delegate targeting the passed non-static const member function and
+        // related object. Does NOT take ownership of the passed object `obj`.
+        template<typename C, Ret (C::*pMethod)(Args...) const>
+        static constexpr auto create(const C& obj) noexcept -> delegate_type {
+            using invoke_type = Ret (*)(delegate::storage_type&, Args...);
+            return {base_compact_delegate{core_type{static_cast<void*>(const_cast<C*>(&obj)),
+                ops<invoke_type, &invoker::template invoke_const_member_function<C, pMethod>>()}}};
+        }
+
+        // Creates a new compact delegate targeting the passed function object and taking
+        // ownership of it.
+        template<typename T, typename Functor = std::decay_t<T>>
+        static constexpr auto create(T&& functor) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<Functor>(std::forward<T>(functor))))
+            -> delegate_type {
+            static_assert(std::is_class<Functor>::value,
+                "Invalid object passed. Object needs to be a function object (a class type with a "
+                "function call operator, e.g. a lambda).");
+            static_assert(delegate::is_callable_by<Functor, Ret(Args...)>,
+                "Passed function object has incompatible function call signature. The function "
+                "call signature must be compatible with the signature of the delegate so that the "
+                "delegate is able to invoke the function object.");
+            base_compact_delegate dgt;
+            dgt.core_.template emplace<Functor>(std::forward<T>(functor));
+            return {std::move(dgt)};
+        }
+    };
+}  // namespace detail
+
+
+// Can store and invoke any callable target like `rome::delegate`, but has the size of only two
+// pointers. See the documentation in `doc/compact_delegate.md`.
+template<typename Signature, typename Behavior = target_is_expected>
+class compact_delegate {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter "
+        "'Signature' must be a valid function signature.");
+};
+
+template<typename Ret, typename... Args, typename Behavior>
+class compact_delegate<Ret(Args...), Behavior>
+    : private detail::base_compact_delegate<compact_delegate<Ret(Args...), Behavior>> {
+    static_assert(detail::delegate::is_behavior<Behavior>,
+        "Invalid parameter 'Behavior'. The template parameter 'Behavior' must either be empty or "
+        "contain one of the types 'rome::target_is_optional', 'rome::target_is_expected' or "
+        "'rome::target_is_mandatory'.");
+    static_assert(detail::delegate::is_valid_behavior<Ret, Behavior>,
+        "Return type coflicts with parameter 'Behavior'. The parameter 'Behavior' is only "
+        "allowed to be 'rome::target_is_optional' if the return type is 'void'.");
+
+    using base_type = detail::base_compact_delegate<compact_delegate<Ret(Args...), Behavior>>;
+    // give base_type access to private constructor `compact_delegate(base_type&&)`
+    friend base_type;
+
+    constexpr compact_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+
+  public:
+    constexpr compact_delegate() noexcept              = default;
+    compact_delegate(const compact_delegate&) noexcept = delete;
+    compact_delegate(compact_delegate&&) noexcept      = default;
+    ~compact_delegate()                                = default;
+
+    auto operator=(const compact_delegate&) noexcept -> compact_delegate& = delete;
+    auto operator=(compact_delegate&&) noexcept -> compact_delegate&      = default;
+
+    // Construct from a function object target.
+    // SFINAE to prevent hiding the constructors `compact_delegate(compact_delegate&&)`,
+    // `compact_delegate(base_type&&)`, `compact_delegate(std::nullptr_t)` and
+    // `compact_delegate(in_place_type_t<F>, args...)`.
+    template<typename Functor,
+        std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
+            int> = 0>
+    constexpr compact_delegate(Functor&& functor) noexcept(
+        noexcept(base_type::create(std::forward<Functor>(functor))))
+        : compact_delegate{base_type::create(std::forward<Functor>(functor))} {
+    }
+
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit compact_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : compact_delegate{
+              base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    constexpr compact_delegate(std::nullptr_t) noexcept : compact_delegate{} {
+    }
+    auto operator=(std::nullptr_t) noexcept -> compact_delegate& {
+        base_type::drop_target();
+        return *this;
+    }
+
+    using base_type::swap;
+    using base_type::operator bool;
+    using base_type::operator();
+    using base_type::create;
+    using base_type::target;
+    using base_type::emplace;
+
+    friend constexpr auto operator==(const compact_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const compact_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const compact_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const compact_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+template<typename Ret, typename... Args>
+class compact_delegate<Ret(Args...), target_is_mandatory>
+    : private detail::base_compact_delegate<compact_delegate<Ret(Args...), target_is_mandatory>> {
+    using base_type =
+        detail::base_compact_delegate<compact_delegate<Ret(Args...), target_is_mandatory>>;
+    // give base_type access to private constructor `compact_delegate(base_type&&)`
+    friend base_type;
+
+    constexpr compact_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+
+  public:
+    constexpr compact_delegate() noexcept              = delete;
+    compact_delegate(const compact_delegate&) noexcept = delete;
+    compact_delegate(compact_delegate&&) noexcept      = default;
+    ~compact_delegate()                                = default;
+
+    auto operator=(const compact_delegate&) noexcept -> compact_delegate& = delete;
+    auto operator=(compact_delegate&&) noexcept -> compact_delegate&      = default;
+
+    // Construct directly from a function object target.
+    // SFINAE to prevent hiding the constructors `compact_delegate(compact_delegate&&)`,
+    // `compact_delegate(base_type&&)`, `compact_delegate(std::nullptr_t)` and
+    // `compact_delegate(in_place_type_t<F>, args...)`.
+    template<typename Functor,
+        std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
+            int> = 0>
+    constexpr compact_delegate(Functor&& functor) noexcept(
+        noexcept(base_type::create(std::forward<Functor>(functor))))
+        : compact_delegate{base_type::create(std::forward<Functor>(functor))} {
+    }
+
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit compact_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : compact_delegate{
+              base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    using base_type::swap;
+    using base_type::operator bool;
+    using base_type::operator();
+    using base_type::create;
+    using base_type::target;
+    using base_type::emplace;
+
+    friend constexpr auto operator==(const compact_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const compact_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const compact_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const compact_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_COMPACT_DELEGATE_HPP
@@ -25,11 +25,23 @@
 #include <algorithm>
 #include <cstddef>
 #include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
 #include <new>
 #include <type_traits>
 #include <utility>
 
 
+// Marks functions that are usable in constant expressions only since C++20, as they destroy a
+// target or use `std::swap`.
+#if defined(__cpp_constexpr_dynamic_alloc) && (__cpp_constexpr_dynamic_alloc >= 201907L)
+#    define ROME_DELEGATE_CPP20_CONSTEXPR constexpr
+#else
+#    define ROME_DELEGATE_CPP20_CONSTEXPR
+#endif
+
+
 namespace rome {
 
 // Used as template argument for delegates to declare that it invoking an empty delegate is valid
@@ -43,6 +55,21 @@ struct target_is_expected;
 struct target_is_mandatory;
 
 
+#if defined(__cpp_inline_variables) && (__cpp_inline_variables >= 201606L)
+using std::in_place_type;
+using std::in_place_type_t;
+#else
+// Used as tag to construct the target of type `T` of a delegate in place.
+template<typename T>
+struct in_place_type_t {
+    explicit in_place_type_t() = default;
+};
+
+template<typename T>
+constexpr in_place_type_t<T> in_place_type{};
+#endif
+
+
 class bad_delegate_call : public std::exception {
   public:
     auto what() const noexcept -> const char* override {
@@ -64,14 +91,66 @@ namespace detail {
         constexpr bool is_small_object_optimizable =
             (sizeof(T) <= sizeof(storage_type)) && (alignof(T) <= storage_alignment);
 
+        // Returns whether an object of type T has no state and thus does not need to be stored
+        // within the delegate. It is recreated whenever it is called instead, e.g. a lambda
+        // expression without captures since C++20.
+        template<typename T>
+        constexpr bool is_stateless =
+            std::is_empty<T>::value && std::is_trivially_default_constructible<T>::value
+            && std::is_trivially_copyable<T>::value;
+
+        template<typename T>
+        struct is_in_place_type_impl : std::false_type {};
+
+        template<typename T>
+        struct is_in_place_type_impl<in_place_type_t<T>> : std::true_type {};
+
+        // Returns whether `T` is the tag type `rome::in_place_type_t<U>` for any `U`.
+        template<typename T>
+        constexpr bool is_in_place_type = is_in_place_type_impl<T>::value;
+
+        // Returns whether all `values` are true.
+        template<bool... values>
+        constexpr bool all_of = std::is_same<std::integer_sequence<bool, true, values...>,
+            std::integer_sequence<bool, values..., true>>::value;
+
+        // Returns whether all `values` are false.
+        template<bool... values>
+        constexpr bool none_of = std::is_same<std::integer_sequence<bool, false, values...>,
+            std::integer_sequence<bool, values..., false>>::value;
+
+        // Returns whether arguments of type `T` can be stored by value and replaced by newer ones.
+        template<typename T>
+        constexpr bool is_storable = std::is_default_constructible<std::decay_t<T>>::value
+                                     && std::is_assignable<std::decay_t<T>&, T>::value;
+
+        // Returns the smallest power of two not less than `value`, at least 1.
+        constexpr auto ceil_power_of_two(const std::size_t value) noexcept -> std::size_t {
+            std::size_t result = 1U;
+            while (result < value) {
+                result *= 2U;
+            }
+            return result;
+        }
+
+        // Returns the address of a constructor argument, or nullptr if it is a function.
+        template<typename T, std::enable_if_t<!std::is_function<T>::value, int> = 0>
+        auto address_of_argument(const T& arg) noexcept -> const void* {
+            return std::addressof(arg);
+        }
+
+        template<typename T, std::enable_if_t<std::is_function<T>::value, int> = 0>
+        auto address_of_argument(const T& /*unused*/) noexcept -> const void* {
+            return nullptr;
+        }
+
         // Used by a delegate when nothing needs to be done.
         template<typename... Args>
-        void do_nothing(storage_type&, Args...) noexcept {
+        constexpr void do_nothing(storage_type&, Args...) noexcept {
         }
 
-        // Used by an empty delegate when calling the delegate is invalid.
-        template<typename Ret, typename... Args>
-        [[noreturn]] auto throw_on_call(storage_type&, Args...) -> Ret {
+        // Throws `rome::bad_delegate_call`, or terminates if exceptions are disabled.
+        [[noreturn]] inline void throw_bad_delegate_call() {
 #if (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
             throw rome::bad_delegate_call{};
 #else
@@ -79,6 +158,48 @@ namespace detail {
 #endif
         }
 
+        // Used by an empty delegate when calling the delegate is invalid.
+        template<typename Ret, typename... Args>
+        [[noreturn]] auto throw_on_call(storage_type&, Args...) -> Ret {
+            throw_bad_delegate_call();
+        }
+
+        // Used by a delegate to invoke targets that are not function objects.
+        template<typename Signature>
+        struct non_functor_invoker;
+
+        template<typename Ret, typename... Args>
+        struct non_functor_invoker<Ret(Args...)> {
+            // Used by a delegate with an assigned free function or static member function.
+            template<Ret (*pFunction)(Args...)>
+            static auto invoke_function(storage_type&, Args... args) -> Ret {
+                return (*pFunction)(static_cast<Args>(args)...);
+            }
+
+            // Used by a delegate with an assigned non-static member function. The storage contains
+            // the address of the related object.
+            template<typename C, Ret (C::*pMethod)(Args...)>
+            static auto invoke_member_function(storage_type& storage, Args... args) -> Ret {
+                auto* pObject = static_cast<C*>(storage);
+                return (pObject->*pMethod)(static_cast<Args>(args)...);
+            }
+
+            // Used by a delegate with an assigned non-static const member function. The storage
+            // contains the address of the related object.
+            template<typename C, Ret (C::*pMethod)(Args...) const>
+            static auto invoke_const_member_function(storage_type& storage, Args... args) -> Ret {
+                const auto* pObject = static_cast<const C*>(storage);
+                return (pObject->*pMethod)(static_cast<Args>(args)...);
+            }
+        };
+
+        // Used by a delegate with an assigned stateless functor, which was not stored.
+        template<typename Functor, typename Ret, typename... Args>
+        auto invoke_stateless_functor(storage_type&, Args... args) -> Ret {
+            Functor functor{};
+            return functor(static_cast<Args>(args)...);
+        }
+
         // Used by a delegate with an assigned functor that was small object optimized inside the
         // delegate.
         template<typename Functor, typename Ret, typename... Args>
@@ -116,6 +237,62 @@ namespace detail {
             delete pFunctor;
         }
 
+        // Provides access to a function object of type `Functor` assigned to a delegate, depending
+        // on how it is stored. Selects the dynamically allocated storage by default.
+        template<typename Functor, bool isStateless = is_stateless<Functor>,
+            bool isSmall = is_small_object_optimizable<Functor>>
+        struct stored_functor {
+            template<typename Ret, typename... Args>
+            static constexpr auto invoker() noexcept -> Ret (*)(storage_type&, Args...) {
+                return &invoke_dynamically_allocated_functor<Functor, Ret, Args...>;
+            }
+
+            static constexpr auto deleter() noexcept -> void (*)(storage_type&) noexcept {
+                return &delete_dynamically_allocated_functor<Functor>;
+            }
+
+            static auto address(storage_type& storage) noexcept -> Functor* {
+                return static_cast<Functor*>(storage);
+            }
+        };
+
+        template<typename Functor>
+        struct stored_functor<Functor, false, true> {
+            template<typename Ret, typename... Args>
+            static constexpr auto invoker() noexcept -> Ret (*)(storage_type&, Args...) {
+                return &invoke_locally_stored_functor<Functor, Ret, Args...>;
+            }
+
+            static constexpr auto deleter() noexcept -> void (*)(storage_type&) noexcept {
+                return &destroy_locally_stored_functor<Functor>;
+            }
+
+            static auto address(storage_type& storage) noexcept -> Functor* {
+                // NOLINTNEXTLINE(bugprone-multi-level-implicit-pointer-conversion)
+                auto* pStorage = static_cast<void*>(&storage);  // conversion from void** to void*
+                return static_cast<Functor*>(pStorage);
+            }
+        };
+
+        // A stateless function object is not stored. As all its objects are equal, the address of
+        // a shared object is provided instead.
+        template<typename Functor, bool isSmall>
+        struct stored_functor<Functor, true, isSmall> {
+            template<typename Ret, typename... Args>
+            static constexpr auto invoker() noexcept -> Ret (*)(storage_type&, Args...) {
+                return &invoke_stateless_functor<Functor, Ret, Args...>;
+            }
+
+            static constexpr auto deleter() noexcept -> void (*)(storage_type&) noexcept {
+                return &do_nothing<>;
+            }
+
+            static auto address(storage_type& /*unused*/) noexcept -> Functor* {
+                static Functor functor{};
+                return &functor;
+            }
+        };
+
 
         // The function that is called when a delegate has no target assigned, based on whether it
         // shall throw an exception or not.
@@ -151,19 +328,43 @@ namespace detail {
         Ret (*invokeTarget_)(storage_type&, Args...)                       = emptyInvoker;
         void (*deleteTarget_)(storage_type&) noexcept                      = &delegate::do_nothing;
 
+        template<typename, bool>
+        friend class delegate_core;
+
       public:
         constexpr delegate_core() noexcept           = default;
         delegate_core(const delegate_core&) noexcept = delete;
-        delegate_core(delegate_core&& orig) noexcept {
+        ROME_DELEGATE_CPP20_CONSTEXPR delegate_core(delegate_core&& orig) noexcept {
             orig.swap(*this);
         }
 
-        ~delegate_core() {
+        // Takes over the target of a delegate core that differs only in the behavior when empty.
+        // Stays empty if `orig` is empty, as the function invoked when empty differs.
+        template<bool otherShallThrowWhenEmpty>
+        explicit delegate_core(
+            delegate_core<Ret(Args...), otherShallThrowWhenEmpty>&& orig) noexcept {
+            if (orig) {
+                storage_      = orig.storage_;
+                invokeTarget_ = orig.invokeTarget_;
+                deleteTarget_ = orig.deleteTarget_;
+                orig.release();
+            }
+        }
+
+        // Creates a delegate core with a target that is fully described by the value of `storage`
+        // and the function `invokeTarget`. Thus, the target needs no destruction.
+        constexpr delegate_core(
+            storage_type storage, Ret (*invokeTarget)(storage_type&, Args...)) noexcept
+            : storage_{storage}, invokeTarget_{invokeTarget} {
+        }
+
+        ROME_DELEGATE_CPP20_CONSTEXPR ~delegate_core() {
             (*deleteTarget_)(storage_);
         }
 
         auto operator=(const delegate_core&) noexcept -> delegate_core& = delete;
-        auto operator=(delegate_core&& orig) noexcept -> delegate_core& {
+        ROME_DELEGATE_CPP20_CONSTEXPR auto operator=(delegate_core&& orig) noexcept
+            -> delegate_core& {
             delegate_core{std::move(orig)}.swap(*this);
             return *this;
         }
@@ -176,35 +377,132 @@ namespace detail {
             return (*invokeTarget_)(storage_, static_cast<Args>(args)...);
         }
 
-        void swap(delegate_core& other) noexcept {
+        ROME_DELEGATE_CPP20_CONSTEXPR void swap(delegate_core& other) noexcept {
             using std::swap;
             swap(storage_, other.storage_);
             swap(invokeTarget_, other.invokeTarget_);
             swap(deleteTarget_, other.deleteTarget_);
         }
 
-        void drop_target() noexcept {
+        ROME_DELEGATE_CPP20_CONSTEXPR void drop_target() noexcept {
             delegate_core{}.swap(*this);
         }
 
-        // Stores the passed function object inside the local storage of the delegate.
-        template<typename T,
-            std::enable_if_t<delegate::is_small_object_optimizable<std::decay_t<T>>, int> = 0>
-        void assign(T&& functor) noexcept(noexcept(std::decay_t<T>(std::forward<T>(functor)))) {
-            using Functor = std::decay_t<T>;
+      private:
+        // Leaves the core empty without destroying the target, after another core took it over.
+        void release() noexcept {
+            storage_      = nullptr;
+            invokeTarget_ = emptyInvoker;
+            deleteTarget_ = &delegate::do_nothing;
+        }
+
+      public:
+
+        // Returns the address of the assigned function object if it is of type `Functor`, or
+        // nullptr otherwise. Compares the invoking function with the one used for `Functor`.
+        template<typename Functor>
+        auto target() const noexcept -> Functor* {
+            using access = delegate::stored_functor<Functor>;
+            if (invokeTarget_ != access::template invoker<Ret, Args...>()) {
+                return nullptr;
+            }
+            return access::address(storage_);
+        }
+
+        // Takes over the target of a delegate core with any signature if it is a function object
+        // of type `Functor`. Only the invoking function is replaced, the function object is
+        // neither moved nor wrapped. Returns false and leaves `orig` untouched otherwise.
+        template<typename Functor, typename OtherSignature, bool otherShallThrowWhenEmpty>
+        auto adopt(delegate_core<OtherSignature, otherShallThrowWhenEmpty>& orig) noexcept -> bool {
+            if (orig.template target<Functor>() == nullptr) {
+                return false;
+            }
+            drop_target();
+            storage_      = orig.storage_;
+            invokeTarget_ = delegate::stored_functor<Functor>::template invoker<Ret, Args...>();
+            deleteTarget_ = orig.deleteTarget_;
+            orig.release();
+            return true;
+        }
+
+        // Stores the passed function object as target.
+        template<typename T>
+        constexpr void assign(T&& functor) noexcept(noexcept(
+            std::declval<delegate_core&>().template emplace<std::decay_t<T>>(
+                std::forward<T>(functor)))) {
+            emplace<std::decay_t<T>>(std::forward<T>(functor));
+        }
+
+        // Returns whether the target is a function object of type `Functor` in a dynamically
+        // allocated storage. Compares both the invoking and the deleting function, so that the
+        // storage is not mistaken for the one of another type with an identical call operator.
+        template<typename Functor>
+        auto is_dynamically_allocated_target() const noexcept -> bool {
+            return invokeTarget_
+                       == &delegate::invoke_dynamically_allocated_functor<Functor, Ret, Args...>
+                   && deleteTarget_ == &delegate::delete_dynamically_allocated_functor<Functor>;
+        }
+
+        // Returns whether one of `args` lies within the dynamically allocated function object of
+        // type `Functor`, e.g. the current target itself or one of its members. The target must be
+        // of type `Functor`, see `is_dynamically_allocated_target`.
+        template<typename Functor, typename... CtorArgs>
+        auto is_within_target(const CtorArgs&... args) const noexcept -> bool {
+            const auto* const first = static_cast<const char*>(storage_);
+            const auto* const last  = first + sizeof(Functor);
+            const std::less<const char*> less{};
+            for (const void* const pArg : std::initializer_list<const void*>{
+                     delegate::address_of_argument(args)...}) {
+                const auto* const address = static_cast<const char*>(pArg);
+                if (address != nullptr && !less(address, first) && less(address, last)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Destroys the dynamically allocated function object of type `Functor` and constructs a
+        // new one from `args` in the same storage. The target must be of type `Functor`, see
+        // `is_dynamically_allocated_target`, and the construction must not throw.
+        // No argument must lie within the current target, see `is_within_target`, as it is read
+        // after the current target was destroyed.
+        template<typename Functor, typename... CtorArgs>
+        void reconstruct(CtorArgs&&... args) noexcept {
+            static_cast<Functor*>(storage_)->~Functor();
+            (void)::new (storage_) Functor(std::forward<CtorArgs>(args)...);
+        }
+
+        // Does not store the stateless function object constructed from `args`. It is recreated
+        // on each call.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<delegate::is_stateless<Functor>, int> = 0>
+        constexpr void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            (void)Functor(std::forward<CtorArgs>(args)...);
+            invokeTarget_ = &delegate::invoke_stateless_functor<Functor, Ret, Args...>;
+        }
+
+        // Constructs the function object from `args` inside the local storage of the delegate.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
             // NOLINTNEXTLINE(bugprone-multi-level-implicit-pointer-conversion)
-            (void)::new (&storage_) Functor(std::forward<T>(functor));
+            (void)::new (&storage_) Functor(std::forward<CtorArgs>(args)...);
             invokeTarget_ = delegate::invoke_locally_stored_functor<Functor, Ret, Args...>;
             deleteTarget_ = delegate::destroy_locally_stored_functor<Functor>;
         }
 
-        // Stores the passed function object at a new location outside the local storage of the
-        // delegate in a dynamically allocated storage.
-        template<typename T,
-            std::enable_if_t<!delegate::is_small_object_optimizable<std::decay_t<T>>, int> = 0>
-        void assign(T&& functor) {
-            using Functor = std::decay_t<T>;
-            storage_      = new Functor(std::forward<T>(functor));
+        // Constructs the function object from `args` at a new location outside the local storage
+        // of the delegate in a dynamically allocated storage.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && !delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) {
+            storage_      = new Functor(std::forward<CtorArgs>(args)...);
             invokeTarget_ = delegate::invoke_dynamically_allocated_functor<Functor, Ret, Args...>;
             deleteTarget_ = delegate::delete_dynamically_allocated_functor<Functor>;
         }
@@ -212,32 +510,6 @@ namespace detail {
 
 
     namespace delegate {
-        // Used to wrap non function object targets as function objects.
-        template<typename Signature>
-        struct functor_factory;
-
-        template<typename Ret, typename... Args>
-        struct functor_factory<Ret(Args...)> {
-            template<Ret (*pFunction)(Args...)>
-            static auto wrap_function() {
-                return [](Args... args) -> Ret { return (*pFunction)(static_cast<Args>(args)...); };
-            }
-
-            template<typename C, Ret (C::*pMethod)(Args...)>
-            static auto wrap_member_function(C& obj) {
-                return [&obj](Args... args) -> Ret {
-                    return (obj.*pMethod)(static_cast<Args>(args)...);
-                };
-            }
-
-            template<typename C, Ret (C::*pMethod)(Args...) const>
-            static auto wrap_const_member_function(const C& obj) {
-                return [&obj](Args... args) -> Ret {
-                    return (obj.*pMethod)(static_cast<Args>(args)...);
-                };
-            }
-        };
-
         // Always false. Used to mark invalid parameters in static_assert.
         template<typename>
         constexpr bool invalid = false;
@@ -366,9 +638,7 @@ namespace detail {
 
         // Returns whether the function arguments `Args...` can be considered immutable.
         template<typename... Args>
-        constexpr bool are_immutable_arguments =
-            std::is_same<std::integer_sequence<bool, true, is_immutable_argument<Args>...>,
-                std::integer_sequence<bool, is_immutable_argument<Args>..., true>>::value;
+        constexpr bool are_immutable_arguments = all_of<is_immutable_argument<Args>...>;
     }  // namespace delegate
 
     // Provides common delegate behavior using the 'curiously recurring template pattern' so that
@@ -376,15 +646,90 @@ namespace detail {
     template<typename DerivedDelegate>
     class base_delegate;
 
+    namespace delegate {
+        template<typename T, typename Sig>
+        struct is_delegate_of_impl : std::false_type {};
+
+        template<template<typename, typename> class DerivedDelegate, typename Ret,
+            typename... Args, typename Behavior>
+        struct is_delegate_of_impl<DerivedDelegate<Ret(Args...), Behavior>, Ret(Args...)>
+            : std::is_base_of<base_delegate<DerivedDelegate<Ret(Args...), Behavior>>,
+                  DerivedDelegate<Ret(Args...), Behavior>>::type {};
+
+        // Returns whether `T` is a delegate with the signature `Sig`, independent of its behavior.
+        template<typename T, typename Sig>
+        constexpr bool is_delegate_of = is_delegate_of_impl<T, Sig>::value;
+
+        template<typename T>
+        struct is_delegate_impl : std::false_type {};
+
+        template<template<typename, typename> class DerivedDelegate, typename Signature,
+            typename Behavior>
+        struct is_delegate_impl<DerivedDelegate<Signature, Behavior>>
+            : std::is_base_of<base_delegate<DerivedDelegate<Signature, Behavior>>,
+                  DerivedDelegate<Signature, Behavior>>::type {};
+
+        // Returns whether `T` is a delegate of any signature and behavior.
+        template<typename T>
+        constexpr bool is_delegate = is_delegate_impl<T>::value;
+
+        // Returns whether `T` is a function object callable by `Sig`, which is not a delegate or a
+        // tag type.
+        template<typename T, typename Sig>
+        constexpr bool is_function_object_for = std::is_class<T>::value && !is_delegate<T>
+                                                && !is_in_place_type<T> && is_callable_by<T, Sig>;
+    }  // namespace delegate
+
     template<template<typename, typename> class DerivedDelegate, typename Ret, typename... Args,
         typename Behavior>
     class base_delegate<DerivedDelegate<Ret(Args...), Behavior>> {
         using delegate_type = DerivedDelegate<Ret(Args...), Behavior>;
         using core_type =
             delegate_core<Ret(Args...), !std::is_same<Behavior, target_is_optional>::value>;
+        using invoker = delegate::non_functor_invoker<Ret(Args...)>;
         core_type core_ = {};
 
+        template<typename>
+        friend class base_delegate;
+
+        constexpr explicit base_delegate(core_type&& core) noexcept : core_{std::move(core)} {
+        }
+
+      protected:
+        // A target that is fully described by the value of the storage and the invoking function,
+        // see the related constructor of `delegate_core`. The derived delegates construct their
+        // base from it in place, so that no core is moved. Moving a core reads its `mutable`
+        // storage, which is not possible in a constant initialization with every compiler.
+        struct fixed_target {
+            delegate::storage_type storage;
+            Ret (*invokeTarget)(delegate::storage_type&, Args...);
+        };
+
+        constexpr explicit base_delegate(const fixed_target target) noexcept
+            : core_{target.storage, target.invokeTarget} {
+        }
+
+      private:
+
+        template<typename F>
+        static constexpr void assert_target_type() noexcept {
+            static_assert(std::is_class<F>::value && std::is_same<F, std::decay_t<F>>::value,
+                "Invalid target type 'F'. The type must be the decayed type of a function object "
+                "(a class type with a function call operator, e.g. a lambda).");
+            static_assert(delegate::is_callable_by<F, Ret(Args...)>,
+                "Invalid target type 'F'. The function call signature of the type must be "
+                "compatible with the signature of the delegate.");
+        }
+
+        template<typename F>
+        auto checked_target() const noexcept -> F* {
+            assert_target_type<F>();
+            return core_.template target<F>();
+        }
+
       public:
+        constexpr base_delegate() noexcept = default;
+
         constexpr explicit operator bool() const noexcept {
             return core_.operator bool();
         }
@@ -401,28 +746,93 @@ namespace detail {
             core_.drop_target();
         }
 
+        // Returns a pointer to the target if it is a function object of type `F`, nullptr
+        // otherwise.
+        template<typename F>
+        auto target() noexcept -> F* {
+            return checked_target<F>();
+        }
+
+        template<typename F>
+        auto target() const noexcept -> const F* {
+            return checked_target<F>();
+        }
+
+        // Calls the target directly if it is a function object of type `F`, so that the compiler
+        // is able to inline the call. Calls the target indirectly otherwise.
+        template<typename F>
+        auto invoke_as(Args... args) const -> Ret {
+            if (auto* pFunctor = checked_target<F>()) {
+                return pFunctor->operator()(static_cast<Args>(args)...);
+            }
+            return core_.operator()(static_cast<Args>(args)...);
+        }
+
+        // Replaces the target by a function object of type `F` constructed in place from `args`.
+        // If the current target is of type `F` too, is dynamically allocated, the construction
+        // does not throw and no argument lies within the current target, the current target is
+        // destroyed and the new one is constructed in the same storage. Otherwise, the new target
+        // is constructed before the current one is destroyed, so that the current target is kept
+        // if the construction throws.
+        template<typename F, typename... CtorArgs>
+        auto emplace(CtorArgs&&... args) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<F>(std::forward<CtorArgs>(args)...)))
+            -> F& {
+            assert_target_type<F>();
+            constexpr bool isReusable = !delegate::is_stateless<F>
+                                        && !delegate::is_small_object_optimizable<F>
+                                        && std::is_nothrow_constructible<F, CtorArgs...>::value;
+            if (isReusable && core_.template is_dynamically_allocated_target<F>()
+                && !core_.template is_within_target<F>(args...)) {
+                core_.template reconstruct<F>(std::forward<CtorArgs>(args)...);
+                return *core_.template target<F>();
+            }
+            core_type core;
+            core.template emplace<F>(std::forward<CtorArgs>(args)...);
+            core_.swap(core);
+            return *core_.template target<F>();
+        }
+
+        // Assigns the passed function object as new target, see `emplace`.
+        template<typename T>
+        void assign(T&& functor) noexcept(noexcept(
+            std::declval<base_delegate&>().template emplace<std::decay_t<T>>(
+                std::forward<T>(functor)))) {
+            (void)emplace<std::decay_t<T>>(std::forward<T>(functor));
+        }
+
+        // Creates a new delegate targeting a function object of type `F` constructed in place from
+        // `args`.
+        template<typename F, typename... CtorArgs>
+        static constexpr auto create_in_place(CtorArgs&&... args) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<F>(std::forward<CtorArgs>(args)...)))
+            -> delegate_type {
+            assert_target_type<F>();
+            base_delegate dgt;
+            dgt.core_.template emplace<F>(std::forward<CtorArgs>(args)...);
+            return {std::move(dgt)};
+        }
+
         // Creates a new delegate targeting the passed function or static member function.
         template<Ret (*pFunction)(Args...)>
         static constexpr auto create() noexcept -> delegate_type {
-            return create(
-                delegate::functor_factory<Ret(Args...)>::template wrap_function<pFunction>());
+            return {fixed_target{nullptr, &invoker::template invoke_function<pFunction>}};
         }
 
         // Creates a new delegate targeting the non-static member function and related object.
         // Does NOT take ownership of the passed object `obj`.
         template<typename C, Ret (C::*pMethod)(Args...)>
-        static auto create(C& obj) noexcept -> delegate_type {
-            return create(
-                delegate::functor_factory<Ret(Args...)>::template wrap_member_function<C, pMethod>(
-                    obj));
+        static constexpr auto create(C& obj) noexcept -> delegate_type {
+            return {fixed_target{
+                static_cast<void*>(&obj), &invoker::template invoke_member_function<C, pMethod>}};
         }
 
         // Creates a new delegate targeting the passed non-static const member function and related
         // object. Does NOT take ownership of the passed object `obj`.
         template<typename C, Ret (C::*pMethod)(Args...) const>
-        static auto create(const C& obj) noexcept -> delegate_type {
-            return create(delegate::functor_factory<Ret(
-                    Args...)>::template wrap_const_member_function<C, pMethod>(obj));
+        static constexpr auto create(const C& obj) noexcept -> delegate_type {
+            return {fixed_target{static_cast<void*>(const_cast<C*>(&obj)),
+                &invoker::template invoke_const_member_function<C, pMethod>}};
         }
 
         // Dummy to capture passed values that are no function objects.
@@ -449,13 +859,75 @@ namespace detail {
                 "delegate is able to invoke the function object.");
         }
 
+        // Creates a new delegate taking over the target of another delegate with the same signature
+        // but any behavior. The target is neither wrapped nor moved. `other` is empty afterwards.
+        // Throws if `other` is empty and this delegate's target is mandatory.
+        template<typename T, typename Other = std::decay_t<T>,
+            std::enable_if_t<!std::is_lvalue_reference<T>::value
+                                 && delegate::is_delegate_of<Other, Ret(Args...)>,
+                int> = 0>
+        static auto create(T&& other) noexcept(
+            !std::is_same<Behavior, target_is_mandatory>::value) -> delegate_type {
+            auto& otherCore = static_cast<base_delegate<Other>&>(other).core_;
+            if (std::is_same<Behavior, target_is_mandatory>::value && !otherCore) {
+                delegate::throw_bad_delegate_call();
+            }
+            return {base_delegate{core_type{std::move(otherCore)}}};
+        }
+
+        // Creates a new delegate from another delegate with any compatible signature. If the
+        // target of `other` is a function object of type `F`, it is taken over and called by a
+        // single invoking function instantiated for `F` and the signature of this delegate.
+        // Otherwise `other` is taken over as by `create(std::move(other))`. `other` is empty
+        // afterwards. Throws if `other` is empty and this delegate's target is mandatory.
+        template<typename F, typename T, typename Other = std::decay_t<T>,
+            std::enable_if_t<!std::is_lvalue_reference<T>::value && delegate::is_delegate<Other>
+                                 && delegate::is_callable_by<Other, Ret(Args...)>,
+                int> = 0>
+        static auto adapt(T&& other) -> delegate_type {
+            assert_target_type<F>();
+            auto& otherCore = static_cast<base_delegate<Other>&>(other).core_;
+            if (!otherCore) {
+                if (std::is_same<Behavior, target_is_mandatory>::value) {
+                    delegate::throw_bad_delegate_call();
+                }
+                return {base_delegate{}};
+            }
+            base_delegate dgt;
+            if (dgt.core_.template adopt<F>(otherCore)) {
+                return {std::move(dgt)};
+            }
+            return create(std::move(other));
+        }
+
         // Creates a new delegate targeting the passed function object and taking ownership of it.
         template<typename T, typename Functor = std::decay_t<T>,
             std::enable_if_t<std::is_class<Functor>::value
-                                 && delegate::is_callable_by<Functor, Ret(Args...)>,
+                                 && delegate::is_callable_by<Functor, Ret(Args...)>
+                                 && !(!std::is_lvalue_reference<T>::value
+                                      && delegate::is_delegate_of<Functor, Ret(Args...)>),
                 int> = 0>
-        static auto create(T&& functor) noexcept(noexcept(
+        static constexpr auto create(T&& functor) noexcept(noexcept(
             std::declval<core_type&>().assign(std::forward<T>(functor)))) -> delegate_type {
+            using is_stateless = std::integral_constant<bool, delegate::is_stateless<Functor>>;
+            return create_functor(std::forward<T>(functor), is_stateless{});
+        }
+
+      private:
+        // A stateless function object is not stored, it is fully described by its invoking
+        // function.
+        template<typename T>
+        // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+        static constexpr auto create_functor(
+            T&& /*unused*/, std::true_type /*isStateless*/) noexcept -> delegate_type {
+            return {fixed_target{nullptr,
+                &delegate::invoke_stateless_functor<std::decay_t<T>, Ret, Args...>}};
+        }
+
+        template<typename T>
+        static auto create_functor(T&& functor, std::false_type /*isStateless*/) noexcept(
+            noexcept(std::declval<core_type&>().assign(std::forward<T>(functor))))
+            -> delegate_type {
             base_delegate dgt;
             dgt.core_.assign(std::forward<T>(functor));
             return {std::move(dgt)};
@@ -484,9 +956,14 @@ class delegate<Ret(Args...), Behavior>
         "allowed to be 'rome::target_is_optional' if the return type is 'void'.");
 
     using base_type = detail::base_delegate<delegate<Ret(Args...), Behavior>>;
-    friend base_type;  // give base_type access to private constructor `delegate(base_type&&)`
+    // give base_type access to private constructor `delegate(base_type&&)`, and the base types of
+    // other delegates access to base_type to take over the target
+    template<typename>
+    friend class detail::base_delegate;
 
-    delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    constexpr delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+    constexpr delegate(typename base_type::fixed_target target) noexcept : base_type{target} {
     }
 
   public:
@@ -500,16 +977,37 @@ class delegate<Ret(Args...), Behavior>
 
     // Construct from a function object target.
     // SFINAE to prevent hiding the constructors `delegate(delegate&&)`, `delegate(base_type&&)`,
-    // and `delegate(std::nullptr_t)`.
+    // `delegate(std::nullptr_t)` and `delegate(in_place_type_t<F>, args...)`.
     template<typename Functor,
         std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
-                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value,
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
             int> = 0>
-    delegate(Functor&& functor) noexcept(
+    constexpr delegate(Functor&& functor) noexcept(
         noexcept(base_type::create(std::forward<Functor>(functor))))
         : delegate{base_type::create(std::forward<Functor>(functor))} {
     }
 
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : delegate{base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    // Assign a function object target. Reuses the dynamically allocated storage of the current
+    // target if it is of the same type.
+    // SFINAE to leave the assignment of anything else to the implicit conversion and the move
+    // assignment.
+    template<typename Functor,
+        std::enable_if_t<
+            detail::delegate::is_function_object_for<std::decay_t<Functor>, Ret(Args...)>, int> = 0>
+    auto operator=(Functor&& functor) noexcept(
+        noexcept(std::declval<base_type&>().assign(std::forward<Functor>(functor)))) -> delegate& {
+        base_type::assign(std::forward<Functor>(functor));
+        return *this;
+    }
+
     constexpr delegate(std::nullptr_t) noexcept : delegate{} {
     }
     constexpr auto operator=(std::nullptr_t) noexcept -> delegate& {
@@ -521,6 +1019,10 @@ class delegate<Ret(Args...), Behavior>
     using base_type::operator bool;
     using base_type::operator();
     using base_type::create;
+    using base_type::target;
+    using base_type::invoke_as;
+    using base_type::adapt;
+    using base_type::emplace;
 
     friend constexpr auto operator==(const delegate& lhs, std::nullptr_t) noexcept -> bool {
         return !lhs;
@@ -540,9 +1042,14 @@ template<typename Ret, typename... Args>
 class delegate<Ret(Args...), target_is_mandatory>
     : private detail::base_delegate<delegate<Ret(Args...), target_is_mandatory>> {
     using base_type = detail::base_delegate<delegate<Ret(Args...), target_is_mandatory>>;
-    friend base_type;  // give base_type access to private constructor `delegate(base_type&&)`
+    // give base_type access to private constructor `delegate(base_type&&)`, and the base types of
+    // other delegates access to base_type to take over the target
+    template<typename>
+    friend class detail::base_delegate;
 
-    delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    constexpr delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+    constexpr delegate(typename base_type::fixed_target target) noexcept : base_type{target} {
     }
 
   public:
@@ -556,20 +1063,45 @@ class delegate<Ret(Args...), target_is_mandatory>
 
     // Construct directly from a function object target.
     // SFINAE to prevent hiding the constructors `delegate(delegate&&)`, `delegate(base_type&&)`,
-    // and `delegate(std::nullptr_t)`.
+    // `delegate(std::nullptr_t)` and `delegate(in_place_type_t<F>, args...)`.
     template<typename Functor,
         std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
-                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value,
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
             int> = 0>
-    delegate(Functor&& functor) noexcept(
+    constexpr delegate(Functor&& functor) noexcept(
         noexcept(base_type::create(std::forward<Functor>(functor))))
         : delegate{base_type::create(std::forward<Functor>(functor))} {
     }
 
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : delegate{base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    // Assign a function object target. Reuses the dynamically allocated storage of the current
+    // target if it is of the same type.
+    // SFINAE to leave the assignment of anything else to the implicit conversion and the move
+    // assignment.
+    template<typename Functor,
+        std::enable_if_t<
+            detail::delegate::is_function_object_for<std::decay_t<Functor>, Ret(Args...)>, int> = 0>
+    auto operator=(Functor&& functor) noexcept(
+        noexcept(std::declval<base_type&>().assign(std::forward<Functor>(functor)))) -> delegate& {
+        base_type::assign(std::forward<Functor>(functor));
+        return *this;
+    }
+
     using base_type::swap;
     using base_type::operator bool;
     using base_type::operator();
     using base_type::create;
+    using base_type::target;
+    using base_type::invoke_as;
+    using base_type::adapt;
+    using base_type::emplace;
 
     friend constexpr auto operator==(const delegate& lhs, std::nullptr_t) noexcept -> bool {
         return !lhs;
@@ -612,9 +1144,14 @@ class fwd_delegate<void(Args...), Behavior>
         "callee). Consider using 'rome::delegate' if mutable arguments are needed.");
 
     using base_type = detail::base_delegate<fwd_delegate<void(Args...), Behavior>>;
-    friend base_type;  // give base_type access to private constructor `fwd_delegate(base_type&&)`
+    // give base_type access to private constructor `fwd_delegate(base_type&&)`, and the base
+    // types of other delegates access to base_type to take over the target
+    template<typename>
+    friend class detail::base_delegate;
 
-    fwd_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    constexpr fwd_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+    constexpr fwd_delegate(typename base_type::fixed_target target) noexcept : base_type{target} {
     }
 
   public:
@@ -628,16 +1165,39 @@ class fwd_delegate<void(Args...), Behavior>
 
     // Construct directly from a function object target.
     // SFINAE to prevent hiding the constructors `delegate(delegate&&)`, `delegate(base_type&&)`,
-    // and `delegate(std::nullptr_t)`.
+    // `delegate(std::nullptr_t)` and `delegate(in_place_type_t<F>, args...)`.
     template<typename Functor,
         std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
-                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value,
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
             int> = 0>
-    fwd_delegate(Functor&& functor) noexcept(
+    constexpr fwd_delegate(Functor&& functor) noexcept(
         noexcept(base_type::create(std::forward<Functor>(functor))))
         : fwd_delegate{base_type::create(std::forward<Functor>(functor))} {
     }
 
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit fwd_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : fwd_delegate{base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    // Assign a function object target. Reuses the dynamically allocated storage of the current
+    // target if it is of the same type.
+    // SFINAE to leave the assignment of anything else to the implicit conversion and the move
+    // assignment.
+    template<typename Functor,
+        std::enable_if_t<
+            detail::delegate::is_function_object_for<std::decay_t<Functor>, void(Args...)>,
+            int> = 0>
+    auto operator=(Functor&& functor) noexcept(
+        noexcept(std::declval<base_type&>().assign(std::forward<Functor>(functor))))
+        -> fwd_delegate& {
+        base_type::assign(std::forward<Functor>(functor));
+        return *this;
+    }
+
     constexpr fwd_delegate(std::nullptr_t) noexcept : fwd_delegate{} {
     }
     constexpr auto operator=(std::nullptr_t) noexcept -> fwd_delegate& {
@@ -649,6 +1209,10 @@ class fwd_delegate<void(Args...), Behavior>
     using base_type::operator bool;
     using base_type::operator();
     using base_type::create;
+    using base_type::target;
+    using base_type::invoke_as;
+    using base_type::adapt;
+    using base_type::emplace;
 
     friend constexpr auto operator==(const fwd_delegate& lhs, std::nullptr_t) noexcept -> bool {
         return !lhs;
@@ -675,9 +1239,14 @@ class fwd_delegate<void(Args...), target_is_mandatory>
         "callee). Consider using 'rome::delegate' if mutable arguments are needed.");
 
     using base_type = detail::base_delegate<fwd_delegate<void(Args...), target_is_mandatory>>;
-    friend base_type;  // give base_type access to private constructor `fwd_delegate(base_type&&)`
+    // give base_type access to private constructor `fwd_delegate(base_type&&)`, and the base
+    // types of other delegates access to base_type to take over the target
+    template<typename>
+    friend class detail::base_delegate;
 
-    fwd_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    constexpr fwd_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+    constexpr fwd_delegate(typename base_type::fixed_target target) noexcept : base_type{target} {
     }
 
   public:
@@ -691,20 +1260,47 @@ class fwd_delegate<void(Args...), target_is_mandatory>
 
     // Construct directly from a function object target.
     // SFINAE to prevent hiding the constructors `delegate(delegate&&)`, `delegate(base_type&&)`,
-    // and `delegate(std::nullptr_t)`.
+    // `delegate(std::nullptr_t)` and `delegate(in_place_type_t<F>, args...)`.
     template<typename Functor,
         std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
-                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value,
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
             int> = 0>
-    fwd_delegate(Functor&& functor) noexcept(
+    constexpr fwd_delegate(Functor&& functor) noexcept(
         noexcept(base_type::create(std::forward<Functor>(functor))))
         : fwd_delegate{base_type::create(std::forward<Functor>(functor))} {
     }
 
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit fwd_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : fwd_delegate{base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    // Assign a function object target. Reuses the dynamically allocated storage of the current
+    // target if it is of the same type.
+    // SFINAE to leave the assignment of anything else to the implicit conversion and the move
+    // assignment.
+    template<typename Functor,
+        std::enable_if_t<
+            detail::delegate::is_function_object_for<std::decay_t<Functor>, void(Args...)>,
+            int> = 0>
+    auto operator=(Functor&& functor) noexcept(
+        noexcept(std::declval<base_type&>().assign(std::forward<Functor>(functor))))
+        -> fwd_delegate& {
+        base_type::assign(std::forward<Functor>(functor));
+        return *this;
+    }
+
     using base_type::swap;
     using base_type::operator bool;
     using base_type::operator();
     using base_type::create;
+    using base_type::target;
+    using base_type::invoke_as;
+    using base_type::adapt;
+    using base_type::emplace;
 
     friend constexpr auto operator==(const fwd_delegate& lhs, std::nullptr_t) noexcept -> bool {
         return !lhs;
@@ -0,0 +1,259 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::delegate_array<Ret(Args...)>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_DELEGATE_ARRAY_HPP
+#define ROME_DELEGATE_ARRAY_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rome {
+
+namespace detail {
+    namespace delegate_array {
+        using delegate::storage_type;
+
+        // One element of the storage column. Has the same size and alignment as the storage of a
+        // delegate, so that function objects are stored the same way.
+        struct alignas(delegate::storage_alignment) storage_cell {
+            storage_type value;
+        };
+
+        // Does not store the stateless function object constructed from `args`. It is recreated
+        // on each call.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<delegate::is_stateless<Functor>, int> = 0>
+        void construct(storage_type& /*unused*/, CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            (void)Functor(std::forward<CtorArgs>(args)...);
+        }
+
+        // Constructs the function object from `args` inside the storage.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void construct(storage_type& storage, CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            // NOLINTNEXTLINE(bugprone-multi-level-implicit-pointer-conversion)
+            (void)::new (&storage) Functor(std::forward<CtorArgs>(args)...);
+        }
+
+        // Constructs the function object from `args` in a dynamically allocated storage.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && !delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void construct(storage_type& storage, CtorArgs&&... args) {
+            storage = new Functor(std::forward<CtorArgs>(args)...);
+        }
+    }  // namespace delegate_array
+}  // namespace detail
+
+
+// Stores many targets like a `std::vector` of `rome::delegate`s, but with the invoking
+// functions, the deleting functions and the storages in separate columns. See the documentation in
+// `doc/delegate_array.md`.
+template<typename Signature>
+class delegate_array {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter "
+        "'Signature' must be a valid function signature.");
+};
+
+template<typename Ret, typename... Args>
+class delegate_array<Ret(Args...)> {
+    using storage_type = detail::delegate::storage_type;
+    using storage_cell = detail::delegate_array::storage_cell;
+    using invoker_type = Ret (*)(storage_type&, Args...);
+    using deleter_type = void (*)(storage_type&) noexcept;
+    using invoker      = detail::delegate::non_functor_invoker<Ret(Args...)>;
+
+    std::vector<invoker_type> invokers_;
+    std::vector<deleter_type> deleters_;
+    std::vector<storage_cell> storages_;
+
+    template<typename F>
+    static constexpr void assert_target_type() noexcept {
+        static_assert(std::is_class<F>::value && std::is_same<F, std::decay_t<F>>::value,
+            "Invalid target type 'F'. The type must be the decayed type of a function object "
+            "(a class type with a function call operator, e.g. a lambda).");
+        static_assert(detail::delegate::is_callable_by<F, Ret(Args...)>,
+            "Invalid target type 'F'. The function call signature of the type must be "
+            "compatible with the signature of the delegate.");
+    }
+
+    // Ensures that appending one element to all columns does not throw.
+    void reserve_one_more() {
+        if (size() == invokers_.capacity() || size() == deleters_.capacity()
+            || size() == storages_.capacity()) {
+            reserve(std::max<std::size_t>(2 * size(), 4));
+        }
+    }
+
+    template<typename Invoker, Invoker invokeTarget>
+    void append_non_functor(storage_type storage) {
+        reserve_one_more();
+        invokers_.push_back(invokeTarget);
+        deleters_.push_back(&detail::delegate::do_nothing<>);
+        storages_.push_back(storage_cell{storage});
+    }
+
+  public:
+    delegate_array() noexcept                      = default;
+    delegate_array(const delegate_array&) noexcept = delete;
+    delegate_array(delegate_array&&) noexcept      = default;
+
+    ~delegate_array() {
+        clear();
+    }
+
+    auto operator=(const delegate_array&) noexcept -> delegate_array& = delete;
+    auto operator=(delegate_array&& orig) noexcept -> delegate_array& {
+        delegate_array{std::move(orig)}.swap(*this);
+        return *this;
+    }
+
+    auto size() const noexcept -> std::size_t {
+        return invokers_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+        return invokers_.empty();
+    }
+
+    void reserve(const std::size_t capacity) {
+        invokers_.reserve(capacity);
+        deleters_.reserve(capacity);
+        storages_.reserve(capacity);
+    }
+
+    // Destroys all targets.
+    void clear() noexcept {
+        for (std::size_t i = 0; i < size(); ++i) {
+            (*deleters_[i])(storages_[i].value);
+        }
+        invokers_.clear();
+        deleters_.clear();
+        storages_.clear();
+    }
+
+    void swap(delegate_array& other) noexcept {
+        invokers_.swap(other.invokers_);
+        deleters_.swap(other.deleters_);
+        storages_.swap(other.storages_);
+    }
+
+    // Appends a function object of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    auto emplace_back(CtorArgs&&... args) -> F& {
+        assert_target_type<F>();
+        using access = detail::delegate::stored_functor<F>;
+        reserve_one_more();
+        storage_cell cell{};
+        detail::delegate_array::construct<F>(cell.value, std::forward<CtorArgs>(args)...);
+        invokers_.push_back(access::template invoker<Ret, Args...>());
+        deleters_.push_back(access::deleter());
+        storages_.push_back(cell);
+        return *access::address(storages_.back().value);
+    }
+
+    // Appends a function object.
+    template<typename T>
+    void push_back(T&& functor) {
+        (void)emplace_back<std::decay_t<T>>(std::forward<T>(functor));
+    }
+
+    // Appends a function.
+    template<Ret (*pFunction)(Args...)>
+    void push_back() {
+        using invoke_type = Ret (*)(storage_type&, Args...);
+        append_non_functor<invoke_type, &invoker::template invoke_function<pFunction>>(nullptr);
+    }
+
+    // Appends a member function of object `obj`.
+    template<typename C, Ret (C::*pMethod)(Args...)>
+    void push_back(C& obj) {
+        using invoke_type = Ret (*)(storage_type&, Args...);
+        append_non_functor<invoke_type, &invoker::template invoke_member_function<C, pMethod>>(
+            &obj);
+    }
+
+    // Appends a const member function of object `obj`.
+    template<typename C, Ret (C::*pMethod)(Args...) const>
+    void push_back(const C& obj) {
+        using invoke_type = Ret (*)(storage_type&, Args...);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        append_non_functor<invoke_type,
+            &invoker::template invoke_const_member_function<C, pMethod>>(const_cast<C*>(&obj));
+    }
+
+    // Calls the target at `index`.
+    auto invoke(const std::size_t index, Args... args) const -> Ret {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        return (*invokers_[index])(const_cast<storage_type&>(storages_[index].value),
+            static_cast<Args>(args)...);
+    }
+
+    // Calls all targets in order with the same arguments. The return values are discarded.
+    void invoke_all(Args... args) const {
+        static_assert(detail::delegate::none_of<std::is_rvalue_reference<Args>::value...>,
+            "invoke_all is not available for signatures with rvalue reference arguments, as the "
+            "arguments are passed to several targets.");
+        const auto count = size();
+        for (std::size_t i = 0; i < count; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            (void)(*invokers_[i])(const_cast<storage_type&>(storages_[i].value), args...);
+        }
+    }
+
+    // Reorders the targets, so that all targets with the same invoking function follow each
+    // other. This makes the indirect calls of `invoke_all` predictable. Keeps the relative order
+    // of the targets with the same invoking function. Leaves the array unchanged if the
+    // reordering throws.
+    void sort_by_target() {
+        std::vector<std::size_t> order(size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t lhs, std::size_t rhs) {
+            return std::less<invoker_type>{}(invokers_[lhs], invokers_[rhs]);
+        });
+
+        std::vector<invoker_type> invokers;
+        std::vector<deleter_type> deleters;
+        std::vector<storage_cell> storages;
+        invokers.reserve(size());
+        deleters.reserve(size());
+        storages.reserve(size());
+        for (const auto index : order) {
+            invokers.push_back(invokers_[index]);
+            deleters.push_back(deleters_[index]);
+            storages.push_back(storages_[index]);
+        }
+        invokers_.swap(invokers);
+        deleters_.swap(deleters);
+        storages_.swap(storages);
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_DELEGATE_ARRAY_HPP
@@ -0,0 +1,229 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::delegate_bundle<Signatures...>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_DELEGATE_BUNDLE_HPP
+#define ROME_DELEGATE_BUNDLE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace rome {
+
+template<typename... Signatures>
+class delegate_bundle;
+
+namespace detail {
+    namespace delegate_bundle {
+        // Whether `T` is a valid function signature, optionally const qualified.
+        template<typename T>
+        struct is_signature : std::false_type {};
+
+        template<typename Ret, typename... Args>
+        struct is_signature<Ret(Args...)> : std::true_type {};
+
+        template<typename Ret, typename... Args>
+        struct is_signature<Ret(Args...) const> : std::true_type {};
+
+        // The functions stored in the table of a delegate bundle for one signature.
+        template<typename Signature>
+        struct entry;
+
+        template<typename Ret, typename... Args>
+        struct entry<Ret(Args...)> {
+            using type = Ret (*)(void*, Args...);
+            // The signature without const qualification.
+            using signature = Ret(Args...);
+
+            static constexpr bool isConst = false;
+
+            template<typename C>
+            using method_type = Ret (C::*)(Args...);
+
+            template<typename C, Ret (C::*pMethod)(Args...)>
+            static auto invoke_member_function(void* object, Args... args) -> Ret {
+                return (static_cast<C*>(object)->*pMethod)(static_cast<Args>(args)...);
+            }
+
+            [[noreturn]] static auto throw_on_call(void* /*unused*/, Args... /*unused*/) -> Ret {
+                delegate::throw_bad_delegate_call();
+            }
+        };
+
+        // A const qualified signature is called by a const member function.
+        template<typename Ret, typename... Args>
+        struct entry<Ret(Args...) const> : entry<Ret(Args...)> {
+            static constexpr bool isConst = true;
+
+            template<typename C>
+            using method_type = Ret (C::*)(Args...) const;
+
+            template<typename C, Ret (C::*pMethod)(Args...) const>
+            static auto invoke_member_function(void* object, Args... args) -> Ret {
+                return (static_cast<const C*>(object)->*pMethod)(static_cast<Args>(args)...);
+            }
+        };
+
+        // Whether all `Signatures...` are const qualified.
+        template<typename... Signatures>
+        constexpr bool are_const = delegate::all_of<entry<Signatures>::isConst...>;
+
+        template<typename... Signatures>
+        using table = std::tuple<typename entry<Signatures>::type...>;
+
+        // Returns the table of an empty delegate bundle.
+        template<typename... Signatures>
+        auto empty_table() noexcept -> const table<Signatures...>* {
+            static constexpr table<Signatures...> value{&entry<Signatures>::throw_on_call...};
+            return &value;
+        }
+
+        // A callable view on one signature of a delegate bundle.
+        template<typename Signature>
+        class element;
+
+        template<typename Ret, typename... Args>
+        class element<Ret(Args...)> {
+            void* object_;
+            Ret (*invokeTarget_)(void*, Args...);
+
+            template<typename...>
+            friend class rome::delegate_bundle;
+
+            constexpr element(void* object, Ret (*invokeTarget)(void*, Args...)) noexcept
+                : object_{object}, invokeTarget_{invokeTarget} {
+            }
+
+          public:
+            auto operator()(Args... args) const -> Ret {
+                return (*invokeTarget_)(object_, static_cast<Args>(args)...);
+            }
+        };
+
+        // Creates delegate bundles calling member functions of class `C`. The member functions
+        // are passed to a nested class template, as a function template with a parameter pack
+        // whose types depend on `Signatures...` is not accepted by all compilers.
+        template<typename Bundle, typename C, typename... Signatures>
+        struct binder {
+            template<typename entry<Signatures>::template method_type<C>... pMethods>
+            struct methods {
+                // Creates a delegate bundle calling the member functions `pMethods...` of `obj`.
+                static auto create(C& obj) noexcept -> Bundle {
+                    return Bundle{&obj, table_of_methods()};
+                }
+
+                // Creates a delegate bundle calling the member functions `pMethods...` of the
+                // const object `obj`. Only available if all `Signatures...` are const qualified,
+                // so that only const member functions are called.
+                template<typename T = C,
+                    std::enable_if_t<std::is_same<T, C>::value && are_const<Signatures...>,
+                        int> = 0>
+                static auto create(const T& obj) noexcept -> Bundle {
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+                    return Bundle{const_cast<T*>(&obj), table_of_methods()};
+                }
+
+              private:
+                // There is one table per class and combination of member functions.
+                static auto table_of_methods() noexcept -> const table<Signatures...>* {
+                    static constexpr table<Signatures...> value{
+                        &entry<Signatures>::template invoke_member_function<C, pMethods>...};
+                    return &value;
+                }
+            };
+        };
+    }  // namespace delegate_bundle
+}  // namespace detail
+
+
+// Calls several member functions of one object, one per signature. Stores only the address of the
+// object and the address of a static table holding one function per signature. See the
+// documentation in `doc/delegate_bundle.md`.
+template<typename... Signatures>
+class delegate_bundle {
+    static_assert(sizeof...(Signatures) > 0,
+        "Invalid parameter 'Signatures'. At least one signature is required.");
+    static_assert(
+        detail::delegate::all_of<detail::delegate_bundle::is_signature<Signatures>::value...>,
+        "Invalid parameter 'Signatures'. All template parameters 'Signatures' must be valid "
+        "function signatures.");
+
+    using table_type = detail::delegate_bundle::table<Signatures...>;
+
+    void* object_            = nullptr;
+    const table_type* table_ = detail::delegate_bundle::empty_table<Signatures...>();
+
+    template<typename, typename, typename...>
+    friend struct detail::delegate_bundle::binder;
+
+    delegate_bundle(void* object, const table_type* table) noexcept
+        : object_{object}, table_{table} {
+    }
+
+  public:
+    // The signature at `index`.
+    template<std::size_t index>
+    using signature = std::tuple_element_t<index, std::tuple<Signatures...>>;
+
+    // The callable type returned by `get<index>()`.
+    template<std::size_t index>
+    using element_type = detail::delegate_bundle::element<
+        typename detail::delegate_bundle::entry<signature<index>>::signature>;
+
+    delegate_bundle() noexcept = default;
+
+    delegate_bundle(std::nullptr_t) noexcept : delegate_bundle{} {
+    }
+    auto operator=(std::nullptr_t) noexcept -> delegate_bundle& {
+        *this = delegate_bundle{};
+        return *this;
+    }
+
+    explicit operator bool() const noexcept {
+        return object_ != nullptr;
+    }
+
+    // Provides `of<C>::methods<pMethods...>::create(obj)`, which creates a delegate bundle
+    // calling the member functions `pMethods...` of `obj`, one member function for each of
+    // `Signatures...` in the same order.
+    template<typename C>
+    using of = detail::delegate_bundle::binder<delegate_bundle, C, Signatures...>;
+
+    // Returns a callable that calls the member function for the signature at `index`. The
+    // callable refers to the object, not to the bundle. Calling it throws
+    // `rome::bad_delegate_call` if the bundle is empty.
+    template<std::size_t index>
+    auto get() const noexcept -> element_type<index> {
+        return {object_, std::get<index>(*table_)};
+    }
+
+    friend auto operator==(const delegate_bundle& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend auto operator==(std::nullptr_t, const delegate_bundle& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend auto operator!=(const delegate_bundle& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend auto operator!=(std::nullptr_t, const delegate_bundle& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_DELEGATE_BUNDLE_HPP
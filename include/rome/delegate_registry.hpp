@@ -0,0 +1,259 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::delegate_registry<void(Args...)>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_DELEGATE_REGISTRY_HPP
+#define ROME_DELEGATE_REGISTRY_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rome {
+
+// Stores event delegates in a slot map: the event delegates are kept densely in one array for the
+// calls, each one is identified by a handle containing the index of its slot and the generation of
+// the slot. The generation is incremented when an event delegate is disconnected, thus handles to
+// disconnected event delegates are detected. See the documentation in `doc/delegate_registry.md`.
+template<typename Signature>
+class delegate_registry {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with return type 'void'.");
+};
+
+template<typename... Args>
+class delegate_registry<void(Args...)> {
+  public:
+    using delegate_type = event_delegate<void(Args...)>;
+
+    // Identifies a connected event delegate. Is trivially copyable and stays safe to use after the
+    // event delegate is disconnected.
+    class connection {
+        std::uint32_t index_      = invalidIndex;
+        std::uint32_t generation_ = 0U;
+
+        friend class delegate_registry;
+
+        constexpr connection(const std::uint32_t index, const std::uint32_t generation) noexcept
+            : index_{index}, generation_{generation} {
+        }
+
+      public:
+        constexpr connection() noexcept = default;
+
+        friend constexpr auto operator==(const connection& lhs, const connection& rhs) noexcept
+            -> bool {
+            return lhs.index_ == rhs.index_ && lhs.generation_ == rhs.generation_;
+        }
+        friend constexpr auto operator!=(const connection& lhs, const connection& rhs) noexcept
+            -> bool {
+            return !(lhs == rhs);
+        }
+    };
+
+    // Disconnects its event delegate when it is destroyed. Can be moved but not copied. The
+    // registry must outlive it.
+    class scoped_connection {
+        delegate_registry* registry_ = nullptr;
+        connection connection_;
+
+      public:
+        constexpr scoped_connection() noexcept = default;
+        scoped_connection(delegate_registry& registry, const connection conn) noexcept
+            : registry_{&registry}, connection_{conn} {
+        }
+        scoped_connection(const scoped_connection&) = delete;
+        scoped_connection(scoped_connection&& orig) noexcept
+            : registry_{orig.registry_}, connection_{orig.release()} {
+        }
+
+        ~scoped_connection() {
+            disconnect();
+        }
+
+        auto operator=(const scoped_connection&) -> scoped_connection& = delete;
+        auto operator=(scoped_connection&& orig) noexcept -> scoped_connection& {
+            scoped_connection{std::move(orig)}.swap(*this);
+            return *this;
+        }
+
+        void swap(scoped_connection& other) noexcept {
+            using std::swap;
+            swap(registry_, other.registry_);
+            swap(connection_, other.connection_);
+        }
+
+        auto get() const noexcept -> connection {
+            return connection_;
+        }
+
+        // Returns whether the event delegate is still connected.
+        auto connected() const noexcept -> bool {
+            return registry_ != nullptr && registry_->contains(connection_);
+        }
+
+        // Returns the connection without disconnecting it.
+        auto release() noexcept -> connection {
+            const auto conn = connection_;
+            registry_       = nullptr;
+            connection_     = connection{};
+            return conn;
+        }
+
+        void disconnect() noexcept {
+            if (registry_ != nullptr) {
+                (void)registry_->disconnect(release());
+            }
+        }
+    };
+
+  private:
+    static constexpr std::uint32_t invalidIndex = ~std::uint32_t{0};
+
+    // A slot refers either to its event delegate in the dense array or to the next free slot.
+    struct slot {
+        std::uint32_t index;
+        std::uint32_t generation;
+    };
+
+    std::vector<delegate_type> delegates_;
+    std::vector<std::uint32_t> slotIndices_;  // the slot of each event delegate
+    std::vector<slot> slots_;
+    std::uint32_t firstFree_ = invalidIndex;
+
+    // Ensures that connecting one more event delegate does not throw, except for the creation of
+    // the event delegate itself.
+    void reserve_one_more() {
+        const auto count = size();
+        if (count == delegates_.capacity() || count == slotIndices_.capacity()
+            || (firstFree_ == invalidIndex && slots_.size() == slots_.capacity())) {
+            reserve(std::max<std::size_t>(2 * count, 4));
+        }
+    }
+
+  public:
+    delegate_registry() noexcept                         = default;
+    delegate_registry(const delegate_registry&) noexcept = delete;
+    delegate_registry(delegate_registry&&) noexcept      = default;
+    ~delegate_registry()                                 = default;
+
+    auto operator=(const delegate_registry&) noexcept -> delegate_registry& = delete;
+    auto operator=(delegate_registry&&) noexcept -> delegate_registry&      = default;
+
+    // Returns the number of connected event delegates.
+    auto size() const noexcept -> std::size_t {
+        return delegates_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+        return delegates_.empty();
+    }
+
+    // Reserves memory for `capacity` event delegates, so that connecting them does not allocate.
+    void reserve(const std::size_t capacity) {
+        delegates_.reserve(capacity);
+        slotIndices_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    // Connects the event delegate created from `target`, e.g. a function object or a
+    // `rome::event_delegate`, and returns its connection. Leaves the registry unchanged if the
+    // creation throws.
+    template<typename T>
+    auto connect(T&& target) -> connection {
+        reserve_one_more();
+        delegates_.emplace_back(std::forward<T>(target));
+
+        const auto denseIndex = static_cast<std::uint32_t>(slotIndices_.size());
+        auto slotIndex        = firstFree_;
+        if (slotIndex == invalidIndex) {
+            slotIndex = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(slot{invalidIndex, 0U});
+        }
+        auto& entry = slots_[slotIndex];
+        firstFree_  = slotIndex == firstFree_ ? entry.index : firstFree_;
+        entry.index = denseIndex;
+        slotIndices_.push_back(slotIndex);
+        return {slotIndex, entry.generation};
+    }
+
+    // Returns whether the event delegate of `conn` is connected.
+    auto contains(const connection conn) const noexcept -> bool {
+        return conn.index_ < slots_.size() && slots_[conn.index_].generation == conn.generation_;
+    }
+
+    // Returns the event delegate of `conn`, or nullptr if it is not connected.
+    auto find(const connection conn) noexcept -> delegate_type* {
+        return contains(conn) ? &delegates_[slots_[conn.index_].index] : nullptr;
+    }
+
+    auto find(const connection conn) const noexcept -> const delegate_type* {
+        return contains(conn) ? &delegates_[slots_[conn.index_].index] : nullptr;
+    }
+
+    // Disconnects the event delegate of `conn`. The last event delegate is moved into its place.
+    // Returns false if it was not connected.
+    auto disconnect(const connection conn) noexcept -> bool {
+        if (!contains(conn)) {
+            return false;
+        }
+        auto& entry           = slots_[conn.index_];
+        const auto denseIndex = entry.index;
+        const auto lastIndex  = static_cast<std::uint32_t>(delegates_.size() - 1);
+        if (denseIndex != lastIndex) {
+            delegates_[denseIndex]                 = std::move(delegates_[lastIndex]);
+            slotIndices_[denseIndex]               = slotIndices_[lastIndex];
+            slots_[slotIndices_[denseIndex]].index = denseIndex;
+        }
+        delegates_.pop_back();
+        slotIndices_.pop_back();
+
+        ++entry.generation;
+        entry.index = firstFree_;
+        firstFree_  = conn.index_;
+        return true;
+    }
+
+    // Connects the event delegate created from `target` and returns a scoped connection, which
+    // disconnects it when destroyed.
+    template<typename T>
+    auto connect_scoped(T&& target) -> scoped_connection {
+        return {*this, connect(std::forward<T>(target))};
+    }
+
+    // Disconnects all event delegates. Existing connections become invalid.
+    void clear() noexcept {
+        while (!slotIndices_.empty()) {
+            const auto slotIndex = slotIndices_.back();
+            (void)disconnect(connection{slotIndex, slots_[slotIndex].generation});
+        }
+    }
+
+    // Calls all connected event delegates. The order is unspecified. Event delegates shall not be
+    // connected or disconnected during the call.
+    void operator()(Args... args) const {
+        for (const auto& dgt : delegates_) {
+            dgt(args...);
+        }
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_DELEGATE_REGISTRY_HPP
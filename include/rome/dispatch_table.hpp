@@ -0,0 +1,384 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::basic_dispatch_table<Key, Ret(Args...), Behavior, keys...>
+//   - rome::dispatch_table<Key, Ret(Args...), keys...>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_DISPATCH_TABLE_HPP
+#define ROME_DISPATCH_TABLE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace rome {
+
+namespace detail {
+    namespace dispatch_table {
+        template<typename Key, bool isEnum = std::is_enum<Key>::value>
+        struct underlying {
+            using type = Key;
+        };
+
+        template<typename Key>
+        struct underlying<Key, true> {
+            using type = std::underlying_type_t<Key>;
+        };
+
+        // Whether `Key` can be used as key of a dispatch table.
+        template<typename Key>
+        constexpr bool is_key = std::is_integral<typename underlying<Key>::type>::value
+                                && !std::is_same<typename underlying<Key>::type, bool>::value;
+
+        // Converts a key to the unsigned value that is hashed. Negative keys wrap around.
+        template<typename Key>
+        constexpr auto to_unsigned(const Key key) noexcept -> std::uint64_t {
+            return static_cast<std::uint64_t>(static_cast<typename underlying<Key>::type>(key));
+        }
+
+        // A perfect hash function in two levels, which maps each key to a distinct slot. The key is
+        // multiplied and shifted. The lower `slotBits` of the result select the preliminary slot,
+        // the next `bucketBits` select a bucket. The preliminary slot is combined with the
+        // displacement of the bucket, which is chosen so that all keys get distinct slots.
+        struct hash_function {
+            std::uint64_t multiplier;
+            unsigned shift;
+            unsigned slotBits;
+            unsigned bucketBits;
+
+            constexpr auto hash(const std::uint64_t key) const noexcept -> std::uint64_t {
+                return (key * multiplier) >> shift;
+            }
+
+            constexpr auto slot(const std::uint64_t hashValue) const noexcept -> std::size_t {
+                return static_cast<std::size_t>(hashValue & ((std::uint64_t{1} << slotBits) - 1U));
+            }
+
+            constexpr auto bucket(const std::uint64_t hashValue) const noexcept -> std::size_t {
+                return static_cast<std::size_t>(
+                    (hashValue >> slotBits) & ((std::uint64_t{1} << bucketBits) - 1U));
+            }
+        };
+
+        constexpr auto bit_width(const std::size_t value) noexcept -> unsigned {
+            unsigned width = 0U;
+            while ((std::size_t{1} << width) < value) {
+                ++width;
+            }
+            return width;
+        }
+
+        // Whether all keys are distinct.
+        template<std::size_t count>
+        constexpr auto are_unique(const std::uint64_t (&keys)[count]) noexcept -> bool {
+            for (std::size_t i = 0; i < count; ++i) {
+                for (std::size_t j = i + 1; j < count; ++j) {
+                    if (keys[i] == keys[j]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // The number of slots is a power of two of at least the number of keys and at most twice
+        // as much. There are half as many buckets as slots.
+        template<std::size_t count>
+        constexpr unsigned max_slot_bits = bit_width(count) + 1U;
+
+        template<std::size_t count>
+        constexpr std::size_t max_slots = std::size_t{1} << max_slot_bits<count>;
+
+        constexpr auto bucket_bits(const unsigned slotBits) noexcept -> unsigned {
+            return slotBits > 0U ? slotBits - 1U : 0U;
+        }
+
+        // Chooses the displacement of each bucket with `hash`. Places the buckets with the most
+        // keys first. Returns false if a bucket cannot be placed.
+        template<std::size_t count>
+        constexpr auto displace(const hash_function& hash, const std::uint64_t (&keys)[count],
+            std::uint32_t (&displacements)[max_slots<count>]) noexcept -> bool {
+            const auto slots   = std::size_t{1} << hash.slotBits;
+            const auto buckets = std::size_t{1} << hash.bucketBits;
+
+            // group the keys by bucket
+            std::size_t starts[max_slots<count> + 1] = {};
+            for (const auto key : keys) {
+                ++starts[hash.bucket(hash.hash(key)) + 1];
+            }
+            std::size_t largest = 0;
+            for (std::size_t b = 0; b < buckets; ++b) {
+                largest = starts[b + 1] > largest ? starts[b + 1] : largest;
+                starts[b + 1] += starts[b];
+            }
+            std::size_t ends[max_slots<count>] = {};
+            std::size_t grouped[count]          = {};
+            for (std::size_t b = 0; b < buckets; ++b) {
+                ends[b] = starts[b];
+            }
+            for (const auto key : keys) {
+                const auto h                    = hash.hash(key);
+                grouped[ends[hash.bucket(h)]++] = hash.slot(h);
+            }
+
+            // keys of the same bucket need distinct preliminary slots
+            for (std::size_t b = 0; b < buckets; ++b) {
+                for (auto i = starts[b]; i < starts[b + 1]; ++i) {
+                    for (auto j = i + 1; j < starts[b + 1]; ++j) {
+                        if (grouped[i] == grouped[j]) {
+                            return false;
+                        }
+                    }
+                }
+            }
+
+            bool used[max_slots<count>] = {};
+            for (auto size = largest; size > 0; --size) {
+                for (std::size_t b = 0; b < buckets; ++b) {
+                    if (starts[b + 1] - starts[b] != size) {
+                        continue;
+                    }
+                    std::size_t d = 0;
+                    for (; d < slots; ++d) {
+                        auto i = starts[b];
+                        while (i < starts[b + 1] && !used[grouped[i] ^ d]) {
+                            ++i;
+                        }
+                        if (i == starts[b + 1]) {
+                            break;
+                        }
+                    }
+                    if (d == slots) {
+                        return false;
+                    }
+                    for (auto i = starts[b]; i < starts[b + 1]; ++i) {
+                        used[grouped[i] ^ d] = true;
+                    }
+                    displacements[b] = static_cast<std::uint32_t>(d);
+                }
+            }
+            return true;
+        }
+
+        // Searches a perfect hash function for `keys` with the least slots. The multiplier 1 is
+        // tried first, it maps dense keys, e.g. the enumerators of an enumeration, directly to the
+        // slots. Returns a hash function with multiplier 0 if none is found.
+        template<std::size_t count>
+        constexpr auto find_hash_function(const std::uint64_t (&keys)[count]) noexcept
+            -> hash_function {
+            constexpr std::uint64_t multipliers[] = {1U, 0x9E3779B97F4A7C15U, 0xBF58476D1CE4E5B9U,
+                0x94D049BB133111EBU, 0xD6E8FEB86659FD93U, 0xFF51AFD7ED558CCDU, 0xC4CEB9FE1A85EC53U};
+            for (auto slotBits = bit_width(count); slotBits <= max_slot_bits<count>; ++slotBits) {
+                const auto bucketBits = bucket_bits(slotBits);
+                for (const auto multiplier : multipliers) {
+                    // the multiplier 1 uses the lower bits, the others the upper bits of the key
+                    for (unsigned i = 0U; i + slotBits + bucketBits <= 64U; ++i) {
+                        const auto shift = multiplier == 1U ? i : 64U - slotBits - bucketBits - i;
+                        const hash_function hash{multiplier, shift, slotBits, bucketBits};
+                        std::uint32_t displacements[max_slots<count>] = {};
+                        if (displace(hash, keys, displacements)) {
+                            return hash;
+                        }
+                    }
+                }
+            }
+            return {0U, 0U, 0U, 0U};
+        }
+
+        // One slot of the lookup table, refers to the handler of `key`. Unused slots refer to the
+        // fallback handler.
+        struct slot {
+            std::uint64_t key;
+            std::size_t index;
+        };
+
+        template<std::size_t slotCount, std::size_t bucketCount>
+        struct lookup_table {
+            hash_function hash;
+            std::uint32_t displacements[bucketCount];
+            slot slots[slotCount];
+
+            // Returns the slot `key` is mapped to.
+            constexpr auto slot_of(const std::uint64_t key) const noexcept -> std::size_t {
+                const auto h = hash.hash(key);
+                return hash.slot(h) ^ displacements[hash.bucket(h)];
+            }
+        };
+
+        template<std::size_t slotCount, std::size_t bucketCount, std::size_t count>
+        constexpr auto make_lookup_table(
+            const hash_function hash, const std::uint64_t (&keys)[count]) noexcept
+            -> lookup_table<slotCount, bucketCount> {
+            lookup_table<slotCount, bucketCount> table{hash, {}, {}};
+            std::uint32_t displacements[max_slots<count>] = {};
+            (void)displace(hash, keys, displacements);
+            for (std::size_t b = 0; b < bucketCount; ++b) {
+                table.displacements[b] = displacements[b];
+            }
+            for (auto& entry : table.slots) {
+                entry = slot{0U, count};
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                table.slots[table.slot_of(keys[i])] = slot{keys[i], i};
+            }
+            return table;
+        }
+
+        // Returns the index of `key` within `keys`, or `count` if it is not contained.
+        template<std::size_t count>
+        constexpr auto index_of(
+            const std::uint64_t key, const std::uint64_t (&keys)[count]) noexcept -> std::size_t {
+            std::size_t i = 0;
+            while (i < count && keys[i] != key) {
+                ++i;
+            }
+            return i;
+        }
+
+        // The keys of a dispatch table and its lookup table, both computed at compile time.
+        template<typename Key, Key... keys>
+        struct key_set {
+            static constexpr std::size_t count = sizeof...(keys);
+
+            static constexpr std::uint64_t values[count] = {to_unsigned(keys)...};
+            static constexpr bool unique                  = are_unique(values);
+            static constexpr hash_function hash           = find_hash_function(values);
+            static constexpr std::size_t slot_count       = std::size_t{1} << hash.slotBits;
+            static constexpr std::size_t bucket_count     = std::size_t{1} << hash.bucketBits;
+
+            // Returns the index of the handler for `key`, or `count` for unknown keys.
+            static auto find(const Key key) noexcept -> std::size_t {
+                static constexpr lookup_table<slot_count, bucket_count> table =
+                    make_lookup_table<slot_count, bucket_count>(hash, values);
+                const auto value  = to_unsigned(key);
+                const auto& entry = table.slots[table.slot_of(value)];
+                return entry.key == value ? entry.index : count;
+            }
+        };
+
+        template<typename Key, Key... keys>
+        constexpr std::uint64_t key_set<Key, keys...>::values[];
+
+        template<typename Key, Key... keys>
+        constexpr hash_function key_set<Key, keys...>::hash;
+    }  // namespace dispatch_table
+}  // namespace detail
+
+
+// Calls one of several delegates selected by a key, e.g. the ID of a message. The keys are given
+// at compile time, they are mapped by a perfect hash function to a constant lookup table, so that a
+// call needs one lookup and no search. Calls with unknown keys go to a fallback delegate. See the
+// documentation in `doc/dispatch_table.md`.
+template<typename Key, typename Signature, typename Behavior, Key... keys>
+class basic_dispatch_table {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter "
+        "'Signature' must be a valid function signature.");
+};
+
+template<typename Key, typename Ret, typename... Args, typename Behavior, Key... keys>
+class basic_dispatch_table<Key, Ret(Args...), Behavior, keys...> {
+    static_assert(detail::dispatch_table::is_key<Key>,
+        "Invalid parameter 'Key'. The template parameter 'Key' must be an integral type other than "
+        "'bool' or an enumeration type.");
+    static_assert(sizeof...(keys) > 0, "Invalid parameter 'keys'. At least one key is required.");
+    static_assert(detail::delegate::is_behavior<Behavior>
+                      && !std::is_same<Behavior, target_is_mandatory>::value,
+        "Invalid parameter 'Behavior'. The template parameter 'Behavior' must either be "
+        "'rome::target_is_optional' or 'rome::target_is_expected'.");
+    static_assert(detail::delegate::is_valid_behavior<Ret, Behavior>,
+        "Return type coflicts with parameter 'Behavior'. The parameter 'Behavior' is only "
+        "allowed to be 'rome::target_is_optional' if the return type is 'void'.");
+
+    using key_set = detail::dispatch_table::key_set<Key, keys...>;
+    static_assert(key_set::unique, "Invalid parameter 'keys'. The keys must be distinct.");
+    static_assert(key_set::hash.multiplier != 0U,
+        "No perfect hash function found for parameter 'keys'. Consider using a dense range of "
+        "keys.");
+
+  public:
+    using key_type      = Key;
+    using delegate_type = rome::delegate<Ret(Args...), Behavior>;
+
+  private:
+    // The handlers in the order of `keys...`, followed by the fallback handler.
+    std::array<delegate_type, key_set::count + 1> handlers_ = {};
+
+  public:
+    basic_dispatch_table() noexcept = default;
+
+    // Returns the number of keys.
+    static constexpr auto size() noexcept -> std::size_t {
+        return key_set::count;
+    }
+
+    static auto contains(const Key key) noexcept -> bool {
+        return key_set::find(key) != key_set::count;
+    }
+
+    // Returns the handler of `key`.
+    template<Key key>
+    auto get() noexcept -> delegate_type& {
+        constexpr auto index =
+            detail::dispatch_table::index_of(detail::dispatch_table::to_unsigned(key),
+                key_set::values);
+        static_assert(index != key_set::count, "Invalid parameter 'key'. The key is unknown.");
+        return handlers_[index];
+    }
+
+    template<Key key>
+    auto get() const noexcept -> const delegate_type& {
+        constexpr auto index =
+            detail::dispatch_table::index_of(detail::dispatch_table::to_unsigned(key),
+                key_set::values);
+        static_assert(index != key_set::count, "Invalid parameter 'key'. The key is unknown.");
+        return handlers_[index];
+    }
+
+    // Returns the handler of `key`, or nullptr if the key is unknown.
+    auto find(const Key key) noexcept -> delegate_type* {
+        const auto index = key_set::find(key);
+        return index != key_set::count ? &handlers_[index] : nullptr;
+    }
+
+    auto find(const Key key) const noexcept -> const delegate_type* {
+        const auto index = key_set::find(key);
+        return index != key_set::count ? &handlers_[index] : nullptr;
+    }
+
+    // Returns the handler called for unknown keys.
+    auto fallback() noexcept -> delegate_type& {
+        return handlers_[key_set::count];
+    }
+
+    auto fallback() const noexcept -> const delegate_type& {
+        return handlers_[key_set::count];
+    }
+
+    // Calls the handler of `key` or the fallback handler if the key is unknown. Empty handlers
+    // behave according to `Behavior`.
+    auto operator()(const Key key, Args... args) const -> Ret {
+        return handlers_[key_set::find(key)](static_cast<Args>(args)...);
+    }
+};
+
+// A `rome::basic_dispatch_table` with `Behavior` set to `rome::target_is_expected`. Calling an
+// empty handler or an unknown key without fallback throws `rome::bad_delegate_call`.
+template<typename Key, typename Signature, Key... keys>
+using dispatch_table = basic_dispatch_table<Key, Signature, target_is_expected, keys...>;
+
+}  // namespace rome
+
+#endif  // ROME_DISPATCH_TABLE_HPP
@@ -0,0 +1,275 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::event_bus<capacity, Topics...>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_EVENT_BUS_HPP
+#define ROME_EVENT_BUS_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+template<std::size_t capacity, typename... Topics>
+class event_bus;
+
+namespace detail {
+    namespace event_bus {
+        // The index of `Topic` within `Topics...`, or the number of topics if it is not contained.
+        template<typename Topic, typename... Topics>
+        struct index_of;
+
+        template<typename Topic>
+        struct index_of<Topic> : std::integral_constant<std::size_t, 0> {};
+
+        template<typename Topic, typename... Topics>
+        struct index_of<Topic, Topic, Topics...> : std::integral_constant<std::size_t, 0> {};
+
+        template<typename Topic, typename First, typename... Topics>
+        struct index_of<Topic, First, Topics...>
+            : std::integral_constant<std::size_t, 1 + index_of<Topic, Topics...>::value> {};
+
+        // Whether all `Topics...` are distinct.
+        template<typename... Topics>
+        struct are_distinct : std::true_type {};
+
+        template<typename First, typename... Topics>
+        struct are_distinct<First, Topics...>
+            : std::integral_constant<bool, index_of<First, Topics...>::value == sizeof...(Topics)
+                                               && are_distinct<Topics...>::value> {};
+
+        // Whether `Topic` is a valid topic type, i.e. a class type without cv-qualifiers.
+        template<typename Topic>
+        constexpr bool is_topic = std::is_class<Topic>::value
+                                  && std::is_same<Topic, std::remove_cv_t<Topic>>::value;
+
+        // The subscribers of one topic. Publishing calls the first `used` slots. Unsubscribed
+        // slots below them keep an empty event delegate, which does nothing when called, and are
+        // reused by later subscriptions.
+        template<typename Topic, std::size_t capacity>
+        struct topic_slots {
+            std::array<event_delegate<void(const Topic&)>, capacity> slots;
+            std::array<std::uint32_t, capacity> freeIndices = {};
+            std::uint32_t used                              = 0U;
+            std::uint32_t freeCount                         = 0U;
+
+            // Removes `index` from the free indices. Returns false if it is not free.
+            auto take_free(const std::uint32_t index) noexcept -> bool {
+                for (std::uint32_t i = 0U; i < freeCount; ++i) {
+                    if (freeIndices[i] == index) {
+                        freeIndices[i] = freeIndices[--freeCount];
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Drops the event delegate at `index` and frees its slot. If it is the last slot in
+            // use, the slots called by publishing end before it and before the free slots
+            // preceding it, so that churn does not leave publishing calling empty slots. Used by
+            // the subscriptions, which do not know the capacity of the topic.
+            static void unsubscribe(void* topic, const std::uint32_t index) noexcept {
+                auto& self        = *static_cast<topic_slots*>(topic);
+                self.slots[index] = nullptr;
+                if (index + 1U != self.used) {
+                    self.freeIndices[self.freeCount++] = index;
+                    return;
+                }
+                --self.used;
+                while (self.used > 0U && self.take_free(self.used - 1U)) {
+                    --self.used;
+                }
+            }
+        };
+    }  // namespace event_bus
+}  // namespace detail
+
+
+// Identifies the subscription of an event delegate to a topic of a `rome::event_bus`. Unsubscribes
+// the event delegate when destroyed or assigned, unless it was released. Can be moved but not
+// copied, so that a subscription is unsubscribed at most once. Must not outlive its bus.
+template<typename Topic>
+class subscription {
+    static constexpr std::uint32_t invalidIndex = ~std::uint32_t{0};
+
+    void* topic_                               = nullptr;
+    void (*unsubscribe_)(void*, std::uint32_t) = nullptr;
+    std::uint32_t index_                       = invalidIndex;
+
+    template<std::size_t, typename...>
+    friend class event_bus;
+
+    subscription(
+        void* topic, void (*unsubscribe)(void*, std::uint32_t), const std::uint32_t index) noexcept
+        : topic_{topic}, unsubscribe_{unsubscribe}, index_{index} {
+    }
+
+  public:
+    constexpr subscription() noexcept = default;
+    subscription(const subscription&) = delete;
+    subscription(subscription&& orig) noexcept
+        : topic_{orig.topic_}, unsubscribe_{orig.unsubscribe_}, index_{orig.index_} {
+        orig.release();
+    }
+
+    ~subscription() {
+        unsubscribe();
+    }
+
+    auto operator=(const subscription&) -> subscription& = delete;
+    auto operator=(subscription&& orig) noexcept -> subscription& {
+        subscription{std::move(orig)}.swap(*this);
+        return *this;
+    }
+
+    void swap(subscription& other) noexcept {
+        using std::swap;
+        swap(topic_, other.topic_);
+        swap(unsubscribe_, other.unsubscribe_);
+        swap(index_, other.index_);
+    }
+
+    // Returns whether the subscription refers to a subscribed event delegate.
+    constexpr explicit operator bool() const noexcept {
+        return index_ != invalidIndex;
+    }
+
+    // Drops the event delegate and leaves the subscription invalid. Does nothing if the
+    // subscription is invalid.
+    void unsubscribe() noexcept {
+        if (*this) {
+            (*unsubscribe_)(topic_, index_);
+            release();
+        }
+    }
+
+    // Leaves the subscription invalid without unsubscribing, so that the event delegate stays
+    // subscribed for the lifetime of the bus.
+    void release() noexcept {
+        topic_       = nullptr;
+        unsubscribe_ = nullptr;
+        index_       = invalidIndex;
+    }
+};
+
+
+// Publishes messages to the event delegates subscribed to the type of the message. Each of the
+// `Topics...` has a fixed number of slots stored within the bus, thus neither publishing nor
+// subscribing allocates, except for the storage of big function objects. See the documentation in
+// `doc/event_bus.md`.
+template<std::size_t capacity, typename... Topics>
+class event_bus {
+    static_assert(capacity > 0 && capacity < ~std::uint32_t{0},
+        "Invalid parameter 'capacity'. The capacity must be positive and less than 2^32 - 1.");
+    static_assert(detail::delegate::all_of<detail::event_bus::is_topic<Topics>...>,
+        "Invalid parameter 'Topics'. All template parameters 'Topics' must be class types "
+        "without cv-qualifiers.");
+    static_assert(detail::event_bus::are_distinct<Topics...>::value,
+        "Invalid parameter 'Topics'. The template parameters 'Topics' must be distinct.");
+
+    std::tuple<detail::event_bus::topic_slots<Topics, capacity>...> topics_;
+
+    template<typename Topic>
+    static constexpr void assert_topic() noexcept {
+        static_assert(
+            detail::event_bus::index_of<Topic, Topics...>::value < sizeof...(Topics),
+            "Invalid topic 'Topic'. The type must be one of the template parameters 'Topics'.");
+    }
+
+    template<typename Topic>
+    auto slots_of() noexcept -> detail::event_bus::topic_slots<Topic, capacity>& {
+        return std::get<detail::event_bus::index_of<Topic, Topics...>::value>(topics_);
+    }
+
+    template<typename Topic>
+    auto slots_of() const noexcept -> const detail::event_bus::topic_slots<Topic, capacity>& {
+        return std::get<detail::event_bus::index_of<Topic, Topics...>::value>(topics_);
+    }
+
+  public:
+    // The type of the event delegates subscribed to `Topic`.
+    template<typename Topic>
+    using delegate_type = event_delegate<void(const Topic&)>;
+
+    event_bus() noexcept            = default;
+    event_bus(const event_bus&)     = delete;
+    event_bus(event_bus&&) noexcept = delete;
+    ~event_bus()                    = default;
+
+    auto operator=(const event_bus&) -> event_bus&     = delete;
+    auto operator=(event_bus&&) noexcept -> event_bus& = delete;
+
+    // Subscribes `target` to `Topic`. The target is a function object or an event delegate
+    // callable with `const Topic&`. Returns an invalid subscription and drops the target if all
+    // slots of `Topic` are in use.
+    template<typename Topic, typename T>
+    auto subscribe(T&& target) -> subscription<Topic> {
+        assert_topic<Topic>();
+        auto& topic         = slots_of<Topic>();
+        std::uint32_t index = 0U;
+        if (topic.freeCount > 0U) {
+            index = topic.freeIndices[topic.freeCount - 1U];
+        } else if (topic.used < capacity) {
+            index = topic.used;
+        } else {
+            return subscription<Topic>{};
+        }
+        topic.slots[index] = delegate_type<Topic>{std::forward<T>(target)};
+        if (topic.freeCount > 0U) {
+            --topic.freeCount;
+        } else {
+            ++topic.used;
+        }
+        using slots_type = detail::event_bus::topic_slots<Topic, capacity>;
+        return subscription<Topic>{&topic, &slots_type::unsubscribe, index};
+    }
+
+    // Drops the event delegate of `handle` and leaves `handle` invalid. Does nothing if `handle`
+    // is invalid or a subscription of another bus. Shall not be called for the event delegate
+    // that is currently being called.
+    template<typename Topic>
+    void unsubscribe(subscription<Topic>& handle) noexcept {
+        assert_topic<Topic>();
+        if (handle.topic_ == &slots_of<Topic>()) {
+            handle.unsubscribe();
+        }
+    }
+
+    // Calls all event delegates subscribed to the type of `message`.
+    template<typename Topic>
+    void publish(const Topic& message) const {
+        assert_topic<Topic>();
+        const auto& topic = slots_of<Topic>();
+        for (std::uint32_t i = 0U; i < topic.used; ++i) {
+            topic.slots[i](message);
+        }
+    }
+
+    // Returns the number of event delegates subscribed to `Topic`.
+    template<typename Topic>
+    auto subscriber_count() const noexcept -> std::size_t {
+        assert_topic<Topic>();
+        const auto& topic = slots_of<Topic>();
+        return topic.used - topic.freeCount;
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_EVENT_BUS_HPP
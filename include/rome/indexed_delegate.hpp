@@ -0,0 +1,303 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::indexed_delegate<Ret(Args...), Object, Behavior>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_INDEXED_DELEGATE_HPP
+#define ROME_INDEXED_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+
+// Maximum number of distinct targets per combination of signature, object type and behavior of
+// `rome::indexed_delegate`. Can be defined before including this header.
+#ifndef ROME_INDEXED_DELEGATE_CAPACITY
+#define ROME_INDEXED_DELEGATE_CAPACITY 256
+#endif
+
+namespace rome {
+
+namespace detail {
+    namespace indexed_delegate {
+        // Called when an empty indexed delegate is invoked.
+        template<bool shallThrow, typename Object, typename Ret, typename... Args>
+        struct empty_trampoline {
+            [[noreturn]] static auto invoke(Object* /*unused*/, std::uint32_t /*unused*/,
+                Args... /*unused*/) -> Ret {
+                delegate::throw_bad_delegate_call();
+            }
+        };
+
+        template<typename Object, typename... Args>
+        struct empty_trampoline<false, Object, void, Args...> {
+            static void invoke(
+                Object* /*unused*/, std::uint32_t /*unused*/, Args... /*unused*/) noexcept {
+            }
+        };
+
+        // Calls the target on the object at `index` of `arena`.
+        template<typename Object, typename Ret, typename... Args>
+        struct trampolines {
+            template<Ret (Object::*pMethod)(Args...)>
+            static auto member(Object* arena, const std::uint32_t index, Args... args) -> Ret {
+                return (arena[index].*pMethod)(static_cast<Args>(args)...);
+            }
+
+            template<Ret (Object::*pMethod)(Args...) const>
+            static auto const_member(Object* arena, const std::uint32_t index, Args... args)
+                -> Ret {
+                return (arena[index].*pMethod)(static_cast<Args>(args)...);
+            }
+
+            template<Ret (*pFunction)(Object&, Args...)>
+            static auto function(Object* arena, const std::uint32_t index, Args... args) -> Ret {
+                return pFunction(arena[index], static_cast<Args>(args)...);
+            }
+        };
+
+        // Global table of all trampolines used by indexed delegates of one signature, object type
+        // and behavior. Each trampoline is added once, when the first delegate calling it is
+        // created. The first entry is reserved for empty delegates.
+        // The table is constant-initialized and never reallocated, thus reading an entry does not
+        // race with adding another one.
+        template<typename Object, typename Signature, bool shallThrow>
+        class trampoline_registry;
+
+        template<typename Object, typename Ret, typename... Args, bool shallThrow>
+        class trampoline_registry<Object, Ret(Args...), shallThrow> {
+          public:
+            using trampoline_type = Ret (*)(Object*, std::uint32_t, Args...);
+
+            static constexpr std::uint32_t emptyIndex = 0U;
+            static constexpr std::uint32_t capacity   = ROME_INDEXED_DELEGATE_CAPACITY;
+
+            // Adds `trampoline` and returns its index. Terminates if the capacity is exhausted,
+            // see `ROME_INDEXED_DELEGATE_CAPACITY`.
+            static auto add(const trampoline_type trampoline) noexcept -> std::uint32_t {
+                const auto index = size_.fetch_add(1U, std::memory_order_relaxed);
+                if (index >= capacity) {
+                    std::terminate();
+                }
+                trampolines_[index] = trampoline;
+                return index;
+            }
+
+            static auto at(const std::uint32_t index) noexcept -> trampoline_type {
+                return trampolines_[index];
+            }
+
+            // Returns the index of `trampoline`, adds it on the first call.
+            template<trampoline_type trampoline>
+            static auto index_of() noexcept -> std::uint32_t {
+                static const std::uint32_t index = add(trampoline);
+                return index;
+            }
+
+          private:
+            static std::atomic<std::uint32_t> size_;
+            static std::array<trampoline_type, capacity> trampolines_;
+        };
+
+        template<typename Object, typename Ret, typename... Args, bool shallThrow>
+        constexpr std::uint32_t trampoline_registry<Object, Ret(Args...), shallThrow>::emptyIndex;
+
+        template<typename Object, typename Ret, typename... Args, bool shallThrow>
+        constexpr std::uint32_t trampoline_registry<Object, Ret(Args...), shallThrow>::capacity;
+
+        template<typename Object, typename Ret, typename... Args, bool shallThrow>
+        std::atomic<std::uint32_t> trampoline_registry<Object, Ret(Args...), shallThrow>::size_{
+            emptyIndex + 1U};
+
+        template<typename Object, typename Ret, typename... Args, bool shallThrow>
+        std::array<typename trampoline_registry<Object, Ret(Args...), shallThrow>::trampoline_type,
+            trampoline_registry<Object, Ret(Args...), shallThrow>::capacity>
+            trampoline_registry<Object, Ret(Args...), shallThrow>::trampolines_ = {
+                {&empty_trampoline<shallThrow, Object, Ret, Args...>::invoke}};
+    }  // namespace indexed_delegate
+
+
+    // Provides common indexed delegate behavior using the 'curiously recurring template pattern',
+    // like `base_delegate`.
+    template<typename DerivedDelegate>
+    class base_indexed_delegate;
+
+    template<template<typename, typename, typename> class DerivedDelegate, typename Ret,
+        typename... Args, typename Object, typename Behavior>
+    class base_indexed_delegate<DerivedDelegate<Ret(Args...), Object, Behavior>> {
+        using delegate_type = DerivedDelegate<Ret(Args...), Object, Behavior>;
+        using registry      = indexed_delegate::trampoline_registry<Object, Ret(Args...),
+            !std::is_same<Behavior, target_is_optional>::value>;
+        using trampolines   = indexed_delegate::trampolines<Object, Ret, Args...>;
+
+        std::uint32_t trampoline_ = registry::emptyIndex;
+        std::uint32_t index_      = 0U;
+
+        template<typename registry::trampoline_type trampoline>
+        static auto create_with(const std::uint32_t index) noexcept -> delegate_type {
+            base_indexed_delegate dgt;
+            dgt.trampoline_ = registry::template index_of<trampoline>();
+            dgt.index_      = index;
+            return {std::move(dgt)};
+        }
+
+      public:
+        constexpr base_indexed_delegate() noexcept = default;
+
+        constexpr explicit operator bool() const noexcept {
+            return trampoline_ != registry::emptyIndex;
+        }
+
+        // Calls the target on the object at `index()` of `arena`.
+        auto operator()(Object* arena, Args... args) const -> Ret {
+            return registry::at(trampoline_)(arena, index_, static_cast<Args>(args)...);
+        }
+
+        // Returns the index of the object within the arena.
+        constexpr auto index() const noexcept -> std::uint32_t {
+            return index_;
+        }
+
+        void drop_target() noexcept {
+            trampoline_ = registry::emptyIndex;
+            index_      = 0U;
+        }
+
+        // Creates a new indexed delegate calling the member function `pMethod` on the object at
+        // `index` of the arena.
+        template<Ret (Object::*pMethod)(Args...)>
+        static auto create(const std::uint32_t index) noexcept -> delegate_type {
+            return create_with<&trampolines::template member<pMethod>>(index);
+        }
+
+        template<Ret (Object::*pMethod)(Args...) const>
+        static auto create(const std::uint32_t index) noexcept -> delegate_type {
+            return create_with<&trampolines::template const_member<pMethod>>(index);
+        }
+
+        // Creates a new indexed delegate calling `pFunction` with the object at `index` of the
+        // arena as first argument.
+        template<Ret (*pFunction)(Object&, Args...)>
+        static auto create(const std::uint32_t index) noexcept -> delegate_type {
+            return create_with<&trampolines::template function<pFunction>>(index);
+        }
+    };
+}  // namespace detail
+
+
+// Calls a member function of an object stored in an arena, e.g. a `std::vector`, that is passed
+// on each call. Stores only two 32 bit indices, the one of the target in a global registry and the
+// one of the object in the arena. See the documentation in `doc/indexed_delegate.md`.
+template<typename Signature, typename Object, typename Behavior = target_is_expected>
+class indexed_delegate {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter "
+        "'Signature' must be a valid function signature.");
+};
+
+template<typename Ret, typename... Args, typename Object, typename Behavior>
+class indexed_delegate<Ret(Args...), Object, Behavior>
+    : private detail::base_indexed_delegate<indexed_delegate<Ret(Args...), Object, Behavior>> {
+    static_assert(detail::delegate::is_behavior<Behavior>,
+        "Invalid parameter 'Behavior'. The template parameter 'Behavior' must either be empty or "
+        "contain one of the types 'rome::target_is_optional', 'rome::target_is_expected' or "
+        "'rome::target_is_mandatory'.");
+    static_assert(detail::delegate::is_valid_behavior<Ret, Behavior>,
+        "Return type coflicts with parameter 'Behavior'. The parameter 'Behavior' is only "
+        "allowed to be 'rome::target_is_optional' if the return type is 'void'.");
+    static_assert(std::is_object<Object>::value && !std::is_const<Object>::value,
+        "Invalid parameter 'Object'. The template parameter 'Object' must be a non-const object "
+        "type.");
+
+    using base_type =
+        detail::base_indexed_delegate<indexed_delegate<Ret(Args...), Object, Behavior>>;
+    // give base_type access to private constructor `indexed_delegate(base_type&&)`
+    friend base_type;
+
+    constexpr indexed_delegate(base_type&& base) noexcept : base_type{base} {
+    }
+
+  public:
+    constexpr indexed_delegate() noexcept = default;
+
+    constexpr indexed_delegate(std::nullptr_t) noexcept : indexed_delegate{} {
+    }
+    auto operator=(std::nullptr_t) noexcept -> indexed_delegate& {
+        base_type::drop_target();
+        return *this;
+    }
+
+    using base_type::operator bool;
+    using base_type::operator();
+    using base_type::create;
+    using base_type::index;
+
+    friend constexpr auto operator==(const indexed_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const indexed_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const indexed_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const indexed_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+template<typename Ret, typename... Args, typename Object>
+class indexed_delegate<Ret(Args...), Object, target_is_mandatory>
+    : private detail::base_indexed_delegate<
+          indexed_delegate<Ret(Args...), Object, target_is_mandatory>> {
+    static_assert(std::is_object<Object>::value && !std::is_const<Object>::value,
+        "Invalid parameter 'Object'. The template parameter 'Object' must be a non-const object "
+        "type.");
+
+    using base_type =
+        detail::base_indexed_delegate<indexed_delegate<Ret(Args...), Object, target_is_mandatory>>;
+    // give base_type access to private constructor `indexed_delegate(base_type&&)`
+    friend base_type;
+
+    constexpr indexed_delegate(base_type&& base) noexcept : base_type{base} {
+    }
+
+  public:
+    constexpr indexed_delegate() noexcept = delete;
+
+    using base_type::operator bool;
+    using base_type::operator();
+    using base_type::create;
+    using base_type::index;
+
+    friend constexpr auto operator==(const indexed_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const indexed_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const indexed_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const indexed_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_INDEXED_DELEGATE_HPP
@@ -0,0 +1,192 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::intrusive_event<void(Args...)>
+//   - rome::intrusive_slot<void(Args...)>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_INTRUSIVE_EVENT_HPP
+#define ROME_INTRUSIVE_EVENT_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+template<typename Signature>
+class intrusive_event;
+
+template<typename Signature>
+class intrusive_slot;
+
+namespace detail {
+    namespace intrusive_event {
+        // Node of a circular doubly linked list. An unlinked hook points to nothing.
+        struct hook {
+            hook* prev = nullptr;
+            hook* next = nullptr;
+
+            auto is_linked() const noexcept -> bool {
+                return next != nullptr;
+            }
+
+            // Links this hook in front of `pos`.
+            void link_before(hook& pos) noexcept {
+                prev           = pos.prev;
+                next           = &pos;
+                pos.prev->next = this;
+                pos.prev       = this;
+            }
+
+            void unlink() noexcept {
+                if (is_linked()) {
+                    prev->next = next;
+                    next->prev = prev;
+                    prev       = nullptr;
+                    next       = nullptr;
+                }
+            }
+        };
+    }  // namespace intrusive_event
+}  // namespace detail
+
+
+// An event delegate to be embedded into the object it calls. Is connected to at most one
+// `rome::intrusive_event` at a time without allocating any memory, and disconnects itself when it
+// is destroyed. See the documentation in `doc/intrusive_event.md`.
+template<typename Signature>
+class intrusive_slot {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with return type 'void'.");
+};
+
+template<typename... Args>
+class intrusive_slot<void(Args...)> : private detail::intrusive_event::hook {
+  public:
+    using delegate_type = event_delegate<void(Args...)>;
+
+  private:
+    delegate_type delegate_;
+
+    friend class intrusive_event<void(Args...)>;
+
+  public:
+    intrusive_slot() noexcept = default;
+
+    // Creates an unconnected slot with its event delegate created from `target`, e.g. a function
+    // object or a `rome::event_delegate`.
+    template<typename T,
+        std::enable_if_t<!std::is_same<intrusive_slot, std::decay_t<T>>::value, int> = 0>
+    explicit intrusive_slot(T&& target) noexcept(
+        std::is_nothrow_constructible<delegate_type, T>::value)
+        : delegate_{std::forward<T>(target)} {
+    }
+
+    intrusive_slot(const intrusive_slot&) = delete;
+    intrusive_slot(intrusive_slot&&)      = delete;
+
+    ~intrusive_slot() {
+        unlink();
+    }
+
+    auto operator=(const intrusive_slot&) -> intrusive_slot& = delete;
+    auto operator=(intrusive_slot&&) -> intrusive_slot&      = delete;
+
+    // Returns the event delegate called by the event.
+    auto delegate() noexcept -> delegate_type& {
+        return delegate_;
+    }
+
+    auto delegate() const noexcept -> const delegate_type& {
+        return delegate_;
+    }
+
+    auto connected() const noexcept -> bool {
+        return is_linked();
+    }
+
+    void disconnect() noexcept {
+        unlink();
+    }
+};
+
+
+// Calls all connected `rome::intrusive_slot`s in the order of connection. The slots are linked
+// into a list, connecting and disconnecting them does not allocate any memory. See the
+// documentation in `doc/intrusive_event.md`.
+template<typename Signature>
+class intrusive_event {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with return type 'void'.");
+};
+
+template<typename... Args>
+class intrusive_event<void(Args...)> {
+    using hook = detail::intrusive_event::hook;
+
+    // The list is circular, `head_` is the sentinel before the first and after the last slot.
+    hook head_;
+
+  public:
+    using slot_type = intrusive_slot<void(Args...)>;
+
+    intrusive_event() noexcept {
+        head_.prev = &head_;
+        head_.next = &head_;
+    }
+
+    intrusive_event(const intrusive_event&) = delete;
+    intrusive_event(intrusive_event&&)      = delete;
+
+    // Disconnects all slots.
+    ~intrusive_event() {
+        disconnect_all();
+    }
+
+    auto operator=(const intrusive_event&) -> intrusive_event& = delete;
+    auto operator=(intrusive_event&&) -> intrusive_event&      = delete;
+
+    // Connects `slot` as last slot. Disconnects it from its current event first.
+    void connect(slot_type& slot) noexcept {
+        hook& node = slot;
+        node.unlink();
+        node.link_before(head_);
+    }
+
+    void disconnect_all() noexcept {
+        while (head_.next != &head_) {
+            head_.next->unlink();
+        }
+    }
+
+    auto empty() const noexcept -> bool {
+        return head_.next == &head_;
+    }
+
+    // Calls the event delegates of all connected slots. The slot being called may be disconnected
+    // or destroyed by its own call, other slots shall not.
+    void operator()(Args... args) const {
+        const hook* node = head_.next;
+        while (node != &head_) {
+            const hook* next = node->next;
+            static_cast<const slot_type*>(node)->delegate_(args...);
+            node = next;
+        }
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_INTRUSIVE_EVENT_HPP
@@ -0,0 +1,216 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::multicast_delegate<Ret(Args...), Combiner, Behavior>
+//   - rome::combiners::all_of
+//   - rome::combiners::any_of
+//   - rome::combiners::first_non_empty
+//   - rome::combiners::fold<T, BinaryOp>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_MULTICAST_DELEGATE_HPP
+#define ROME_MULTICAST_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rome {
+
+// Combine the return values of the targets of a `rome::multicast_delegate` into one result. A
+// combiner provides the result type for a return type `R`, the result if no target is called, and
+// folds each return value into the result. `combine` returns false to skip the remaining targets.
+namespace combiners {
+    // The result is whether all return values are true. Stops at the first false return value.
+    struct all_of {
+        template<typename R>
+        using result_type = bool;
+
+        template<typename R>
+        constexpr auto initial() const noexcept -> bool {
+            return true;
+        }
+
+        constexpr auto combine(bool& result, const bool value) const noexcept -> bool {
+            result = value;
+            return value;
+        }
+    };
+
+    // The result is whether any return value is true. Stops at the first true return value.
+    struct any_of {
+        template<typename R>
+        using result_type = bool;
+
+        template<typename R>
+        constexpr auto initial() const noexcept -> bool {
+            return false;
+        }
+
+        constexpr auto combine(bool& result, const bool value) const noexcept -> bool {
+            result = value;
+            return !value;
+        }
+    };
+
+    // The result is the first return value that converts to true, e.g. a non-null pointer, or a
+    // value initialized `R` if there is none. Stops at the first such return value.
+    struct first_non_empty {
+        template<typename R>
+        using result_type = std::decay_t<R>;
+
+        template<typename R>
+        constexpr auto initial() const -> result_type<R> {
+            return result_type<R>{};
+        }
+
+        template<typename Result, typename T>
+        constexpr auto combine(Result& result, T&& value) const -> bool {
+            if (!value) {
+                return true;
+            }
+            result = std::forward<T>(value);
+            return false;
+        }
+    };
+
+    // The result is `op(... op(op(init, value1), value2) ..., valueN)`. Calls all targets.
+    template<typename T, typename BinaryOp = std::plus<T>>
+    class fold {
+        T init_;
+        BinaryOp op_;
+
+      public:
+        constexpr explicit fold(T init = T{}, BinaryOp op = BinaryOp{}) noexcept(
+            std::is_nothrow_move_constructible<T>::value
+            && std::is_nothrow_move_constructible<BinaryOp>::value)
+            : init_{std::move(init)}, op_{std::move(op)} {
+        }
+
+        template<typename R>
+        using result_type = T;
+
+        template<typename R>
+        constexpr auto initial() const -> T {
+            return init_;
+        }
+
+        template<typename U>
+        constexpr auto combine(T& result, U&& value) const -> bool {
+            result = op_(std::move(result), std::forward<U>(value));
+            return true;
+        }
+    };
+}  // namespace combiners
+
+
+// Calls several targets with the same arguments and combines their return values with a
+// `Combiner`. See the documentation in `doc/multicast_delegate.md`.
+template<typename Signature, typename Combiner, typename Behavior = target_is_expected>
+class multicast_delegate {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with a non-void return type.");
+};
+
+template<typename Ret, typename... Args, typename Combiner, typename Behavior>
+class multicast_delegate<Ret(Args...), Combiner, Behavior> {
+    static_assert(!std::is_void<Ret>::value,
+        "Invalid parameter 'Signature'. The return type must not be 'void', there is nothing to "
+        "combine. Use 'rome::delegate_registry' or 'rome::delegate_array' instead.");
+    static_assert(std::is_same<Behavior, target_is_expected>::value
+                      || std::is_same<Behavior, target_is_optional>::value,
+        "Invalid parameter 'Behavior'. The template parameter 'Behavior' must either be empty or "
+        "contain one of the types 'rome::target_is_optional' or 'rome::target_is_expected'.");
+    static_assert(detail::delegate::none_of<std::is_rvalue_reference<Args>::value...>,
+        "Invalid parameter 'Signature'. The argument types must not be rvalue references, as the "
+        "arguments are passed to several targets.");
+
+  public:
+    using delegate_type = delegate<Ret(Args...), target_is_expected>;
+    using combiner_type = Combiner;
+    using result_type   = typename Combiner::template result_type<Ret>;
+
+  private:
+    std::vector<delegate_type> delegates_;
+    Combiner combiner_;
+
+  public:
+    multicast_delegate() = default;
+
+    explicit multicast_delegate(Combiner combiner) noexcept(
+        std::is_nothrow_move_constructible<Combiner>::value)
+        : combiner_{std::move(combiner)} {
+    }
+
+    multicast_delegate(const multicast_delegate&) = delete;
+    multicast_delegate(multicast_delegate&&)      = default;
+    ~multicast_delegate()                         = default;
+
+    auto operator=(const multicast_delegate&) -> multicast_delegate& = delete;
+    auto operator=(multicast_delegate&&) -> multicast_delegate&      = default;
+
+    auto size() const noexcept -> std::size_t {
+        return delegates_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+        return delegates_.empty();
+    }
+
+    void reserve(const std::size_t capacity) {
+        delegates_.reserve(capacity);
+    }
+
+    void clear() noexcept {
+        delegates_.clear();
+    }
+
+    auto combiner() const noexcept -> const Combiner& {
+        return combiner_;
+    }
+
+    // Appends the delegate created from `target`, e.g. a function object or a `rome::delegate`.
+    // An empty delegate is not appended. Returns whether the target was appended.
+    template<typename T>
+    auto push_back(T&& target) -> bool {
+        delegate_type dgt{std::forward<T>(target)};
+        if (!dgt) {
+            return false;
+        }
+        delegates_.push_back(std::move(dgt));
+        return true;
+    }
+
+    // Calls the targets in order until the combiner stops, and returns the combined result.
+    // Without targets, throws `rome::bad_delegate_call` if `Behavior` is
+    // `rome::target_is_expected`, and returns the initial result of the combiner otherwise.
+    auto operator()(Args... args) const -> result_type {
+        if (std::is_same<Behavior, target_is_expected>::value && delegates_.empty()) {
+            detail::delegate::throw_bad_delegate_call();
+        }
+        auto result = combiner_.template initial<Ret>();
+        for (const auto& dgt : delegates_) {
+            if (!combiner_.combine(result, dgt(args...))) {
+                break;
+            }
+        }
+        return result;
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_MULTICAST_DELEGATE_HPP
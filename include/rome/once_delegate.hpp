@@ -0,0 +1,482 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::once_delegate<Ret(Args...), Behavior>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_ONCE_DELEGATE_HPP
+#define ROME_ONCE_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+namespace detail {
+    namespace once_delegate {
+        using delegate::storage_type;
+
+        // Used by a once delegate with an assigned stateless functor, which was not stored.
+        template<typename Functor, typename Ret, typename... Args>
+        auto consume_stateless_functor(storage_type& /*unused*/, Args... args) -> Ret {
+            return Functor{}(static_cast<Args>(args)...);
+        }
+
+        // Used by a once delegate with an assigned functor that was small object optimized inside
+        // the storage. Calls the functor as rvalue and destroys it afterwards, also if it throws.
+        template<typename Functor, typename Ret, typename... Args>
+        auto consume_locally_stored_functor(storage_type& storage, Args... args) -> Ret {
+            struct destroy {
+                Functor* pFunctor;
+                ~destroy() {
+                    pFunctor->~Functor();
+                }
+            } const guard{delegate::stored_functor<Functor>::address(storage)};
+            return std::move(*guard.pFunctor)(static_cast<Args>(args)...);
+        }
+
+        // Used by a once delegate with an assigned functor that was dynamically stored outside of
+        // the storage. Calls the functor as rvalue and deletes it afterwards, also if it throws.
+        template<typename Functor, typename Ret, typename... Args>
+        auto consume_dynamically_allocated_functor(storage_type& storage, Args... args) -> Ret {
+            const std::unique_ptr<Functor> pFunctor{static_cast<Functor*>(storage)};
+            return std::move(*pFunctor)(static_cast<Args>(args)...);
+        }
+
+        // Selects the consuming function for a function object of type `Functor`, depending on
+        // how it is stored, like `delegate::stored_functor`.
+        template<typename Functor, bool isStateless = delegate::is_stateless<Functor>,
+            bool isSmall = delegate::is_small_object_optimizable<Functor>>
+        struct stored_functor {
+            template<typename Ret, typename... Args>
+            static constexpr auto consumer() noexcept -> Ret (*)(storage_type&, Args...) {
+                return &consume_dynamically_allocated_functor<Functor, Ret, Args...>;
+            }
+        };
+
+        template<typename Functor>
+        struct stored_functor<Functor, false, true> {
+            template<typename Ret, typename... Args>
+            static constexpr auto consumer() noexcept -> Ret (*)(storage_type&, Args...) {
+                return &consume_locally_stored_functor<Functor, Ret, Args...>;
+            }
+        };
+
+        template<typename Functor, bool isSmall>
+        struct stored_functor<Functor, true, isSmall> {
+            template<typename Ret, typename... Args>
+            static constexpr auto consumer() noexcept -> Ret (*)(storage_type&, Args...) {
+                return &consume_stateless_functor<Functor, Ret, Args...>;
+            }
+        };
+    }  // namespace once_delegate
+
+
+    // Implements the actual behavior of all once delegates. Same as `delegate_core`, but the
+    // target is consumed by the call: the invoking function also destroys the target, so that a
+    // call costs one indirect call only. The destroying function is only called if the once
+    // delegate is destroyed or reassigned without being called.
+    template<typename Signature, bool shallThrowWhenEmpty>
+    class once_delegate_core;
+
+    template<typename Ret, typename... Args, bool shallThrowWhenEmpty>
+    class once_delegate_core<Ret(Args...), shallThrowWhenEmpty> {
+        using storage_type = delegate::storage_type;
+
+        static constexpr auto emptyConsumer =
+            delegate::empty_invoker<shallThrowWhenEmpty, Ret, Args...>::value;
+
+        alignas(delegate::storage_alignment) storage_type storage_ = nullptr;
+        Ret (*consumeTarget_)(storage_type&, Args...)              = emptyConsumer;
+        void (*deleteTarget_)(storage_type&) noexcept              = &delegate::do_nothing;
+
+        template<typename Functor>
+        static constexpr auto consumer_of() noexcept -> Ret (*)(storage_type&, Args...) {
+            return once_delegate::stored_functor<Functor>::template consumer<Ret, Args...>();
+        }
+
+        // Leaves the core empty without destroying the target.
+        void release() noexcept {
+            storage_       = nullptr;
+            consumeTarget_ = emptyConsumer;
+            deleteTarget_  = &delegate::do_nothing;
+        }
+
+      public:
+        constexpr once_delegate_core() noexcept                = default;
+        once_delegate_core(const once_delegate_core&) noexcept = delete;
+        ROME_DELEGATE_CPP20_CONSTEXPR once_delegate_core(once_delegate_core&& orig) noexcept {
+            orig.swap(*this);
+        }
+
+        // Creates a once delegate core with a target that is fully described by the value of
+        // `storage` and the function `consumeTarget`. Thus, the target needs no destruction.
+        constexpr once_delegate_core(
+            storage_type storage, Ret (*consumeTarget)(storage_type&, Args...)) noexcept
+            : storage_{storage}, consumeTarget_{consumeTarget} {
+        }
+
+        ROME_DELEGATE_CPP20_CONSTEXPR ~once_delegate_core() {
+            (*deleteTarget_)(storage_);
+        }
+
+        auto operator=(const once_delegate_core&) noexcept -> once_delegate_core& = delete;
+        ROME_DELEGATE_CPP20_CONSTEXPR auto operator=(once_delegate_core&& orig) noexcept
+            -> once_delegate_core& {
+            once_delegate_core{std::move(orig)}.swap(*this);
+            return *this;
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return consumeTarget_ != emptyConsumer;
+        }
+
+        // Takes the target out of the core, which is empty afterwards, and consumes it. Thus the
+        // core is empty also if the target throws or calls the once delegate again.
+        auto consume(Args... args) -> Ret {
+            auto storage             = storage_;
+            const auto consumeTarget = consumeTarget_;
+            release();
+            return (*consumeTarget)(storage, static_cast<Args>(args)...);
+        }
+
+        ROME_DELEGATE_CPP20_CONSTEXPR void swap(once_delegate_core& other) noexcept {
+            using std::swap;
+            swap(storage_, other.storage_);
+            swap(consumeTarget_, other.consumeTarget_);
+            swap(deleteTarget_, other.deleteTarget_);
+        }
+
+        ROME_DELEGATE_CPP20_CONSTEXPR void drop_target() noexcept {
+            once_delegate_core{}.swap(*this);
+        }
+
+        // Returns the address of the assigned function object if it is of type `Functor`, or
+        // nullptr otherwise. Compares the consuming function with the one used for `Functor`.
+        template<typename Functor>
+        auto target() const noexcept -> Functor* {
+            if (consumeTarget_ != consumer_of<Functor>()) {
+                return nullptr;
+            }
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            return delegate::stored_functor<Functor>::address(const_cast<storage_type&>(storage_));
+        }
+
+        // Does not store the stateless function object constructed from `args`. It is recreated
+        // on the call. The once delegate core must be empty.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<delegate::is_stateless<Functor>, int> = 0>
+        constexpr void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            (void)Functor(std::forward<CtorArgs>(args)...);
+            consumeTarget_ = consumer_of<Functor>();
+        }
+
+        // Constructs the function object from `args` inside the local storage. The once delegate
+        // core must be empty.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            // NOLINTNEXTLINE(bugprone-multi-level-implicit-pointer-conversion)
+            (void)::new (&storage_) Functor(std::forward<CtorArgs>(args)...);
+            consumeTarget_ = consumer_of<Functor>();
+            deleteTarget_  = delegate::stored_functor<Functor>::deleter();
+        }
+
+        // Constructs the function object from `args` in a dynamically allocated storage. The once
+        // delegate core must be empty.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && !delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) {
+            storage_       = new Functor(std::forward<CtorArgs>(args)...);
+            consumeTarget_ = consumer_of<Functor>();
+            deleteTarget_  = delegate::stored_functor<Functor>::deleter();
+        }
+    };
+
+
+    // Provides common once delegate behavior using the 'curiously recurring template pattern',
+    // like `base_delegate`.
+    template<typename DerivedDelegate>
+    class base_once_delegate;
+
+    template<template<typename, typename> class DerivedDelegate, typename Ret, typename... Args,
+        typename Behavior>
+    class base_once_delegate<DerivedDelegate<Ret(Args...), Behavior>> {
+        using delegate_type = DerivedDelegate<Ret(Args...), Behavior>;
+        using core_type     = once_delegate_core<Ret(Args...),
+            !std::is_same<Behavior, target_is_optional>::value>;
+        using invoker       = delegate::non_functor_invoker<Ret(Args...)>;
+        core_type core_     = {};
+
+        template<typename F>
+        static constexpr void assert_target_type() noexcept {
+            static_assert(std::is_class<F>::value && std::is_same<F, std::decay_t<F>>::value,
+                "Invalid target type 'F'. The type must be the decayed type of a function object "
+                "(a class type with a function call operator, e.g. a lambda).");
+            static_assert(delegate::is_callable_by<F, Ret(Args...)>,
+                "Invalid target type 'F'. The function call signature of the type must be "
+                "compatible with the signature of the delegate.");
+        }
+
+        constexpr explicit base_once_delegate(core_type&& core) noexcept : core_{std::move(core)} {
+        }
+
+      public:
+        constexpr base_once_delegate() noexcept = default;
+
+        constexpr explicit operator bool() const noexcept {
+            return core_.operator bool();
+        }
+
+        // Calls the target as rvalue and destroys it with a single indirect call. The once
+        // delegate is empty afterwards, also if the target throws.
+        auto operator()(Args... args) && -> Ret {
+            return core_.consume(static_cast<Args>(args)...);
+        }
+
+        void swap(delegate_type& other) noexcept {
+            core_.swap(other.core_);
+        }
+
+        void drop_target() noexcept {
+            core_.drop_target();
+        }
+
+        // Returns a pointer to the target if it is a function object of type `F`, nullptr
+        // otherwise.
+        template<typename F>
+        auto target() noexcept -> F* {
+            assert_target_type<F>();
+            return core_.template target<F>();
+        }
+
+        template<typename F>
+        auto target() const noexcept -> const F* {
+            assert_target_type<F>();
+            return core_.template target<F>();
+        }
+
+        // Creates a new once delegate targeting a function object of type `F` constructed in
+        // place from `args`.
+        template<typename F, typename... CtorArgs>
+        static constexpr auto create_in_place(CtorArgs&&... args) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<F>(std::forward<CtorArgs>(args)...)))
+            -> delegate_type {
+            assert_target_type<F>();
+            base_once_delegate dgt;
+            dgt.core_.template emplace<F>(std::forward<CtorArgs>(args)...);
+            return {std::move(dgt)};
+        }
+
+        // Creates a new once delegate targeting the passed function or static member function.
+        template<Ret (*pFunction)(Args...)>
+        static constexpr auto create() noexcept -> delegate_type {
+            return {base_once_delegate{
+                core_type{nullptr, &invoker::template invoke_function<pFunction>}}};
+        }
+
+        // Creates a new once delegate targeting the non-static member function and related
+        // object. Does NOT take ownership of the passed object `obj`.
+        template<typename C, Ret (C::*pMethod)(Args...)>
+        static constexpr auto create(C& obj) noexcept -> delegate_type {
+            return {base_once_delegate{core_type{
+                static_cast<void*>(&obj), &invoker::template invoke_member_function<C, pMethod>}}};
+        }
+
+        // Creates a new once delegate targeting the passed non-static const member function and
+        // related object. Does NOT take ownership of the passed object `obj`.
+        template<typename C, Ret (C::*pMethod)(Args...) const>
+        static constexpr auto create(const C& obj) noexcept -> delegate_type {
+            return {base_once_delegate{core_type{static_cast<void*>(const_cast<C*>(&obj)),
+                &invoker::template invoke_const_member_function<C, pMethod>}}};
+        }
+
+        // Creates a new once delegate targeting the passed function object and taking ownership
+        // of it. The function object may be move-only.
+        template<typename T, typename Functor = std::decay_t<T>>
+        static constexpr auto create(T&& functor) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<Functor>(std::forward<T>(functor))))
+            -> delegate_type {
+            static_assert(std::is_class<Functor>::value,
+                "Invalid object passed. Object needs to be a function object (a class type with a "
+                "function call operator, e.g. a lambda).");
+            static_assert(delegate::is_callable_by<Functor, Ret(Args...)>,
+                "Passed function object has incompatible function call signature. The function "
+                "call signature must be compatible with the signature of the delegate so that the "
+                "delegate is able to invoke the function object as rvalue.");
+            base_once_delegate dgt;
+            dgt.core_.template emplace<Functor>(std::forward<T>(functor));
+            return {std::move(dgt)};
+        }
+    };
+}  // namespace detail
+
+
+// Stores a target that is called at most once, like a completion handler. The call operator is
+// rvalue qualified, it calls the target as rvalue and destroys it with a single indirect call, so
+// that the target can move its captured state out. See the documentation in
+// `doc/once_delegate.md`.
+template<typename Signature, typename Behavior = target_is_expected>
+class once_delegate {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter "
+        "'Signature' must be a valid function signature.");
+};
+
+template<typename Ret, typename... Args, typename Behavior>
+class once_delegate<Ret(Args...), Behavior>
+    : private detail::base_once_delegate<once_delegate<Ret(Args...), Behavior>> {
+    static_assert(detail::delegate::is_behavior<Behavior>,
+        "Invalid parameter 'Behavior'. The template parameter 'Behavior' must either be empty or "
+        "contain one of the types 'rome::target_is_optional', 'rome::target_is_expected' or "
+        "'rome::target_is_mandatory'.");
+    static_assert(detail::delegate::is_valid_behavior<Ret, Behavior>,
+        "Return type coflicts with parameter 'Behavior'. The parameter 'Behavior' is only "
+        "allowed to be 'rome::target_is_optional' if the return type is 'void'.");
+
+    using base_type = detail::base_once_delegate<once_delegate<Ret(Args...), Behavior>>;
+    // give base_type access to private constructor `once_delegate(base_type&&)`
+    friend base_type;
+
+    constexpr once_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+
+  public:
+    constexpr once_delegate() noexcept           = default;
+    once_delegate(const once_delegate&) noexcept = delete;
+    once_delegate(once_delegate&&) noexcept      = default;
+    ~once_delegate()                             = default;
+
+    auto operator=(const once_delegate&) noexcept -> once_delegate& = delete;
+    auto operator=(once_delegate&&) noexcept -> once_delegate&      = default;
+
+    // Construct from a function object target.
+    // SFINAE to prevent hiding the constructors `once_delegate(once_delegate&&)`,
+    // `once_delegate(base_type&&)`, `once_delegate(std::nullptr_t)` and
+    // `once_delegate(in_place_type_t<F>, args...)`.
+    template<typename Functor,
+        std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
+            int> = 0>
+    constexpr once_delegate(Functor&& functor) noexcept(
+        noexcept(base_type::create(std::forward<Functor>(functor))))
+        : once_delegate{base_type::create(std::forward<Functor>(functor))} {
+    }
+
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit once_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : once_delegate{base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    constexpr once_delegate(std::nullptr_t) noexcept : once_delegate{} {
+    }
+    auto operator=(std::nullptr_t) noexcept -> once_delegate& {
+        base_type::drop_target();
+        return *this;
+    }
+
+    using base_type::swap;
+    using base_type::operator bool;
+    using base_type::operator();
+    using base_type::create;
+    using base_type::target;
+
+    friend constexpr auto operator==(const once_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const once_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const once_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const once_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+template<typename Ret, typename... Args>
+class once_delegate<Ret(Args...), target_is_mandatory>
+    : private detail::base_once_delegate<once_delegate<Ret(Args...), target_is_mandatory>> {
+    using base_type = detail::base_once_delegate<once_delegate<Ret(Args...), target_is_mandatory>>;
+    // give base_type access to private constructor `once_delegate(base_type&&)`
+    friend base_type;
+
+    constexpr once_delegate(base_type&& base) noexcept : base_type{std::move(base)} {
+    }
+
+  public:
+    constexpr once_delegate() noexcept           = delete;
+    once_delegate(const once_delegate&) noexcept = delete;
+    once_delegate(once_delegate&&) noexcept      = default;
+    ~once_delegate()                             = default;
+
+    auto operator=(const once_delegate&) noexcept -> once_delegate& = delete;
+    auto operator=(once_delegate&&) noexcept -> once_delegate&      = default;
+
+    // Construct directly from a function object target.
+    // SFINAE to prevent hiding the constructors `once_delegate(once_delegate&&)`,
+    // `once_delegate(base_type&&)`, `once_delegate(std::nullptr_t)` and
+    // `once_delegate(in_place_type_t<F>, args...)`.
+    template<typename Functor,
+        std::enable_if_t<!std::is_base_of<base_type, std::decay_t<Functor>>::value
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>,
+            int> = 0>
+    constexpr once_delegate(Functor&& functor) noexcept(
+        noexcept(base_type::create(std::forward<Functor>(functor))))
+        : once_delegate{base_type::create(std::forward<Functor>(functor))} {
+    }
+
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    constexpr explicit once_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)))
+        : once_delegate{base_type::template create_in_place<F>(std::forward<CtorArgs>(args)...)} {
+    }
+
+    using base_type::swap;
+    using base_type::operator bool;
+    using base_type::operator();
+    using base_type::create;
+    using base_type::target;
+
+    friend constexpr auto operator==(const once_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const once_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const once_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const once_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_ONCE_DELEGATE_HPP
@@ -0,0 +1,487 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::basic_overload_delegate<Behavior, Signatures...>
+//   - rome::overload_delegate<BehaviorAndSignatures...>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_OVERLOAD_DELEGATE_HPP
+#define ROME_OVERLOAD_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+template<typename Behavior, typename... Signatures>
+class basic_overload_delegate;
+
+namespace detail {
+    namespace overload_delegate {
+        using delegate::storage_type;
+
+        // Whether `T` is a valid function signature.
+        template<typename T>
+        struct is_signature : std::false_type {};
+
+        template<typename Ret, typename... Args>
+        struct is_signature<Ret(Args...)> : std::true_type {};
+
+        // Whether `T` is a function object callable by all `Signatures...`.
+        template<typename T, typename... Signatures>
+        constexpr bool is_function_object_for =
+            std::is_class<T>::value
+            && delegate::all_of<delegate::is_callable_by<T, Signatures>...>;
+
+        // Whether `T` is a function signature with return type void.
+        template<typename T>
+        struct returns_void : std::false_type {};
+
+        template<typename... Args>
+        struct returns_void<void(Args...)> : std::true_type {};
+
+        template<typename Signature>
+        struct signature_traits;
+
+        template<typename Ret, typename... Args>
+        struct signature_traits<Ret(Args...)> {
+            using invoker_type = Ret (*)(storage_type&, Args...);
+
+            template<bool shallThrow>
+            static constexpr auto empty_invoker() noexcept -> invoker_type {
+                return delegate::empty_invoker<shallThrow, Ret, Args...>::value;
+            }
+
+            template<typename Functor>
+            static constexpr auto functor_invoker() noexcept -> invoker_type {
+                return delegate::stored_functor<Functor>::template invoker<Ret, Args...>();
+            }
+        };
+
+        // The functions to invoke a target, one per signature, and the function to destroy it.
+        template<typename... Signatures>
+        struct ops {
+            std::tuple<typename signature_traits<Signatures>::invoker_type...> invoke;
+            void (*destroy)(storage_type&) noexcept;
+        };
+
+        // Returns the operations used by an empty overload delegate.
+        template<bool shallThrow, typename... Signatures>
+        auto empty_ops() noexcept -> const ops<Signatures...>* {
+            static constexpr ops<Signatures...> value{
+                std::make_tuple(
+                    signature_traits<Signatures>::template empty_invoker<shallThrow>()...),
+                &delegate::do_nothing<>};
+            return &value;
+        }
+
+        // Returns the operations used for a function object of type `Functor`.
+        template<typename Functor, typename... Signatures>
+        auto functor_ops() noexcept -> const ops<Signatures...>* {
+            using access = delegate::stored_functor<Functor>;
+            static constexpr ops<Signatures...> value{
+                std::make_tuple(
+                    signature_traits<Signatures>::template functor_invoker<Functor>()...),
+                access::deleter()};
+            return &value;
+        }
+
+
+        // Provides one function call operator per signature. Each one is declared in its own
+        // class of a chain of base classes and all of them are made visible by using-declarations,
+        // so that overload resolution selects the signature.
+        template<typename Derived, std::size_t index, typename... Signatures>
+        class call_operators;
+
+        template<typename Derived, std::size_t index, typename Ret, typename... Args>
+        class call_operators<Derived, index, Ret(Args...)> {
+          public:
+            auto operator()(Args... args) const -> Ret {
+                return static_cast<const Derived&>(*this).template invoke<index>(
+                    static_cast<Args>(args)...);
+            }
+        };
+
+        template<typename Derived, std::size_t index, typename Ret, typename... Args,
+            typename... Others>
+        class call_operators<Derived, index, Ret(Args...), Others...>
+            : public call_operators<Derived, index + 1, Others...> {
+          public:
+            using call_operators<Derived, index + 1, Others...>::operator();
+
+            auto operator()(Args... args) const -> Ret {
+                return static_cast<const Derived&>(*this).template invoke<index>(
+                    static_cast<Args>(args)...);
+            }
+        };
+
+
+        // Splits the template arguments of `rome::overload_delegate` into the optional leading
+        // `Behavior` and the `Signatures...`.
+        template<bool hasBehavior, typename... BehaviorAndSignatures>
+        struct select_type;
+
+        template<typename... Signatures>
+        struct select_type<false, Signatures...> {
+            using type = basic_overload_delegate<target_is_expected, Signatures...>;
+        };
+
+        template<typename Behavior, typename... Signatures>
+        struct select_type<true, Behavior, Signatures...> {
+            using type = basic_overload_delegate<Behavior, Signatures...>;
+        };
+
+        template<typename... BehaviorAndSignatures>
+        struct starts_with_behavior : std::false_type {};
+
+        template<typename First, typename... Signatures>
+        struct starts_with_behavior<First, Signatures...>
+            : std::integral_constant<bool, delegate::is_behavior<First>> {};
+    }  // namespace overload_delegate
+
+
+    // Implements the actual behavior of all overload delegates. Stores the target like
+    // `delegate_core`, but refers to a static table of operations holding one invoking function
+    // per signature and the destroying function.
+    template<bool shallThrowWhenEmpty, typename... Signatures>
+    class overload_delegate_core {
+        using storage_type = delegate::storage_type;
+        using ops_type     = overload_delegate::ops<Signatures...>;
+
+        static auto empty_ops() noexcept -> const ops_type* {
+            return overload_delegate::empty_ops<shallThrowWhenEmpty, Signatures...>();
+        }
+
+        // storage_ needs to be writable by the const call operators while small object
+        // optimization is used
+        alignas(delegate::storage_alignment) mutable storage_type storage_ = nullptr;
+        const ops_type* ops_                                               = empty_ops();
+
+      public:
+        overload_delegate_core() noexcept                              = default;
+        overload_delegate_core(const overload_delegate_core&) noexcept = delete;
+        overload_delegate_core(overload_delegate_core&& orig) noexcept {
+            orig.swap(*this);
+        }
+
+        ~overload_delegate_core() {
+            (*ops_->destroy)(storage_);
+        }
+
+        auto operator=(const overload_delegate_core&) noexcept -> overload_delegate_core& = delete;
+        auto operator=(overload_delegate_core&& orig) noexcept -> overload_delegate_core& {
+            overload_delegate_core{std::move(orig)}.swap(*this);
+            return *this;
+        }
+
+        explicit operator bool() const noexcept {
+            return ops_ != empty_ops();
+        }
+
+        template<std::size_t index, typename... Args>
+        auto invoke(Args&&... args) const -> decltype(auto) {
+            return (*std::get<index>(ops_->invoke))(storage_, std::forward<Args>(args)...);
+        }
+
+        void swap(overload_delegate_core& other) noexcept {
+            using std::swap;
+            swap(storage_, other.storage_);
+            swap(ops_, other.ops_);
+        }
+
+        void drop_target() noexcept {
+            overload_delegate_core{}.swap(*this);
+        }
+
+        // Returns the address of the assigned function object if it is of type `Functor`, or
+        // nullptr otherwise.
+        template<typename Functor>
+        auto target() const noexcept -> Functor* {
+            if (ops_ != overload_delegate::functor_ops<Functor, Signatures...>()) {
+                return nullptr;
+            }
+            return delegate::stored_functor<Functor>::address(storage_);
+        }
+
+        // Does not store the stateless function object constructed from `args`. It is recreated
+        // on each call.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<delegate::is_stateless<Functor>, int> = 0>
+        void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            (void)Functor(std::forward<CtorArgs>(args)...);
+            ops_ = overload_delegate::functor_ops<Functor, Signatures...>();
+        }
+
+        // Constructs the function object from `args` inside the local storage.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+            // NOLINTNEXTLINE(bugprone-multi-level-implicit-pointer-conversion)
+            (void)::new (&storage_) Functor(std::forward<CtorArgs>(args)...);
+            ops_ = overload_delegate::functor_ops<Functor, Signatures...>();
+        }
+
+        // Constructs the function object from `args` in a dynamically allocated storage.
+        template<typename Functor, typename... CtorArgs,
+            std::enable_if_t<!delegate::is_stateless<Functor>
+                                 && !delegate::is_small_object_optimizable<Functor>,
+                int> = 0>
+        void emplace(CtorArgs&&... args) {
+            storage_ = new Functor(std::forward<CtorArgs>(args)...);
+            ops_     = overload_delegate::functor_ops<Functor, Signatures...>();
+        }
+    };
+
+
+    // Provides common overload delegate behavior using the 'curiously recurring template pattern',
+    // like `base_delegate`.
+    template<typename DerivedDelegate>
+    class base_overload_delegate;
+
+    template<typename Behavior, typename... Signatures>
+    class base_overload_delegate<rome::basic_overload_delegate<Behavior, Signatures...>>
+        : public overload_delegate::call_operators<
+              rome::basic_overload_delegate<Behavior, Signatures...>, 0, Signatures...> {
+        using delegate_type = rome::basic_overload_delegate<Behavior, Signatures...>;
+        using core_type     = overload_delegate_core<
+            !std::is_same<Behavior, target_is_optional>::value, Signatures...>;
+        core_type core_ = {};
+
+        template<typename, std::size_t, typename...>
+        friend class overload_delegate::call_operators;
+
+        template<std::size_t index, typename... Args>
+        auto invoke(Args&&... args) const -> decltype(auto) {
+            return core_.template invoke<index>(std::forward<Args>(args)...);
+        }
+
+        template<typename F>
+        static constexpr void assert_target_type() noexcept {
+            static_assert(std::is_class<F>::value && std::is_same<F, std::decay_t<F>>::value,
+                "Invalid target type 'F'. The type must be the decayed type of a function object "
+                "(a class type with a function call operator, e.g. a lambda).");
+            static_assert(
+                delegate::all_of<delegate::is_callable_by<F, Signatures>...>,
+                "Invalid target type 'F'. The function call signatures of the type must be "
+                "compatible with all signatures of the overload delegate.");
+        }
+
+      public:
+        base_overload_delegate() noexcept = default;
+
+        explicit operator bool() const noexcept {
+            return core_.operator bool();
+        }
+
+        void swap(delegate_type& other) noexcept {
+            core_.swap(other.core_);
+        }
+
+        void drop_target() noexcept {
+            core_.drop_target();
+        }
+
+        // Returns a pointer to the target if it is a function object of type `F`, nullptr
+        // otherwise.
+        template<typename F>
+        auto target() noexcept -> F* {
+            assert_target_type<F>();
+            return core_.template target<F>();
+        }
+
+        template<typename F>
+        auto target() const noexcept -> const F* {
+            assert_target_type<F>();
+            return core_.template target<F>();
+        }
+
+        // Replaces the target by a function object of type `F` constructed in place from `args`.
+        // The current target is kept if the construction throws.
+        template<typename F, typename... CtorArgs>
+        auto emplace(CtorArgs&&... args) noexcept(noexcept(
+            std::declval<core_type&>().template emplace<F>(std::forward<CtorArgs>(args)...)))
+            -> F& {
+            assert_target_type<F>();
+            core_type core;
+            core.template emplace<F>(std::forward<CtorArgs>(args)...);
+            core_.swap(core);
+            return *core_.template target<F>();
+        }
+    };
+}  // namespace detail
+
+
+// Stores one function object and calls it through one of several function call signatures,
+// selected by overload resolution. See the documentation in `doc/overload_delegate.md`.
+template<typename Behavior, typename... Signatures>
+class basic_overload_delegate
+    : public detail::base_overload_delegate<basic_overload_delegate<Behavior, Signatures...>> {
+    static_assert(sizeof...(Signatures) > 0,
+        "Invalid parameter 'Signatures'. At least one signature is required.");
+    static_assert(
+        detail::delegate::all_of<
+            detail::overload_delegate::is_signature<Signatures>::value...>,
+        "Invalid parameter 'Signatures'. All template parameters 'Signatures' must be valid "
+        "function signatures.");
+    static_assert(detail::delegate::is_behavior<Behavior>,
+        "Invalid parameter 'Behavior'. The template parameter 'Behavior' must either be empty or "
+        "contain one of the types 'rome::target_is_optional', 'rome::target_is_expected' or "
+        "'rome::target_is_mandatory'.");
+    static_assert(!std::is_same<Behavior, target_is_optional>::value
+                      || detail::delegate::all_of<
+                          detail::overload_delegate::returns_void<Signatures>::value...>,
+        "Return type coflicts with parameter 'Behavior'. The parameter 'Behavior' is only "
+        "allowed to be 'rome::target_is_optional' if the return types of all signatures are "
+        "'void'.");
+
+    using base_type = detail::base_overload_delegate<basic_overload_delegate>;
+
+  public:
+    basic_overload_delegate() noexcept                               = default;
+    basic_overload_delegate(const basic_overload_delegate&) noexcept = delete;
+    basic_overload_delegate(basic_overload_delegate&&) noexcept      = default;
+    ~basic_overload_delegate()                                       = default;
+
+    auto operator=(const basic_overload_delegate&) noexcept -> basic_overload_delegate& = delete;
+    auto operator=(basic_overload_delegate&&) noexcept -> basic_overload_delegate&      = default;
+
+    // Construct from a function object target.
+    // SFINAE to prevent hiding the constructors
+    // `basic_overload_delegate(basic_overload_delegate&&)`,
+    // `basic_overload_delegate(std::nullptr_t)` and
+    // `basic_overload_delegate(in_place_type_t<F>, args...)`, and to leave the overload
+    // resolution to other constructors for objects that are not callable by all signatures.
+    template<typename Functor,
+        std::enable_if_t<!std::is_same<basic_overload_delegate, std::decay_t<Functor>>::value
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>
+                             && detail::overload_delegate::is_function_object_for<
+                                 std::decay_t<Functor>, Signatures...>,
+            int> = 0>
+    basic_overload_delegate(Functor&& functor) noexcept(
+        noexcept(std::declval<base_type&>().template emplace<std::decay_t<Functor>>(
+            std::forward<Functor>(functor)))) {
+        (void)base_type::template emplace<std::decay_t<Functor>>(std::forward<Functor>(functor));
+    }
+
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    explicit basic_overload_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(std::declval<base_type&>().template emplace<F>(std::forward<CtorArgs>(args)...))) {
+        (void)base_type::template emplace<F>(std::forward<CtorArgs>(args)...);
+    }
+
+    basic_overload_delegate(std::nullptr_t) noexcept : basic_overload_delegate{} {
+    }
+    auto operator=(std::nullptr_t) noexcept -> basic_overload_delegate& {
+        base_type::drop_target();
+        return *this;
+    }
+
+    friend auto operator==(const basic_overload_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend auto operator==(std::nullptr_t, const basic_overload_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend auto operator!=(const basic_overload_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend auto operator!=(std::nullptr_t, const basic_overload_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+template<typename... Signatures>
+class basic_overload_delegate<target_is_mandatory, Signatures...>
+    : public detail::base_overload_delegate<
+          basic_overload_delegate<target_is_mandatory, Signatures...>> {
+    static_assert(sizeof...(Signatures) > 0,
+        "Invalid parameter 'Signatures'. At least one signature is required.");
+    static_assert(
+        detail::delegate::all_of<
+            detail::overload_delegate::is_signature<Signatures>::value...>,
+        "Invalid parameter 'Signatures'. All template parameters 'Signatures' must be valid "
+        "function signatures.");
+
+    using base_type = detail::base_overload_delegate<basic_overload_delegate>;
+
+  public:
+    basic_overload_delegate() noexcept                               = delete;
+    basic_overload_delegate(const basic_overload_delegate&) noexcept = delete;
+    basic_overload_delegate(basic_overload_delegate&&) noexcept      = default;
+    ~basic_overload_delegate()                                       = default;
+
+    auto operator=(const basic_overload_delegate&) noexcept -> basic_overload_delegate& = delete;
+    auto operator=(basic_overload_delegate&&) noexcept -> basic_overload_delegate&      = default;
+
+    // Construct from a function object target.
+    // SFINAE to prevent hiding the constructors
+    // `basic_overload_delegate(basic_overload_delegate&&)`,
+    // `basic_overload_delegate(std::nullptr_t)` and
+    // `basic_overload_delegate(in_place_type_t<F>, args...)`, and to leave the overload
+    // resolution to other constructors for objects that are not callable by all signatures.
+    template<typename Functor,
+        std::enable_if_t<!std::is_same<basic_overload_delegate, std::decay_t<Functor>>::value
+                             && !std::is_same<std::nullptr_t, std::decay_t<Functor>>::value
+                             && !detail::delegate::is_in_place_type<std::decay_t<Functor>>
+                             && detail::overload_delegate::is_function_object_for<
+                                 std::decay_t<Functor>, Signatures...>,
+            int> = 0>
+    basic_overload_delegate(Functor&& functor) noexcept(
+        noexcept(std::declval<base_type&>().template emplace<std::decay_t<Functor>>(
+            std::forward<Functor>(functor)))) {
+        (void)base_type::template emplace<std::decay_t<Functor>>(std::forward<Functor>(functor));
+    }
+
+    // Construct with a function object target of type `F` constructed in place from `args`.
+    template<typename F, typename... CtorArgs>
+    explicit basic_overload_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        noexcept(std::declval<base_type&>().template emplace<F>(std::forward<CtorArgs>(args)...))) {
+        (void)base_type::template emplace<F>(std::forward<CtorArgs>(args)...);
+    }
+
+    friend auto operator==(const basic_overload_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return !lhs;
+    }
+    friend auto operator==(std::nullptr_t, const basic_overload_delegate& rhs) noexcept -> bool {
+        return !rhs;
+    }
+    friend auto operator!=(const basic_overload_delegate& lhs, std::nullptr_t) noexcept -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend auto operator!=(std::nullptr_t, const basic_overload_delegate& rhs) noexcept -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+
+// A `rome::basic_overload_delegate`, where the first of `BehaviorAndSignatures...` is taken as the
+// `Behavior` if it is one of `rome::target_is_expected`, `rome::target_is_optional` or
+// `rome::target_is_mandatory`. Otherwise, `Behavior` is `rome::target_is_expected`. See the
+// documentation in `doc/overload_delegate.md`.
+template<typename... BehaviorAndSignatures>
+using overload_delegate = typename detail::overload_delegate::select_type<
+    detail::overload_delegate::starts_with_behavior<BehaviorAndSignatures...>::value,
+    BehaviorAndSignatures...>::type;
+
+}  // namespace rome
+
+#endif  // ROME_OVERLOAD_DELEGATE_HPP
@@ -0,0 +1,289 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::parallel_event<void(Args...)>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_PARALLEL_EVENT_HPP
+#define ROME_PARALLEL_EVENT_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rome {
+
+// Calls event delegates concurrently, in the calling thread and in tasks posted to an executor,
+// and returns when all event delegates have returned. As the arguments of an event delegate are
+// immutable, all event delegates can read them at the same time. See the documentation in
+// `doc/parallel_event.md`.
+template<typename Signature>
+class parallel_event {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with return type 'void'.");
+};
+
+template<typename... Args>
+class parallel_event<void(Args...)> {
+    static_assert(detail::delegate::none_of<std::is_rvalue_reference<Args>::value...>,
+        "Invalid parameter 'Signature'. The argument types must not be rvalue references, as the "
+        "arguments are passed to several event delegates.");
+
+  public:
+    using delegate_type = event_delegate<void(Args...)>;
+    // The task posted to the executor to help calling the event delegates.
+    using task_type = command_delegate<void()>;
+    // Posts a task to the executor. Shall not throw.
+    using executor_type = command_delegate<void(task_type&&)>;
+
+  private:
+    // The state of one call, shared by the calling thread and the tasks it posted. The event
+    // delegates are split into chunks, each thread claims the next chunk until none is left.
+    // Allocated on the heap and reference counted by the call and its tasks, as a task may start
+    // after the call has returned, e.g. if all threads of the executor were busy. Such a task
+    // only drops its reference. The state of the last call is kept for reuse by the next one.
+    class emission {
+        // Added to the count of started tasks once the call no longer waits for further tasks.
+        static constexpr std::size_t closed = ~(~std::size_t{0} >> 1U);
+
+        const std::vector<delegate_type>* delegates_ = nullptr;
+        const std::tuple<Args&...>* arguments_       = nullptr;
+        std::size_t chunkSize_                       = 1U;
+        std::atomic<std::size_t> next_{0U};
+        std::atomic<std::size_t> references_{0U};
+        std::atomic<std::size_t> started_{0U};  // the number of tasks started, plus `closed`
+        std::atomic<std::size_t> finished_{0U};
+        std::atomic<bool> failed_{false};
+        std::exception_ptr exception_;
+
+        template<std::size_t... indices>
+        void call_chunks(std::index_sequence<indices...> /*unused*/) {
+            const auto& delegates = *delegates_;
+            const auto count      = delegates.size();
+            auto first            = next_.fetch_add(chunkSize_, std::memory_order_relaxed);
+            while (first < count) {
+                const auto last = (std::min)(first + chunkSize_, count);
+                for (auto i = first; i < last; ++i) {
+                    delegates[i](std::get<indices>(*arguments_)...);
+                }
+                first = next_.fetch_add(chunkSize_, std::memory_order_relaxed);
+            }
+        }
+
+      public:
+        // Prepares the emission for a call posting `tasks` tasks. The emission shall not be
+        // referenced by another call or task.
+        void start(const std::vector<delegate_type>& delegates,
+            const std::tuple<Args&...>& arguments, const std::size_t chunkSize,
+            const std::size_t tasks) noexcept {
+            delegates_ = &delegates;
+            arguments_ = &arguments;
+            chunkSize_ = chunkSize;
+            next_.store(0U, std::memory_order_relaxed);
+            references_.store(tasks + 1, std::memory_order_relaxed);
+            started_.store(0U, std::memory_order_relaxed);
+            finished_.store(0U, std::memory_order_relaxed);
+            failed_.store(false, std::memory_order_relaxed);
+        }
+
+        // Calls the event delegates of the chunks not yet claimed. If an event delegate throws,
+        // the first exception is kept and no further chunks are claimed.
+        void run() noexcept {
+#if (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+            try {
+                call_chunks(std::index_sequence_for<Args...>{});
+            } catch (...) {
+                next_.store(delegates_->size(), std::memory_order_relaxed);
+                if (!failed_.exchange(true, std::memory_order_relaxed)) {
+                    exception_ = std::current_exception();
+                }
+            }
+#else
+            call_chunks(std::index_sequence_for<Args...>{});
+#endif
+        }
+
+        // The posted task. Calls event delegates only if the call still waits for its tasks.
+        void run_task() noexcept {
+            if (started_.fetch_add(1U, std::memory_order_acquire) < closed) {
+                run();
+                finished_.fetch_add(1U, std::memory_order_release);
+            }
+            if (release()) {
+                delete this;  // NOLINT(cppcoreguidelines-owning-memory)
+            }
+        }
+
+        // Stops tasks not yet started from calling event delegates, waits until the started tasks
+        // have finished and returns the first exception thrown by an event delegate, if any.
+        auto finish() noexcept -> std::exception_ptr {
+            const auto started = started_.exchange(closed, std::memory_order_acq_rel);
+            while (finished_.load(std::memory_order_acquire) != started) {
+                std::this_thread::yield();
+            }
+            std::exception_ptr exception;
+            if (failed_.load(std::memory_order_relaxed)) {
+                exception  = exception_;
+                exception_ = nullptr;
+            }
+            return exception;
+        }
+
+        // Drops a reference. Returns whether it was the last one.
+        auto release() noexcept -> bool {
+            return references_.fetch_sub(1U, std::memory_order_acq_rel) == 1U;
+        }
+    };
+
+    std::vector<delegate_type> delegates_;
+    executor_type executor_;
+    std::size_t concurrency_;
+    // The emission of the last call, if no task referenced it anymore when the call returned.
+    mutable std::atomic<emission*> spare_{nullptr};
+
+    void post(emission& state) const noexcept {
+        executor_(task_type::template create<emission, &emission::run_task>(state));
+    }
+
+    auto acquire_emission() const -> emission& {
+        auto* const state = spare_.exchange(nullptr, std::memory_order_acquire);
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        return (state != nullptr) ? *state : *new emission{};
+    }
+
+    // Drops the reference of the call. Keeps the emission for reuse if no task references it
+    // anymore, otherwise the last task deletes it.
+    void release_emission(emission& state) const noexcept {
+        if (state.release()) {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            delete spare_.exchange(&state, std::memory_order_acq_rel);
+        }
+    }
+
+  public:
+    // Creates a parallel event whose event delegates are called by at most `concurrency` threads
+    // at a time, the calling thread and `concurrency - 1` tasks posted by `executor`.
+    template<typename E>
+    parallel_event(E&& executor, const std::size_t concurrency)
+        : executor_{std::forward<E>(executor)}
+        , concurrency_{(std::max)(concurrency, std::size_t{1})} {
+    }
+
+    parallel_event(const parallel_event&) = delete;
+    // The event delegates are moved with parentheses, as braces would take the vector as the
+    // target of one event delegate.
+    parallel_event(parallel_event&& orig) noexcept
+        : delegates_(std::move(orig.delegates_))
+        , executor_{std::move(orig.executor_)}
+        , concurrency_{orig.concurrency_}
+        , spare_{orig.spare_.exchange(nullptr, std::memory_order_relaxed)} {
+    }
+
+    ~parallel_event() {
+        delete spare_.load(std::memory_order_acquire);  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    auto operator=(const parallel_event&) -> parallel_event& = delete;
+    auto operator=(parallel_event&& orig) noexcept -> parallel_event& {
+        delegates_   = std::move(orig.delegates_);
+        executor_    = std::move(orig.executor_);
+        concurrency_ = orig.concurrency_;
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        delete spare_.exchange(
+            orig.spare_.exchange(nullptr, std::memory_order_relaxed), std::memory_order_acq_rel);
+        return *this;
+    }
+
+    auto size() const noexcept -> std::size_t {
+        return delegates_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+        return delegates_.empty();
+    }
+
+    auto concurrency() const noexcept -> std::size_t {
+        return concurrency_;
+    }
+
+    void reserve(const std::size_t capacity) {
+        delegates_.reserve(capacity);
+    }
+
+    void clear() noexcept {
+        delegates_.clear();
+    }
+
+    // Appends the event delegate created from `target`, e.g. a function object or a
+    // `rome::event_delegate`. An empty event delegate is not appended. Returns whether the target
+    // was appended.
+    template<typename T>
+    auto push_back(T&& target) -> bool {
+        delegate_type dgt{std::forward<T>(target)};
+        if (!dgt) {
+            return false;
+        }
+        delegates_.push_back(std::move(dgt));
+        return true;
+    }
+
+    // Calls all event delegates with the same arguments, concurrently and in unspecified order.
+    // Posts up to `concurrency() - 1` tasks, the calling thread calls event delegates too, and
+    // waits until the posted tasks that have started have finished. Tasks starting later do not
+    // call event delegates, so the call does not wait for busy threads of the executor, e.g. if
+    // called by one of them. If event delegates throw, the first exception is rethrown, some of
+    // the other event delegates may not be called. Event delegates shall not be appended or
+    // removed during the call.
+    void operator()(Args... args) const {
+        if (delegates_.empty()) {
+            return;
+        }
+
+        // about four chunks for each thread balance the load if the event delegates take
+        // different times
+        const auto count     = delegates_.size();
+        const auto chunkSize = (std::max)(count / (4 * concurrency_), std::size_t{1});
+        const auto chunks    = (count + chunkSize - 1) / chunkSize;
+        const auto tasks     = (std::min)(concurrency_, chunks) - 1;
+        if (tasks == 0U) {
+            for (const auto& dgt : delegates_) {
+                dgt(args...);
+            }
+            return;
+        }
+
+        const std::tuple<Args&...> arguments{args...};
+        auto& state = acquire_emission();
+        state.start(delegates_, arguments, chunkSize, tasks);
+        for (std::size_t i = 0; i < tasks; ++i) {
+            post(state);
+        }
+        state.run();
+        const auto exception = state.finish();
+        release_emission(state);
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_PARALLEL_EVENT_HPP
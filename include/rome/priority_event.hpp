@@ -0,0 +1,273 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::priority_event<void(Args...)>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_PRIORITY_EVENT_HPP
+#define ROME_PRIORITY_EVENT_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace rome {
+
+namespace detail {
+    namespace priority_event {
+        // Position of an event delegate in the calling order. Higher priorities are called first,
+        // event delegates with the same priority in the order of their connection.
+        struct key {
+            int priority;
+            std::uint64_t sequence;
+
+            friend constexpr auto operator<(const key& lhs, const key& rhs) noexcept -> bool {
+                return lhs.priority > rhs.priority
+                       || (lhs.priority == rhs.priority && lhs.sequence < rhs.sequence);
+            }
+        };
+    }  // namespace priority_event
+}  // namespace detail
+
+
+// Calls event delegates ordered by priority. The calling order is kept sorted in a flat array, so
+// that the calls iterate it without any sorting. See the documentation in
+// `doc/priority_event.md`.
+template<typename Signature>
+class priority_event {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter 'Signature' must be a function "
+        "signature with return type 'void'.");
+};
+
+template<typename... Args>
+class priority_event<void(Args...)> {
+    using key = detail::priority_event::key;
+
+  public:
+    using delegate_type = event_delegate<void(Args...)>;
+
+    // Identifies a connected event delegate by its slot and its connection sequence number, which
+    // do not change with its priority. Is trivially copyable and stays safe to use after the
+    // event delegate is disconnected.
+    class connection {
+        std::uint32_t slot_     = ~std::uint32_t{0};
+        std::uint64_t sequence_ = 0U;
+
+        friend class priority_event;
+
+        constexpr connection(const std::uint32_t slot, const std::uint64_t sequence) noexcept
+            : slot_{slot}, sequence_{sequence} {
+        }
+
+      public:
+        constexpr connection() noexcept = default;
+
+        friend constexpr auto operator==(const connection& lhs, const connection& rhs) noexcept
+            -> bool {
+            return lhs.slot_ == rhs.slot_ && lhs.sequence_ == rhs.sequence_;
+        }
+        friend constexpr auto operator!=(const connection& lhs, const connection& rhs) noexcept
+            -> bool {
+            return !(lhs == rhs);
+        }
+    };
+
+  private:
+    static constexpr std::uint32_t invalidIndex = ~std::uint32_t{0};
+
+    // The event delegates stay in their slots, `order_` holds the slot indices in calling order.
+    // Thus, connecting and reprioritizing only move trivially copyable indices and keys.
+    std::vector<delegate_type> delegates_;
+    std::vector<key> slotKeys_;  // the key of each slot, with sequence 0 if the slot is free
+    std::vector<std::uint32_t> freeSlots_;
+    std::vector<key> keys_;  // sorted, the key of each entry in `order_`
+    std::vector<std::uint32_t> order_;
+    std::uint64_t lastSequence_ = 0U;
+
+    // Returns the position of `k` in the calling order, or the position where it would be
+    // inserted.
+    auto position_of(const key k) const noexcept -> std::size_t {
+        return static_cast<std::size_t>(
+            std::lower_bound(keys_.begin(), keys_.end(), k) - keys_.begin());
+    }
+
+    // Returns whether the event delegate of `conn` is still connected to its slot.
+    auto is_connected(const connection conn) const noexcept -> bool {
+        return conn.slot_ < slotKeys_.size() && conn.sequence_ != 0U
+               && slotKeys_[conn.slot_].sequence == conn.sequence_;
+    }
+
+    // Returns the position of the event delegate of `conn`, or `size()` if it is not connected.
+    auto find_position(const connection conn) const noexcept -> std::size_t {
+        return is_connected(conn) ? position_of(slotKeys_[conn.slot_]) : size();
+    }
+
+    // Ensures that connecting one more event delegate does not throw, except for the creation of
+    // the event delegate itself.
+    void reserve_one_more() {
+        if (size() == keys_.capacity() || size() == order_.capacity()
+            || (freeSlots_.empty()
+                && (delegates_.size() == delegates_.capacity()
+                    || slotKeys_.size() == slotKeys_.capacity()))) {
+            reserve(std::max<std::size_t>(2 * size(), 4));
+        }
+    }
+
+    // Moves the element at `from` to `to`, shifting the elements between them by one.
+    template<typename T>
+    static void move_element(
+        std::vector<T>& values, const std::size_t from, const std::size_t to) noexcept {
+        const auto first = values.begin();
+        const auto pFrom = first + static_cast<std::ptrdiff_t>(from);
+        const auto pTo   = first + static_cast<std::ptrdiff_t>(to);
+        if (from < to) {
+            (void)std::rotate(pFrom, std::next(pFrom), std::next(pTo));
+        } else if (to < from) {
+            (void)std::rotate(pTo, pFrom, std::next(pFrom));
+        }
+    }
+
+  public:
+    priority_event() noexcept                      = default;
+    priority_event(const priority_event&) noexcept = delete;
+    priority_event(priority_event&&) noexcept      = default;
+    ~priority_event()                              = default;
+
+    auto operator=(const priority_event&) noexcept -> priority_event& = delete;
+    auto operator=(priority_event&&) noexcept -> priority_event&      = default;
+
+    auto size() const noexcept -> std::size_t {
+        return order_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+        return order_.empty();
+    }
+
+    // Reserves memory for `capacity` event delegates, so that connecting them does not allocate.
+    void reserve(const std::size_t capacity) {
+        delegates_.reserve(capacity);
+        slotKeys_.reserve(capacity);
+        freeSlots_.reserve(capacity);
+        keys_.reserve(capacity);
+        order_.reserve(capacity);
+    }
+
+    // Connects the event delegate created from `target`, e.g. a function object or a
+    // `rome::event_delegate`, with `priority`. It is called after all event delegates with a
+    // higher priority or with the same priority connected before. Leaves the event unchanged if
+    // the creation throws.
+    template<typename T>
+    auto connect(T&& target, const int priority = 0) -> connection {
+        reserve_one_more();
+        delegate_type dgt{std::forward<T>(target)};
+
+        const key k{priority, ++lastSequence_};
+        auto slot = invalidIndex;
+        if (freeSlots_.empty()) {
+            slot = static_cast<std::uint32_t>(delegates_.size());
+            delegates_.push_back(std::move(dgt));
+            slotKeys_.push_back(k);
+        } else {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+            delegates_[slot] = std::move(dgt);
+            slotKeys_[slot]  = k;
+        }
+
+        const auto pos = static_cast<std::ptrdiff_t>(position_of(k));
+        (void)keys_.insert(keys_.begin() + pos, k);
+        (void)order_.insert(order_.begin() + pos, slot);
+        return connection{slot, k.sequence};
+    }
+
+    // Returns whether the event delegate of `conn` is connected.
+    auto contains(const connection conn) const noexcept -> bool {
+        return is_connected(conn);
+    }
+
+    // Returns the priority of the event delegate of `conn`, or 0 if it is not connected.
+    auto priority(const connection conn) const noexcept -> int {
+        return is_connected(conn) ? slotKeys_[conn.slot_].priority : 0;
+    }
+
+    // Disconnects the event delegate of `conn`. Returns false if it was not connected.
+    auto disconnect(const connection conn) noexcept -> bool {
+        const auto pos = find_position(conn);
+        if (pos == size()) {
+            return false;
+        }
+        const auto slot          = order_[pos];
+        delegates_[slot]         = nullptr;
+        slotKeys_[slot].sequence = 0U;
+        freeSlots_.push_back(slot);
+        (void)keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(pos));
+        (void)order_.erase(order_.begin() + static_cast<std::ptrdiff_t>(pos));
+        return true;
+    }
+
+    // Changes the priority of the event delegate of `conn`. The event delegate keeps its position
+    // relative to the event delegates with the new priority as if it was connected with it. Only
+    // the entries of the calling order between the old and the new position are moved. `conn`
+    // and all copies of it stay valid. Returns false if it was not connected.
+    auto set_priority(const connection conn, const int priority) noexcept -> bool {
+        const auto from = find_position(conn);
+        if (from == size()) {
+            return false;
+        }
+        const key k{priority, conn.sequence_};
+        keys_[from]           = k;
+        slotKeys_[conn.slot_] = k;
+
+        // the other keys are still sorted, search them for the new position
+        using diff       = std::ptrdiff_t;
+        const auto first = keys_.begin();
+        auto to          = from;
+        if (from > 0 && k < keys_[from - 1]) {
+            to = static_cast<std::size_t>(
+                std::upper_bound(first, first + static_cast<diff>(from), k) - first);
+        } else if (from + 1 < size() && keys_[from + 1] < k) {
+            const auto next =
+                std::lower_bound(first + static_cast<diff>(from + 1), keys_.end(), k);
+            to = static_cast<std::size_t>(next - first) - 1;
+        }
+        move_element(keys_, from, to);
+        move_element(order_, from, to);
+        return true;
+    }
+
+    // Disconnects all event delegates.
+    void clear() noexcept {
+        delegates_.clear();
+        slotKeys_.clear();
+        freeSlots_.clear();
+        keys_.clear();
+        order_.clear();
+    }
+
+    // Calls all connected event delegates by descending priority. Event delegates shall not be
+    // connected, disconnected or reprioritized during the call.
+    void operator()(Args... args) const {
+        for (const auto slot : order_) {
+            delegates_[slot](args...);
+        }
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_PRIORITY_EVENT_HPP
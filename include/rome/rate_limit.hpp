@@ -0,0 +1,220 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::throttled<fwd_delegate<void(Args...), Behavior>, Clock>
+//   - rome::debounced<fwd_delegate<void(Args...), Behavior>, Clock>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_RATE_LIMIT_HPP
+#define ROME_RATE_LIMIT_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+// Forwards a call to its `rome::fwd_delegate` only if at least the interval has passed since the
+// last forwarded call, other calls are dropped. `Clock` provides the time by `Clock::now()`, like
+// the clocks of `std::chrono`. See the documentation in `doc/rate_limit.md`.
+template<typename Delegate, typename Clock = std::chrono::steady_clock>
+class throttled {
+    static_assert(detail::delegate::invalid<Delegate>,
+        "Invalid parameter 'Delegate'. The template parameter 'Delegate' must be a "
+        "'rome::fwd_delegate<void(Args...), Behavior>'.");
+};
+
+template<typename... Args, typename Behavior, typename Clock>
+class throttled<fwd_delegate<void(Args...), Behavior>, Clock> {
+  public:
+    using delegate_type = fwd_delegate<void(Args...), Behavior>;
+    using clock         = Clock;
+    using duration      = typename Clock::duration;
+    using time_point    = typename Clock::time_point;
+
+  private:
+    delegate_type delegate_;
+    duration interval_;
+    time_point next_ = (time_point::min)();
+
+  public:
+    // Creates a throttled delegate with an empty `rome::fwd_delegate`.
+    explicit throttled(const duration interval) noexcept : interval_{interval} {
+    }
+
+    // Creates a throttled delegate with its `rome::fwd_delegate` created from `target`, e.g. a
+    // function object or a `rome::fwd_delegate`.
+    template<typename T>
+    throttled(const duration interval, T&& target) noexcept(
+        std::is_nothrow_constructible<delegate_type, T>::value)
+        : delegate_{std::forward<T>(target)}, interval_{interval} {
+    }
+
+    auto delegate() noexcept -> delegate_type& {
+        return delegate_;
+    }
+
+    auto delegate() const noexcept -> const delegate_type& {
+        return delegate_;
+    }
+
+    auto interval() const noexcept -> duration {
+        return interval_;
+    }
+
+    // Forwards the next call independent of the time passed.
+    void reset() noexcept {
+        next_ = (time_point::min)();
+    }
+
+    // Forwards the call if the interval has passed since the last forwarded call. Returns whether
+    // the call was forwarded. Reads the clock once. If the `rome::fwd_delegate` is empty and
+    // `Behavior` is `rome::target_is_expected`, throws `rome::bad_delegate_call` without
+    // starting the interval.
+    auto operator()(Args... args) -> bool {
+        const auto now = Clock::now();
+        if (now < next_) {
+            return false;
+        }
+        if (std::is_same<Behavior, target_is_expected>::value && !delegate_) {
+            detail::delegate::throw_bad_delegate_call();
+        }
+        next_ = now + interval_;
+        delegate_(std::forward<Args>(args)...);
+        return true;
+    }
+};
+
+
+// Forwards the newest arguments to its `rome::fwd_delegate` once no call happened for the quiet
+// time. Stores the arguments of each call, replacing the ones before, and forwards them when
+// polled after the quiet time. `Clock` provides the time by `Clock::now()`, like the clocks of
+// `std::chrono`. See the documentation in `doc/rate_limit.md`.
+template<typename Delegate, typename Clock = std::chrono::steady_clock>
+class debounced {
+    static_assert(detail::delegate::invalid<Delegate>,
+        "Invalid parameter 'Delegate'. The template parameter 'Delegate' must be a "
+        "'rome::fwd_delegate<void(Args...), Behavior>'.");
+};
+
+template<typename... Args, typename Behavior, typename Clock>
+class debounced<fwd_delegate<void(Args...), Behavior>, Clock> {
+    static_assert(detail::delegate::all_of<detail::delegate::is_storable<Args>...>,
+        "Invalid parameter 'Delegate'. The decayed argument types must be default constructible "
+        "and assignable from the arguments.");
+
+  public:
+    using delegate_type = fwd_delegate<void(Args...), Behavior>;
+    using clock         = Clock;
+    using duration      = typename Clock::duration;
+    using time_point    = typename Clock::time_point;
+
+  private:
+    using arguments_type = std::tuple<std::decay_t<Args>...>;
+
+    delegate_type delegate_;
+    duration quietTime_;
+    time_point deadline_ = {};
+    bool pending_        = false;
+    arguments_type arguments_;
+
+    static constexpr bool isNothrowClearable =
+        std::is_nothrow_default_constructible<arguments_type>::value
+        && std::is_nothrow_move_assignable<arguments_type>::value;
+
+    // Forwards the stored arguments and drops them afterwards, also if the target throws, so that
+    // the objects passed are not kept alive until the next call.
+    template<std::size_t... indices>
+    void call(std::index_sequence<indices...> /*unused*/) {
+        struct clear {
+            arguments_type& arguments;
+            ~clear() {
+                arguments = arguments_type{};
+            }
+        } const clearArguments{arguments_};
+        delegate_(static_cast<Args&&>(std::get<indices>(arguments_))...);
+    }
+
+  public:
+    // Creates a debounced delegate with an empty `rome::fwd_delegate`.
+    explicit debounced(const duration quietTime) noexcept : quietTime_{quietTime} {
+    }
+
+    // Creates a debounced delegate with its `rome::fwd_delegate` created from `target`, e.g. a
+    // function object or a `rome::fwd_delegate`.
+    template<typename T>
+    debounced(const duration quietTime, T&& target) noexcept(
+        std::is_nothrow_constructible<delegate_type, T>::value)
+        : delegate_{std::forward<T>(target)}, quietTime_{quietTime} {
+    }
+
+    auto delegate() noexcept -> delegate_type& {
+        return delegate_;
+    }
+
+    auto delegate() const noexcept -> const delegate_type& {
+        return delegate_;
+    }
+
+    auto quiet_time() const noexcept -> duration {
+        return quietTime_;
+    }
+
+    // Returns whether there are stored arguments not yet forwarded.
+    auto pending() const noexcept -> bool {
+        return pending_;
+    }
+
+    // Drops the stored arguments.
+    void cancel() noexcept(isNothrowClearable) {
+        if (pending_) {
+            pending_   = false;
+            arguments_ = arguments_type{};
+        }
+    }
+
+    // Stores the arguments, replacing the ones not yet forwarded, and restarts the quiet time.
+    // Reads the clock once.
+    void operator()(Args... args) noexcept(
+        std::is_nothrow_assignable<arguments_type&, std::tuple<Args&&...>>::value) {
+        arguments_ = std::forward_as_tuple(std::forward<Args>(args)...);
+        deadline_  = Clock::now() + quietTime_;
+        pending_   = true;
+    }
+
+    // Forwards the stored arguments if the quiet time has passed since the last call. Returns
+    // whether the arguments were forwarded. Reads the clock once if there are stored arguments.
+    auto poll() -> bool {
+        if (!pending_ || Clock::now() < deadline_) {
+            return false;
+        }
+        return flush();
+    }
+
+    // Forwards the stored arguments without waiting for the quiet time. Returns whether there were
+    // stored arguments.
+    auto flush() -> bool {
+        if (!pending_) {
+            return false;
+        }
+        pending_ = false;
+        call(std::index_sequence_for<Args...>{});
+        return true;
+    }
+};
+
+}  // namespace rome
+
+#endif  // ROME_RATE_LIMIT_HPP
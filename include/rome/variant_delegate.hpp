@@ -0,0 +1,453 @@
+//
+// Project: C++ delegates
+// File content:
+//   - rome::basic_variant_delegate<Ret(Args...), Behavior, Targets...>
+//   - rome::variant_delegate<Ret(Args...), [Behavior,] Targets...>
+// See the documentation in folder `doc` for more information.
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ROME_VARIANT_DELEGATE_HPP
+#define ROME_VARIANT_DELEGATE_HPP
+
+#pragma once
+
+#include <rome/delegate.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rome {
+
+template<typename Signature, typename Behavior, typename... Targets>
+class basic_variant_delegate;
+
+namespace detail {
+    namespace variant_delegate {
+        // Returns the 1-based position of `T` in `Targets...`, or 0 if `T` is not part of it.
+        template<typename T, typename... Targets>
+        struct index_of;
+
+        template<typename T>
+        struct index_of<T> : std::integral_constant<std::size_t, 0> {};
+
+        template<typename T, typename... Targets>
+        struct index_of<T, T, Targets...> : std::integral_constant<std::size_t, 1> {};
+
+        template<typename T, typename First, typename... Targets>
+        struct index_of<T, First, Targets...>
+            : std::integral_constant<std::size_t,
+                  (index_of<T, Targets...>::value == 0) ? 0
+                                                        : 1 + index_of<T, Targets...>::value> {};
+
+        // Returns whether all types in `Targets...` are distinct.
+        template<typename... Targets>
+        struct are_distinct : std::true_type {};
+
+        template<typename First, typename... Targets>
+        struct are_distinct<First, Targets...>
+            : std::integral_constant<bool, index_of<First, Targets...>::value == 0
+                                               && are_distinct<Targets...>::value> {};
+
+        // Called when an empty variant delegate is invoked.
+        template<bool shallThrow, typename Ret>
+        struct empty_call;
+
+        template<typename Ret>
+        struct empty_call<true, Ret> {
+            [[noreturn]] static auto invoke() -> Ret {
+                delegate::throw_bad_delegate_call();
+            }
+        };
+
+        template<>
+        struct empty_call<false, void> {
+            static void invoke() noexcept {
+            }
+        };
+
+        // Resolves the target stored at the 1-based position `index` by a chain of comparisons
+        // that the compiler can turn into a jump table. Index 0 and any index beyond `Targets...`
+        // are treated as empty.
+        template<std::size_t position, typename... Targets>
+        struct dispatch {
+            template<bool shallThrow, typename Ret, typename... Args>
+            static auto invoke(std::size_t, void*, Args...) -> Ret {
+                return empty_call<shallThrow, Ret>::invoke();
+            }
+
+            static void move_construct(std::size_t, void*, void*) noexcept {
+            }
+
+            static void destroy(std::size_t, void*) noexcept {
+            }
+        };
+
+        template<std::size_t position, typename Target, typename... Targets>
+        struct dispatch<position, Target, Targets...> {
+            using next = dispatch<position + 1, Targets...>;
+
+            template<bool shallThrow, typename Ret, typename... Args>
+            static auto invoke(std::size_t index, void* storage, Args... args) -> Ret {
+                if (index == position) {
+                    return static_cast<Target*>(storage)->operator()(static_cast<Args>(args)...);
+                }
+                return next::template invoke<shallThrow, Ret, Args...>(
+                    index, storage, static_cast<Args>(args)...);
+            }
+
+            static void move_construct(std::size_t index, void* from, void* to) noexcept {
+                if (index == position) {
+                    (void)::new (to) Target(std::move(*static_cast<Target*>(from)));
+                    return;
+                }
+                next::move_construct(index, from, to);
+            }
+
+            static void destroy(std::size_t index, void* storage) noexcept {
+                if (index == position) {
+                    static_cast<Target*>(storage)->~Target();
+                    return;
+                }
+                next::destroy(index, storage);
+            }
+        };
+
+
+        // Splits the template arguments of `rome::variant_delegate` into the optional leading
+        // `Behavior` and the `Targets...`.
+        template<typename Signature, bool hasBehavior, typename... BehaviorAndTargets>
+        struct select_type;
+
+        template<typename Signature, typename... Targets>
+        struct select_type<Signature, false, Targets...> {
+            using type = basic_variant_delegate<Signature, target_is_expected, Targets...>;
+        };
+
+        template<typename Signature, typename Behavior, typename... Targets>
+        struct select_type<Signature, true, Behavior, Targets...> {
+            using type = basic_variant_delegate<Signature, Behavior, Targets...>;
+        };
+
+        template<typename... BehaviorAndTargets>
+        struct starts_with_behavior : std::false_type {};
+
+        template<typename First, typename... Targets>
+        struct starts_with_behavior<First, Targets...>
+            : std::integral_constant<bool, delegate::is_behavior<First>> {};
+    }  // namespace variant_delegate
+
+
+    // Implements the actual behavior of all variant delegates. Stores one object of the closed set
+    // of `Targets...` inside its own storage and identifies it by its 1-based position in
+    // `Targets...`. The position 0 identifies an empty variant delegate.
+    template<typename Signature, bool shallThrowWhenEmpty, typename... Targets>
+    class variant_delegate_core;
+
+    template<typename Ret, typename... Args, bool shallThrowWhenEmpty, typename... Targets>
+    class variant_delegate_core<Ret(Args...), shallThrowWhenEmpty, Targets...> {
+        static_assert(sizeof...(Targets) > 0,
+            "Missing parameter 'Targets'. At least one target type must be given.");
+        static_assert(delegate::all_of<std::is_class<Targets>::value...>,
+            "Invalid parameter 'Targets'. All target types must be function objects (a class type "
+            "with a function call operator, e.g. a lambda).");
+        static_assert(
+            delegate::all_of<std::is_same<Targets, std::remove_cv_t<Targets>>::value...>,
+            "Invalid parameter 'Targets'. The target types must not be cv-qualified.");
+        static_assert(
+            delegate::all_of<delegate::is_callable_by<Targets, Ret(Args...)>...>,
+            "Invalid parameter 'Targets'. The function call signatures of all target types must be "
+            "compatible with the signature of the variant delegate.");
+        static_assert(
+            delegate::all_of<std::is_nothrow_move_constructible<Targets>::value...>,
+            "Invalid parameter 'Targets'. All target types must be nothrow move constructible.");
+        static_assert(variant_delegate::are_distinct<Targets...>::value,
+            "Invalid parameter 'Targets'. The target types must be distinct.");
+
+        using dispatch = variant_delegate::dispatch<1, Targets...>;
+
+        // storage_ needs to be writable by `operator()(Args...) const`
+        // NOLINTNEXTLINE(*-avoid-c-arrays)
+        alignas(Targets...) mutable unsigned char storage_[std::max({sizeof(Targets)...})];
+        std::size_t index_ = 0;
+
+      public:
+        constexpr variant_delegate_core() noexcept : storage_{} {
+        }
+        variant_delegate_core(const variant_delegate_core&) noexcept = delete;
+        variant_delegate_core(variant_delegate_core&& orig) noexcept {
+            dispatch::move_construct(orig.index_, &orig.storage_, &storage_);
+            index_ = orig.index_;
+            orig.drop_target();
+        }
+
+        ~variant_delegate_core() {
+            dispatch::destroy(index_, &storage_);
+        }
+
+        auto operator=(const variant_delegate_core&) noexcept -> variant_delegate_core& = delete;
+        auto operator=(variant_delegate_core&& orig) noexcept -> variant_delegate_core& {
+            if (this != &orig) {
+                drop_target();
+                dispatch::move_construct(orig.index_, &orig.storage_, &storage_);
+                index_ = orig.index_;
+                orig.drop_target();
+            }
+            return *this;
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return index_ != 0;
+        }
+
+        auto operator()(Args... args) const -> Ret {
+            return dispatch::template invoke<shallThrowWhenEmpty, Ret, Args...>(
+                index_, &storage_, static_cast<Args>(args)...);
+        }
+
+        void swap(variant_delegate_core& other) noexcept {
+            variant_delegate_core temp{std::move(other)};
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+
+        void drop_target() noexcept {
+            dispatch::destroy(index_, &storage_);
+            index_ = 0;
+        }
+
+        // Stores the passed function object inside the storage. The variant delegate must be
+        // empty.
+        template<typename T>
+        void assign(T&& functor) noexcept(noexcept(std::decay_t<T>(std::forward<T>(functor)))) {
+            emplace<std::decay_t<T>>(std::forward<T>(functor));
+        }
+
+        // Constructs a function object of type `Functor` from `args` inside the storage. The
+        // variant delegate must be empty.
+        template<typename Functor, typename... CtorArgs>
+        auto emplace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) -> Functor& {
+            auto* pFunctor = ::new (&storage_) Functor(std::forward<CtorArgs>(args)...);
+            index_         = variant_delegate::index_of<Functor, Targets...>::value;
+            return *pFunctor;
+        }
+
+        // Replaces the target by a function object of type `Functor` constructed from `args`. If
+        // the construction may throw, the function object is constructed aside and moved into the
+        // storage afterwards, so that the current target is kept if the construction throws.
+        template<typename Functor, typename... CtorArgs>
+        auto replace(CtorArgs&&... args) noexcept(
+            std::is_nothrow_constructible<Functor, CtorArgs...>::value) -> Functor& {
+            if (!std::is_nothrow_constructible<Functor, CtorArgs...>::value) {
+                variant_delegate_core core;
+                core.template emplace<Functor>(std::forward<CtorArgs>(args)...);
+                *this = std::move(core);
+                return *static_cast<Functor*>(static_cast<void*>(&storage_));
+            }
+            drop_target();
+            return emplace<Functor>(std::forward<CtorArgs>(args)...);
+        }
+    };
+
+}  // namespace detail
+
+
+// Can store and invoke one target out of the closed set of function object types `Targets...`.
+// Dispatches the call by the index of the stored target type instead of an indirect function call.
+// See the documentation in `doc/variant_delegate.md`.
+template<typename Signature, typename Behavior, typename... Targets>
+class basic_variant_delegate {
+    static_assert(detail::delegate::invalid<Signature>,
+        "Invalid parameter 'Signature'. The template parameter "
+        "'Signature' must be a valid function signature.");
+};
+
+template<typename Ret, typename... Args, typename Behavior, typename... Targets>
+class basic_variant_delegate<Ret(Args...), Behavior, Targets...> {
+    static_assert(detail::delegate::is_behavior<Behavior>,
+        "Invalid parameter 'Behavior'. The template parameter 'Behavior' must either be empty or "
+        "contain one of the types 'rome::target_is_optional', 'rome::target_is_expected' or "
+        "'rome::target_is_mandatory'.");
+    static_assert(detail::delegate::is_valid_behavior<Ret, Behavior>,
+        "Return type coflicts with parameter 'Behavior'. The parameter 'Behavior' is only "
+        "allowed to be 'rome::target_is_optional' if the return type is 'void'.");
+
+    using core_type = detail::variant_delegate_core<Ret(Args...),
+        !std::is_same<Behavior, target_is_optional>::value, Targets...>;
+    core_type core_ = {};
+
+  public:
+    constexpr basic_variant_delegate() noexcept                    = default;
+    basic_variant_delegate(const basic_variant_delegate&) noexcept = delete;
+    basic_variant_delegate(basic_variant_delegate&&) noexcept      = default;
+    ~basic_variant_delegate()                                      = default;
+
+    auto operator=(const basic_variant_delegate&) noexcept -> basic_variant_delegate& = delete;
+    auto operator=(basic_variant_delegate&&) noexcept -> basic_variant_delegate&      = default;
+
+    // Construct from a function object target of one of the types `Targets...`.
+    template<typename Functor,
+        std::enable_if_t<detail::variant_delegate::index_of<std::decay_t<Functor>,
+                             Targets...>::value != 0,
+            int> = 0>
+    basic_variant_delegate(Functor&& functor) noexcept(
+        noexcept(std::declval<core_type&>().assign(std::forward<Functor>(functor)))) {
+        core_.assign(std::forward<Functor>(functor));
+    }
+
+    // Construct with a function object target of type `F` out of `Targets...` constructed in place
+    // from `args`.
+    template<typename F, typename... CtorArgs,
+        std::enable_if_t<detail::variant_delegate::index_of<F, Targets...>::value != 0
+                             && std::is_constructible<F, CtorArgs...>::value,
+            int> = 0>
+    explicit basic_variant_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        std::is_nothrow_constructible<F, CtorArgs...>::value) {
+        core_.template emplace<F>(std::forward<CtorArgs>(args)...);
+    }
+
+    constexpr basic_variant_delegate(std::nullptr_t) noexcept : basic_variant_delegate{} {
+    }
+    auto operator=(std::nullptr_t) noexcept -> basic_variant_delegate& {
+        core_.drop_target();
+        return *this;
+    }
+
+    constexpr explicit operator bool() const noexcept {
+        return static_cast<bool>(core_);
+    }
+
+    auto operator()(Args... args) const -> Ret {
+        return core_(static_cast<Args>(args)...);
+    }
+
+    void swap(basic_variant_delegate& other) noexcept {
+        core_.swap(other.core_);
+    }
+
+    // Replaces the target by a function object of type `F` out of `Targets...` constructed in
+    // place from `args`. Keeps the current target if the construction throws.
+    template<typename F, typename... CtorArgs,
+        std::enable_if_t<detail::variant_delegate::index_of<F, Targets...>::value != 0
+                             && std::is_constructible<F, CtorArgs...>::value,
+            int> = 0>
+    auto emplace(CtorArgs&&... args) noexcept(
+        std::is_nothrow_constructible<F, CtorArgs...>::value) -> F& {
+        return core_.template replace<F>(std::forward<CtorArgs>(args)...);
+    }
+
+    friend constexpr auto operator==(const basic_variant_delegate& lhs, std::nullptr_t) noexcept
+        -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const basic_variant_delegate& rhs) noexcept
+        -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const basic_variant_delegate& lhs, std::nullptr_t) noexcept
+        -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const basic_variant_delegate& rhs) noexcept
+        -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+template<typename Ret, typename... Args, typename... Targets>
+class basic_variant_delegate<Ret(Args...), target_is_mandatory, Targets...> {
+    using core_type = detail::variant_delegate_core<Ret(Args...), true, Targets...>;
+    core_type core_ = {};
+
+  public:
+    constexpr basic_variant_delegate() noexcept                    = delete;
+    basic_variant_delegate(const basic_variant_delegate&) noexcept = delete;
+    basic_variant_delegate(basic_variant_delegate&&) noexcept      = default;
+    ~basic_variant_delegate()                                      = default;
+
+    auto operator=(const basic_variant_delegate&) noexcept -> basic_variant_delegate& = delete;
+    auto operator=(basic_variant_delegate&&) noexcept -> basic_variant_delegate&      = default;
+
+    // Construct from a function object target of one of the types `Targets...`.
+    template<typename Functor,
+        std::enable_if_t<detail::variant_delegate::index_of<std::decay_t<Functor>,
+                             Targets...>::value != 0,
+            int> = 0>
+    basic_variant_delegate(Functor&& functor) noexcept(
+        noexcept(std::declval<core_type&>().assign(std::forward<Functor>(functor)))) {
+        core_.assign(std::forward<Functor>(functor));
+    }
+
+    // Construct with a function object target of type `F` out of `Targets...` constructed in place
+    // from `args`.
+    template<typename F, typename... CtorArgs,
+        std::enable_if_t<detail::variant_delegate::index_of<F, Targets...>::value != 0
+                             && std::is_constructible<F, CtorArgs...>::value,
+            int> = 0>
+    explicit basic_variant_delegate(in_place_type_t<F> /*unused*/, CtorArgs&&... args) noexcept(
+        std::is_nothrow_constructible<F, CtorArgs...>::value) {
+        core_.template emplace<F>(std::forward<CtorArgs>(args)...);
+    }
+
+    constexpr explicit operator bool() const noexcept {
+        return static_cast<bool>(core_);
+    }
+
+    auto operator()(Args... args) const -> Ret {
+        return core_(static_cast<Args>(args)...);
+    }
+
+    void swap(basic_variant_delegate& other) noexcept {
+        core_.swap(other.core_);
+    }
+
+    // Replaces the target by a function object of type `F` out of `Targets...` constructed in
+    // place from `args`. Keeps the current target if the construction throws.
+    template<typename F, typename... CtorArgs,
+        std::enable_if_t<detail::variant_delegate::index_of<F, Targets...>::value != 0
+                             && std::is_constructible<F, CtorArgs...>::value,
+            int> = 0>
+    auto emplace(CtorArgs&&... args) noexcept(
+        std::is_nothrow_constructible<F, CtorArgs...>::value) -> F& {
+        return core_.template replace<F>(std::forward<CtorArgs>(args)...);
+    }
+
+    friend constexpr auto operator==(const basic_variant_delegate& lhs, std::nullptr_t) noexcept
+        -> bool {
+        return !lhs;
+    }
+    friend constexpr auto operator==(std::nullptr_t, const basic_variant_delegate& rhs) noexcept
+        -> bool {
+        return !rhs;
+    }
+    friend constexpr auto operator!=(const basic_variant_delegate& lhs, std::nullptr_t) noexcept
+        -> bool {
+        return static_cast<bool>(lhs);
+    }
+    friend constexpr auto operator!=(std::nullptr_t, const basic_variant_delegate& rhs) noexcept
+        -> bool {
+        return static_cast<bool>(rhs);
+    }
+};
+
+
+// A `rome::basic_variant_delegate`, where the first of `BehaviorAndTargets...` is taken as the
+// `Behavior` if it is one of `rome::target_is_expected`, `rome::target_is_optional` or
+// `rome::target_is_mandatory`. Otherwise, `Behavior` is `rome::target_is_expected`. See the
+// documentation in `doc/variant_delegate.md`.
+template<typename Signature, typename... BehaviorAndTargets>
+using variant_delegate = typename detail::variant_delegate::select_type<Signature,
+    detail::variant_delegate::starts_with_behavior<BehaviorAndTargets...>::value,
+    BehaviorAndTargets...>::type;
+
+}  // namespace rome
+
+#endif  // ROME_VARIANT_DELEGATE_HPP
@@ -0,0 +1,108 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Replaces the global `operator new` and `operator delete` to count their calls. See
+// `test/include/test/allocation_counter.hpp`.
+// The array, nothrow and sized variants of the standard library forward to the replaced functions.
+
+#include <test/allocation_counter.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> allocationCount{0};
+std::atomic<std::size_t> deallocationCount{0};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+auto allocate(std::size_t size) -> void* {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        deallocationCount.fetch_add(1, std::memory_order_relaxed);
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+        std::free(ptr);
+    }
+}
+
+#if defined(__cpp_aligned_new)
+// Over-allocates and stores the pointer returned by `allocate` in front of the aligned block.
+auto allocateAligned(std::size_t size, std::align_val_t alignment) -> void* {
+    const auto align = static_cast<std::size_t>(alignment);
+    void* raw        = allocate(size + align + sizeof(void*));
+    auto address     = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);  // NOLINT
+    address          = (address + align - 1) & ~(align - 1);
+    void* aligned    = reinterpret_cast<void*>(address);  // NOLINT(performance-no-int-to-ptr)
+    static_cast<void**>(aligned)[-1] = raw;
+    return aligned;
+}
+
+void deallocateAligned(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        deallocate(static_cast<void**>(ptr)[-1]);
+    }
+}
+#endif
+}  // namespace
+
+
+namespace test {
+namespace detail {
+    auto globalAllocationCount() noexcept -> std::size_t {
+        return allocationCount.load(std::memory_order_relaxed);
+    }
+
+    auto globalDeallocationCount() noexcept -> std::size_t {
+        return deallocationCount.load(std::memory_order_relaxed);
+    }
+}  // namespace detail
+}  // namespace test
+
+
+// NOLINTBEGIN(misc-new-delete-overloads)
+auto operator new(std::size_t size) -> void* {
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+#endif
+
+#if defined(__cpp_aligned_new)
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    deallocateAligned(ptr);
+}
+
+#    if defined(__cpp_sized_deallocation)
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocateAligned(ptr);
+}
+#    endif
+#endif
+// NOLINTEND(misc-new-delete-overloads)
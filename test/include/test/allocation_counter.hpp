@@ -0,0 +1,48 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Provides the facilities to observe the calls to the global allocation and deallocation functions.
+// The replacements of the global `operator new` and `operator delete` are defined in
+// `test/allocation_counter.cpp`, which is linked to the unit tests.
+
+#pragma once
+
+#include <cstddef>
+
+namespace test {
+
+namespace detail {
+    // Returns the number of calls to any global `operator new` since the start of the program.
+    auto globalAllocationCount() noexcept -> std::size_t;
+    // Returns the number of calls to any global `operator delete` since the start of the program.
+    auto globalDeallocationCount() noexcept -> std::size_t;
+}  // namespace detail
+
+// Counts the calls to the global allocation and deallocation functions during its lifetime.
+// Read the counts into a local variable before checking them with doctest, as doctest itself might
+// allocate memory.
+// E.g.:
+//   const test::AllocationCounter counter;
+//   dgt(42);
+//   const auto allocations = counter.allocations();
+//   CHECK(allocations == 0);
+class AllocationCounter {
+    std::size_t allocationsAtStart_   = detail::globalAllocationCount();
+    std::size_t deallocationsAtStart_ = detail::globalDeallocationCount();
+
+  public:
+    auto allocations() const noexcept -> std::size_t {
+        return detail::globalAllocationCount() - allocationsAtStart_;
+    }
+
+    auto deallocations() const noexcept -> std::size_t {
+        return detail::globalDeallocationCount() - deallocationsAtStart_;
+    }
+};
+
+}  // namespace test
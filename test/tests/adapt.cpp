@@ -0,0 +1,145 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `adapt<F>(other)`, which takes over the function object of a delegate with another but
+// compatible signature without wrapping the other delegate.
+
+#include <rome/delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct Message {
+    int value = 0;
+};
+
+struct StatelessHandler {
+    void operator()(const Message& /*unused*/) const {
+    }
+};
+
+struct SmallHandler {
+    int* received = nullptr;
+    void operator()(const Message& msg) const {
+        *received = msg.value;
+    }
+};
+
+struct BigHandler {
+    int* received  = nullptr;
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    void operator()(const Message& msg) const {
+        *received = msg.value;
+    }
+};
+
+struct Square {
+    auto operator()(int value) const -> int {
+        return value * value;
+    }
+};
+
+template<typename Delegate>
+auto is_adaptable(int /*unused*/) -> decltype(Delegate::template adapt<Square>(
+                                                  std::declval<rome::delegate<int(int)>>()),
+    std::true_type{});
+template<typename Delegate>
+auto is_adaptable(long /*unused*/) -> std::false_type;
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,readability-function-cognitive-complexity)
+TEST_CASE_TEMPLATE("adapt<F>() takes over the function object without wrapping", Handler,
+    SmallHandler, BigHandler) {
+    int received = 0;
+    rome::delegate<void(const Message&)> from{Handler{&received}};
+    const auto* pHandler = from.template target<Handler>();
+    REQUIRE(pHandler != nullptr);
+
+    const test::AllocationCounter counter;
+    auto to                  = rome::event_delegate<void(Message)>::adapt<Handler>(std::move(from));
+    const auto allocations   = counter.allocations();
+    const auto deallocations = counter.deallocations();
+    CHECK(allocations == 0);
+    CHECK(deallocations == 0);
+
+    CHECK(!from);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    REQUIRE(to);
+    REQUIRE(to.template target<Handler>() != nullptr);
+    if (sizeof(Handler) > sizeof(void*)) {
+        // the dynamically allocated function object is not moved
+        CHECK(to.template target<Handler>() == pHandler);
+    }
+    to(Message{42});
+    CHECK(received == 42);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("adapt<F>() takes over a stateless function object") {
+    rome::command_delegate<void(const Message&)> from = StatelessHandler{};
+    auto to = rome::delegate<void(Message)>::adapt<StatelessHandler>(std::move(from));
+    CHECK(!from);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(to.target<StatelessHandler>() != nullptr);
+    CHECK_NOTHROW(to(Message{}));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("adapt<F>() converts arguments and return value") {
+    rome::delegate<int(int), rome::target_is_mandatory> from = Square{};
+    auto to = rome::delegate<long(short)>::adapt<Square>(std::move(from));
+    CHECK(!from);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(to.target<Square>() != nullptr);
+    CHECK(to(short{7}) == 49L);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("adapt<F>() wraps the other delegate if its target is not of type F") {
+    int received = 0;
+    rome::delegate<void(const Message&)> from{BigHandler{&received}};
+    auto to = rome::delegate<void(Message)>::adapt<SmallHandler>(std::move(from));
+    CHECK(!from);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(to.target<SmallHandler>() == nullptr);
+    CHECK(to.target<BigHandler>() == nullptr);
+    to(Message{3});
+    CHECK(received == 3);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("adapt<F>() of an empty delegate") {
+    SUBCASE("target_is_expected") {
+        auto to = rome::delegate<void(Message)>::adapt<SmallHandler>(
+            rome::delegate<void(const Message&), rome::target_is_optional>{});
+        CHECK(!to);
+        CHECK_THROWS_AS(to(Message{}), rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_optional") {
+        auto to = rome::event_delegate<void(Message)>::adapt<SmallHandler>(
+            rome::delegate<void(const Message&)>{});
+        CHECK(!to);
+        CHECK_NOTHROW(to(Message{}));
+    }
+    SUBCASE("target_is_mandatory") {
+        CHECK_THROWS_AS(rome::command_delegate<void(Message)>::adapt<SmallHandler>(
+                            rome::delegate<void(const Message&)>{}),
+            rome::bad_delegate_call);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("adapt<F>() is only provided for callable delegates") {
+    STATIC_REQUIRE(decltype(is_adaptable<rome::delegate<long(short)>>(0))::value);
+    STATIC_REQUIRE(decltype(is_adaptable<rome::delegate<double(long)>>(0))::value);
+    STATIC_REQUIRE(!decltype(is_adaptable<rome::delegate<int(const char*)>>(0))::value);
+}
@@ -0,0 +1,304 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::async_fwd_delegate`, which calls its target by tasks posted to an executor.
+
+#include <rome/async_fwd_delegate.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <doctest/doctest.h>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+using Async    = rome::async_fwd_delegate<void(int)>;
+using TaskType = Async::task_type;
+
+// Runs the posted tasks when requested.
+class ManualExecutor {
+    std::vector<TaskType> tasks_;
+
+  public:
+    ManualExecutor() {
+        tasks_.reserve(64);
+    }
+
+    void post(TaskType&& task) {
+        tasks_.push_back(std::move(task));
+    }
+
+    auto size() const noexcept -> std::size_t {
+        return tasks_.size();
+    }
+
+    void run_all() {
+        auto tasks = std::move(tasks_);
+        tasks_.clear();
+        tasks_.reserve(64);
+        for (auto& task : tasks) {
+            task();
+        }
+    }
+
+    auto poster() -> Async::executor_type {
+        return Async::executor_type::create<ManualExecutor, &ManualExecutor::post>(*this);
+    }
+};
+
+// Runs the posted tasks in a worker thread.
+class ThreadExecutor {
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<TaskType> tasks_;
+    bool stop_ = false;
+    std::thread worker_{[this]() { work(); }};
+
+    void work() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            wakeup_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+  public:
+    ThreadExecutor()                      = default;
+    ThreadExecutor(const ThreadExecutor&) = delete;
+    ThreadExecutor(ThreadExecutor&&)      = delete;
+
+    auto operator=(const ThreadExecutor&) -> ThreadExecutor& = delete;
+    auto operator=(ThreadExecutor&&) -> ThreadExecutor&      = delete;
+
+    // Runs the remaining tasks before it returns.
+    ~ThreadExecutor() {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wakeup_.notify_one();
+        worker_.join();
+    }
+
+    void post(TaskType&& task) {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.push_back(std::move(task));
+        }
+        wakeup_.notify_one();
+    }
+};
+
+// Throws when assigned from an instance with `fail` set.
+struct Fragile {
+    bool fail = false;
+    int value = 0;
+
+    Fragile() = default;
+    Fragile(const bool f, const int v) : fail{f}, value{v} {
+    }
+    Fragile(const Fragile&) = default;
+    auto operator=(const Fragile& other) -> Fragile& {
+        if (other.fail) {
+            throw std::exception{};
+        }
+        value = other.value;
+        return *this;
+    }
+};
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate types") {
+    STATIC_REQUIRE(std::is_same<Async::delegate_type, rome::fwd_delegate<void(int)>>::value);
+    STATIC_REQUIRE(std::is_same<TaskType, rome::command_delegate<void()>>::value);
+    STATIC_REQUIRE(
+        std::is_same<Async::executor_type, rome::command_delegate<void(TaskType&&)>>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<Async>::value);
+    STATIC_REQUIRE(!std::is_move_constructible<Async>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate calls the target by the posted tasks") {
+    ManualExecutor executor;
+    std::vector<int> received;
+    Async async{5, executor.poster(), [&received](int value) { received.push_back(value); }};
+    CHECK(async.capacity() == 8);
+    CHECK(async.pending() == 0);
+
+    CHECK(async(1));
+    CHECK(async(2));
+    CHECK(async(3));
+    CHECK(received.empty());
+    CHECK(executor.size() == 3);
+    CHECK(async.pending() == 3);
+
+    executor.run_all();
+    CHECK(received == std::vector<int>{1, 2, 3});
+    CHECK(async.pending() == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate drops calls when the queue is full") {
+    ManualExecutor executor;
+    int sum = 0;
+    Async async{4, executor.poster(), [&sum](int value) { sum += value; }};
+    for (int i = 0; i < 4; ++i) {
+        CHECK(async(1));
+    }
+    CHECK(!async(100));
+    CHECK(executor.size() == 4);
+    executor.run_all();
+    CHECK(sum == 4);
+
+    // the slots are reused
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            CHECK(async(10));
+        }
+        CHECK(!async(100));
+        executor.run_all();
+    }
+    CHECK(sum == 124);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate with empty target") {
+    ManualExecutor executor;
+    rome::async_fwd_delegate<void(int), rome::target_is_optional> optional{
+        4, executor.poster(), nullptr};
+    CHECK(optional(1));
+    CHECK(executor.size() == 0);
+
+    Async expected{4, executor.poster(), nullptr};
+    CHECK_THROWS_AS(expected(1), rome::bad_delegate_call);
+    CHECK(executor.size() == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate stores copies and moves rvalue arguments") {
+    ManualExecutor executor;
+    std::string text;
+    std::unique_ptr<int> pointer;
+    rome::async_fwd_delegate<void(const std::string&, std::unique_ptr<int>&&)> async{4,
+        rome::command_delegate<void(TaskType&&)>::create<ManualExecutor, &ManualExecutor::post>(
+            executor),
+        [&text, &pointer](const std::string& t, std::unique_ptr<int>&& p) {
+            text    = t;
+            pointer = std::move(p);
+        }};
+    {
+        const std::string temporary = "a text too long for the small string optimization";
+        CHECK(async(temporary, std::make_unique<int>(3)));
+    }
+    executor.run_all();
+    CHECK(text == "a text too long for the small string optimization");
+    REQUIRE(pointer != nullptr);
+    CHECK(*pointer == 3);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate releases the stored arguments after the call") {
+    ManualExecutor executor;
+    long useCountInCall = 0;
+    rome::async_fwd_delegate<void(const std::shared_ptr<int>&)> async{4,
+        rome::command_delegate<void(TaskType&&)>::create<ManualExecutor, &ManualExecutor::post>(
+            executor),
+        [&useCountInCall](const std::shared_ptr<int>& p) { useCountInCall = p.use_count(); }};
+    const auto shared = std::make_shared<int>(5);
+    CHECK(async(shared));
+    CHECK(shared.use_count() == 2);
+    executor.run_all();
+    CHECK(useCountInCall == 2);
+    CHECK(async.pending() == 0);
+    CHECK(shared.use_count() == 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate skips calls whose arguments could not be stored") {
+    ManualExecutor executor;
+    int sum = 0;
+    rome::async_fwd_delegate<void(const Fragile&)> async{4,
+        rome::command_delegate<void(TaskType&&)>::create<ManualExecutor, &ManualExecutor::post>(
+            executor),
+        [&sum](const Fragile& f) { sum += f.value; }};
+    CHECK(async(Fragile{false, 1}));
+    CHECK_THROWS_AS(async(Fragile{true, 10}), std::exception);
+    CHECK(async(Fragile{false, 100}));
+    executor.run_all();
+    CHECK(sum == 101);
+    CHECK(async.pending() == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate does not allocate when called") {
+    ManualExecutor executor;
+    int sum = 0;
+    Async async{16, executor.poster(), [&sum](int value) { sum += value; }};
+    const test::AllocationCounter counter;
+    for (int i = 0; i < 16; ++i) {
+        CHECK(async(i));
+    }
+    CHECK(counter.allocations() == 0);
+    executor.run_all();
+    CHECK(sum == 120);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("async_fwd_delegate calls from several threads") {
+    constexpr int callsPerThread = 10000;
+    constexpr int threadCount    = 3;
+    long long sum                = 0;
+    int calls                    = 0;
+    {
+        // the executor runs the remaining tasks when it is destroyed, before the async delegate
+        auto executor = std::make_unique<ThreadExecutor>();
+        Async async{64,
+            Async::executor_type::create<ThreadExecutor, &ThreadExecutor::post>(*executor),
+            [&sum, &calls](int value) {
+                sum += value;
+                ++calls;
+            }};
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threadCount; ++t) {
+            producers.emplace_back([&async]() {
+                for (int i = 1; i <= callsPerThread; ++i) {
+                    while (!async(i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        executor.reset();
+        CHECK(async.pending() == 0);
+    }
+    CHECK(calls == threadCount * callsPerThread);
+    CHECK(sum == threadCount * (static_cast<long long>(callsPerThread) * (callsPerThread + 1) / 2));
+}
@@ -0,0 +1,172 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::broadcast_ring`, which passes the values of one producer to several consumers.
+
+#include <rome/broadcast_ring.hpp>
+
+#include <cstddef>
+#include <doctest/doctest.h>
+#include <exception>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("broadcast_ring types") {
+    using Ring = rome::broadcast_ring<std::string>;
+    STATIC_REQUIRE(std::is_same<Ring::value_type, std::string>::value);
+    STATIC_REQUIRE(
+        std::is_same<Ring::delegate_type, rome::event_delegate<void(const std::string&)>>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<Ring>::value);
+    STATIC_REQUIRE(!std::is_move_constructible<Ring>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("broadcast_ring passes each value to all consumers in order") {
+    rome::broadcast_ring<int> ring{5};
+    CHECK(ring.capacity() == 8);
+    CHECK(ring.consumer_count() == 0);
+
+    std::vector<int> first;
+    std::vector<int> second;
+    CHECK(ring.connect([&first](int value) { first.push_back(value); }) == 0);
+    CHECK(ring.connect([&second](int value) { second.push_back(10 * value); }) == 1);
+    CHECK(ring.consumer_count() == 2);
+    CHECK(ring.poll(0) == 0);
+
+    ring.publish(1);
+    ring.publish(2);
+    CHECK(ring.pending(0) == 2);
+    CHECK(ring.poll(0) == 2);
+    CHECK(ring.pending(0) == 0);
+    CHECK(ring.pending(1) == 2);
+    ring.publish(3);
+    CHECK(ring.poll(0) == 1);
+    CHECK(ring.poll(1) == 3);
+    CHECK(first == std::vector<int>{1, 2, 3});
+    CHECK(second == std::vector<int>{10, 20, 30});
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("broadcast_ring waits for the slowest consumer") {
+    rome::broadcast_ring<int> ring{4};
+    int sum = 0;
+    (void)ring.connect([&sum](int value) { sum += value; });
+    (void)ring.connect(nullptr);  // an empty consumer still reads the values
+
+    for (int i = 1; i <= 4; ++i) {
+        CHECK(ring.try_publish(i));
+    }
+    CHECK(!ring.try_publish(5));
+    CHECK(ring.poll(0) == 4);
+    CHECK(!ring.try_publish(5));
+    CHECK(ring.poll(1) == 4);
+    CHECK(ring.try_publish(5));
+    CHECK(ring.poll(0) == 1);
+    CHECK(ring.poll(1) == 1);
+    CHECK(sum == 15);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("broadcast_ring without consumers never waits") {
+    rome::broadcast_ring<int> ring{2};
+    for (int i = 0; i < 5; ++i) {
+        CHECK(ring.try_publish(i));
+    }
+
+    // a consumer connected later receives the values published afterwards only
+    int last = -1;
+    (void)ring.connect([&last](int value) { last = value; });
+    CHECK(ring.pending(0) == 0);
+    CHECK(ring.try_publish(7));
+    CHECK(ring.poll(0) == 1);
+    CHECK(last == 7);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("broadcast_ring skips the value whose consumer threw") {
+    rome::broadcast_ring<int> ring{4};
+    std::vector<int> received;
+    (void)ring.connect([&received](int value) {
+        if (value < 0) {
+            throw std::exception{};
+        }
+        received.push_back(value);
+    });
+    ring.publish(1);
+    ring.publish(-1);
+    ring.publish(2);
+    CHECK_THROWS_AS(ring.poll(0), std::exception);
+    CHECK(ring.pending(0) == 1);
+    CHECK(ring.poll(0) == 1);
+    CHECK(received == std::vector<int>{1, 2});
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("broadcast_ring reuses the stored values") {
+    rome::broadcast_ring<std::string> ring{2};
+    std::size_t length = 0;
+    (void)ring.connect([&length](const std::string& text) { length += text.size(); });
+    const std::string text = "a text too long for the small string optimization";
+    ring.publish(text);
+    ring.publish(text);
+    CHECK(ring.poll(0) == 2);
+
+    const test::AllocationCounter counter;
+    for (int i = 0; i < 10; ++i) {
+        ring.publish(text);
+        CHECK(ring.poll(0) == 1);
+    }
+    CHECK(counter.allocations() == 0);
+    CHECK(length == 12 * text.size());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("broadcast_ring consumers in several threads") {
+    constexpr int valueCount            = 10000;
+    constexpr std::size_t consumerCount = 3;
+    rome::broadcast_ring<int> ring{16};
+    std::vector<long long> sums(consumerCount, 0);
+    std::vector<int> orderErrors(consumerCount, 0);
+    for (std::size_t c = 0; c < consumerCount; ++c) {
+        (void)ring.connect([&sums, &orderErrors, c, last = 0](int value) mutable {
+            sums[c] += value;
+            orderErrors[c] += value == last + 1 ? 0 : 1;
+            last = value;
+        });
+    }
+
+    std::vector<std::thread> consumers;
+    for (std::size_t c = 0; c < consumerCount; ++c) {
+        consumers.emplace_back([&ring, c]() {
+            std::size_t read = 0;
+            while (read < valueCount) {
+                const auto count = ring.poll(c);
+                if (count == 0) {
+                    std::this_thread::yield();
+                }
+                read += count;
+            }
+        });
+    }
+    for (int i = 1; i <= valueCount; ++i) {
+        ring.publish(i);
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    for (std::size_t c = 0; c < consumerCount; ++c) {
+        CHECK(sums[c] == static_cast<long long>(valueCount) * (valueCount + 1) / 2);
+        CHECK(orderErrors[c] == 0);
+    }
+}
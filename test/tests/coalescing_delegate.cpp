@@ -0,0 +1,141 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::coalescing_delegate`, which calls its target with the newest arguments only.
+
+#include <rome/coalescing_delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <memory>
+#include <string>
+#include <test/doctest_extensions.hpp>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct Record {
+    int* calls;
+    float* last;
+    void operator()(float value) const {
+        ++*calls;
+        *last = value;
+    }
+};
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("coalescing_delegate types") {
+    using Coalescing = rome::coalescing_delegate<void(float)>;
+    STATIC_REQUIRE(
+        std::is_same<Coalescing::delegate_type, rome::event_delegate<void(float)>>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<Coalescing>::value);
+    STATIC_REQUIRE(!std::is_move_constructible<Coalescing>::value);
+    STATIC_REQUIRE(noexcept(std::declval<Coalescing&>()(1.0F)));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("coalescing_delegate calls the target once with the newest arguments") {
+    int calls  = 0;
+    float last = 0.0F;
+    rome::coalescing_delegate<void(float)> sensor{Record{&calls, &last}};
+    CHECK(!sensor.pending());
+    CHECK(!sensor.flush());
+    CHECK(calls == 0);
+
+    sensor(1.0F);
+    sensor(2.0F);
+    sensor(3.0F);
+    CHECK(calls == 0);
+    CHECK(sensor.pending());
+    CHECK(sensor.flush());
+    CHECK(calls == 1);
+    CHECK(last == 3.0F);
+    CHECK(!sensor.pending());
+    CHECK(!sensor.flush());
+    CHECK(calls == 1);
+
+    for (int i = 0; i < 10; ++i) {
+        sensor(static_cast<float>(i));
+        CHECK(sensor.flush());
+        CHECK(last == static_cast<float>(i));
+    }
+    CHECK(calls == 11);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("coalescing_delegate stores copies of the arguments") {
+    std::string received;
+    int count = 0;
+    rome::coalescing_delegate<void(const std::string&, int)> coalescing;
+    coalescing.delegate() = [&received, &count](const std::string& text, int i) {
+        received = text;
+        count    = i;
+    };
+    {
+        const std::string text = "first, a text too long for the small string optimization";
+        coalescing(text, 1);
+    }
+    coalescing(std::string{"second, a text too long for the small string optimization"}, 2);
+    CHECK(coalescing.flush());
+    CHECK(received == "second, a text too long for the small string optimization");
+    CHECK(count == 2);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("coalescing_delegate moves rvalue arguments to the target") {
+    std::unique_ptr<int> received;
+    rome::coalescing_delegate<void(std::unique_ptr<int>&&)> coalescing{
+        [&received](std::unique_ptr<int>&& value) { received = std::move(value); }};
+    coalescing(std::make_unique<int>(1));
+    coalescing(std::make_unique<int>(2));
+    CHECK(coalescing.flush());
+    REQUIRE(received != nullptr);
+    CHECK(*received == 2);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("coalescing_delegate without target") {
+    rome::coalescing_delegate<void(int)> coalescing;
+    coalescing(1);
+    CHECK(coalescing.flush());
+    CHECK(!coalescing.pending());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("coalescing_delegate passes consistent arguments between threads") {
+    constexpr int count = 100000;
+    int lastReceived    = 0;
+    bool consistent     = true;
+    bool ordered        = true;
+    rome::coalescing_delegate<void(int, int)> coalescing{
+        [&lastReceived, &consistent, &ordered](int value, int doubled) {
+            consistent   = consistent && doubled == 2 * value;
+            ordered      = ordered && value > lastReceived;
+            lastReceived = value;
+        }};
+
+    std::thread producer{[&coalescing]() {
+        for (int i = 1; i <= count; ++i) {
+            coalescing(i, 2 * i);
+        }
+    }};
+    int flushes = 0;
+    while (lastReceived < count) {
+        flushes += coalescing.flush() ? 1 : 0;
+    }
+    producer.join();
+    CHECK(consistent);
+    CHECK(ordered);
+    CHECK(flushes <= count);
+    CHECK(!coalescing.flush());
+}
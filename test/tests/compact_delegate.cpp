@@ -0,0 +1,230 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::compact_delegate`, which keeps its target behind a static table of operations.
+
+#include <rome/compact_delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct StatelessFunctor {
+    auto operator()(int value) const -> int {
+        return value + 1;
+    }
+};
+
+struct SmallFunctor {
+    int summand = 2;
+    auto operator()(int value) const -> int {
+        return value + summand;
+    }
+};
+
+struct BigFunctor {
+    int summand    = 3;
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    auto operator()(int value) const -> int {
+        return value + summand;
+    }
+};
+
+struct CountedFunctor {
+    int* destructions;
+    explicit CountedFunctor(int* counter) noexcept : destructions{counter} {
+    }
+    CountedFunctor(CountedFunctor&& other) noexcept : destructions{other.destructions} {
+        other.destructions = nullptr;
+    }
+    CountedFunctor(const CountedFunctor&)                    = delete;
+    auto operator=(const CountedFunctor&) -> CountedFunctor& = delete;
+    auto operator=(CountedFunctor&&) -> CountedFunctor&      = delete;
+    ~CountedFunctor() {
+        if (destructions != nullptr) {
+            ++*destructions;
+        }
+    }
+    auto operator()(int value) const -> int {
+        return value;
+    }
+};
+
+struct Accumulator {
+    int sum = 0;
+    auto add(int value) -> int {
+        sum += value;
+        return sum;
+    }
+    auto peek(int value) const -> int {
+        return sum + value;
+    }
+};
+
+auto function(int value) -> int {
+    return value + 4;
+}
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("compact_delegate has the size of two pointers") {
+    STATIC_REQUIRE(sizeof(rome::compact_delegate<int(int)>) == 2 * sizeof(void*));
+    STATIC_REQUIRE(
+        sizeof(rome::compact_delegate<void(int), rome::target_is_optional>) == 2 * sizeof(void*));
+    STATIC_REQUIRE(
+        sizeof(rome::compact_delegate<int(int), rome::target_is_mandatory>) == 2 * sizeof(void*));
+    STATIC_REQUIRE(sizeof(rome::compact_delegate<int(int)>) < sizeof(rome::delegate<int(int)>));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("An empty compact_delegate behaves according to its Behavior") {
+    SUBCASE("target_is_expected") {
+        rome::compact_delegate<int(int)> dgt;
+        CHECK(!dgt);
+        CHECK(dgt == nullptr);
+        CHECK(nullptr == dgt);
+        CHECK_THROWS_AS(dgt(1), rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_optional") {
+        rome::compact_delegate<void(int), rome::target_is_optional> dgt = nullptr;
+        CHECK(!dgt);
+        CHECK_NOTHROW(dgt(1));
+    }
+    SUBCASE("target_is_mandatory") {
+        STATIC_REQUIRE(!std::is_default_constructible<
+                       rome::compact_delegate<int(int), rome::target_is_mandatory>>::value);
+        STATIC_REQUIRE(!std::is_assignable<
+                       rome::compact_delegate<int(int), rome::target_is_mandatory>&,
+                       std::nullptr_t>::value);
+        rome::compact_delegate<int(int), rome::target_is_mandatory> dgt = SmallFunctor{};
+        auto moved                                                       = std::move(dgt);
+        CHECK(moved(1) == 3);
+        // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+        CHECK_THROWS_AS(dgt(1), rome::bad_delegate_call);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("compact_delegate calls functions and member functions") {
+    auto fromFunction = rome::compact_delegate<int(int)>::create<&function>();
+    CHECK(fromFunction(1) == 5);
+
+    Accumulator accumulator;
+    auto fromMember = rome::compact_delegate<int(int)>::create<Accumulator, &Accumulator::add>(
+        accumulator);
+    CHECK(fromMember(2) == 2);
+    CHECK(fromMember(3) == 5);
+
+    const Accumulator& constAccumulator = accumulator;
+    auto fromConstMember =
+        rome::compact_delegate<int(int), rome::target_is_mandatory>::create<Accumulator,
+            &Accumulator::peek>(constAccumulator);
+    CHECK(fromConstMember(1) == 6);
+    CHECK(fromConstMember.target<SmallFunctor>() == nullptr);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("compact_delegate stores function objects like delegate") {
+    SUBCASE("Stateless and small function objects are not allocated") {
+        const test::AllocationCounter counter;
+        rome::compact_delegate<int(int)> stateless = StatelessFunctor{};
+        rome::compact_delegate<int(int)> small     = SmallFunctor{};
+        const auto allocations                     = counter.allocations();
+        CHECK(allocations == 0);
+        CHECK(stateless(1) == 2);
+        CHECK(small(1) == 3);
+    }
+    SUBCASE("Big function objects are allocated") {
+        const test::AllocationCounter counter;
+        {
+            rome::compact_delegate<int(int)> big = BigFunctor{};
+            CHECK(big(1) == 4);
+        }
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 1);
+        CHECK(deallocations == 1);
+    }
+    SUBCASE("target<F>() refers to the stored function object") {
+        rome::compact_delegate<int(int)> small = SmallFunctor{};
+        rome::compact_delegate<int(int)> big   = BigFunctor{};
+        REQUIRE(small.target<SmallFunctor>() != nullptr);
+        REQUIRE(big.target<BigFunctor>() != nullptr);
+        CHECK(small.target<BigFunctor>() == nullptr);
+        CHECK(big.target<SmallFunctor>() == nullptr);
+        small.target<SmallFunctor>()->summand = 10;
+        big.target<BigFunctor>()->summand     = 20;
+        CHECK(small(1) == 11);
+        CHECK(big(1) == 21);
+
+        const auto& constSmall = small;
+        STATIC_REQUIRE(std::is_same<decltype(constSmall.target<SmallFunctor>()),
+            const SmallFunctor*>::value);
+        CHECK(constSmall.target<SmallFunctor>() == small.target<SmallFunctor>());
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("compact_delegate destroys its target") {
+    int destructions = 0;
+    SUBCASE("Destructor") {
+        {
+            const rome::compact_delegate<int(int)> dgt{
+                rome::in_place_type<CountedFunctor>, &destructions};
+            CHECK(dgt(1) == 1);
+        }
+        CHECK(destructions == 1);
+    }
+    SUBCASE("Assignment of nullptr") {
+        rome::compact_delegate<int(int)> dgt{rome::in_place_type<CountedFunctor>, &destructions};
+        dgt = nullptr;
+        CHECK(destructions == 1);
+        CHECK(!dgt);
+    }
+    SUBCASE("Move assignment") {
+        rome::compact_delegate<int(int)> dgt{rome::in_place_type<CountedFunctor>, &destructions};
+        dgt = SmallFunctor{};
+        CHECK(destructions == 1);
+        CHECK(dgt(1) == 3);
+    }
+    SUBCASE("emplace") {
+        rome::compact_delegate<int(int), rome::target_is_mandatory> dgt{
+            rome::in_place_type<CountedFunctor>, &destructions};
+        auto& small = dgt.emplace<SmallFunctor>(SmallFunctor{5});
+        CHECK(destructions == 1);
+        CHECK(&small == dgt.target<SmallFunctor>());
+        CHECK(dgt(1) == 6);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("compact_delegate can be moved and swapped") {
+    rome::compact_delegate<int(int)> small = SmallFunctor{};
+    rome::compact_delegate<int(int)> big   = BigFunctor{};
+    const auto* bigTarget                  = big.target<BigFunctor>();
+
+    small.swap(big);
+    CHECK(small(1) == 4);
+    CHECK(big(1) == 3);
+    CHECK(small.target<BigFunctor>() == bigTarget);
+
+    rome::compact_delegate<int(int)> moved = std::move(small);
+    CHECK(!small);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(moved.target<BigFunctor>() == bigTarget);
+
+    moved = std::move(big);
+    CHECK(!big);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(moved(1) == 3);
+}
@@ -0,0 +1,132 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks that delegates targeting functions, member functions of objects with static storage
+// duration or stateless function objects can be constant initialized.
+// The targets are not mocked, as the mocks cannot be used in constant expressions.
+
+#include <rome/delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+
+
+namespace {
+
+auto function(int value) -> int {
+    return value + 1;
+}
+
+struct TargetClass {
+    int offset = 0;
+
+    auto method(int value) -> int {
+        offset += value;
+        return offset;
+    }
+
+    auto constMethod(int value) const -> int {
+        return value + offset;
+    }
+};
+
+TargetClass targetObject{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+constexpr TargetClass constTargetObject{10};
+
+struct StatelessFunctor {
+    auto operator()(int value) const -> int {
+        return value * 2;
+    }
+};
+
+struct StatelessVoidFunctor {
+    void operator()(int /*unused*/) const {
+    }
+};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+#if defined(__cpp_constinit)
+#    define TEST_CONSTINIT constinit
+#else
+// Checks only the runtime behavior
+#    define TEST_CONSTINIT
+#endif
+
+TEST_CONSTINIT rome::delegate<int(int)> functionDelegate =
+    rome::delegate<int(int)>::create<&function>();
+TEST_CONSTINIT rome::delegate<int(int)> methodDelegate =
+    rome::delegate<int(int)>::create<TargetClass, &TargetClass::method>(targetObject);
+TEST_CONSTINIT rome::delegate<int(int)> constMethodDelegate =
+    rome::delegate<int(int)>::create<TargetClass, &TargetClass::constMethod>(constTargetObject);
+TEST_CONSTINIT rome::delegate<int(int)> functorDelegate = StatelessFunctor{};
+TEST_CONSTINIT rome::delegate<int(int)> lambdaDelegate  = [](int value) { return value - 1; };
+TEST_CONSTINIT rome::event_delegate<void(int)> emptyEventDelegate{};
+TEST_CONSTINIT rome::command_delegate<void(int)> commandDelegate = StatelessVoidFunctor{};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+#if defined(__cpp_constexpr_dynamic_alloc) && (__cpp_constexpr_dynamic_alloc >= 201907L)
+constexpr rome::delegate<int(int)> constexprFunctionDelegate =
+    rome::delegate<int(int)>::create<&function>();
+constexpr rome::command_delegate<void(int)> constexprCommandDelegate = StatelessVoidFunctor{};
+#endif
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::delegate - constant initialization") {
+    CHECK(functionDelegate);
+    CHECK(functionDelegate(1) == 2);
+    CHECK(methodDelegate);
+    CHECK(methodDelegate(3) == 3);
+    CHECK(targetObject.offset == 3);
+    CHECK(constMethodDelegate);
+    CHECK(constMethodDelegate(1) == 11);
+    CHECK(functorDelegate);
+    CHECK(functorDelegate(4) == 8);
+    CHECK(lambdaDelegate);
+    CHECK(lambdaDelegate(4) == 3);
+    CHECK(!emptyEventDelegate);
+    emptyEventDelegate(1);
+    CHECK(commandDelegate);
+    commandDelegate(1);
+#if defined(__cpp_constexpr_dynamic_alloc) && (__cpp_constexpr_dynamic_alloc >= 201907L)
+    STATIC_REQUIRE(static_cast<bool>(constexprFunctionDelegate));
+    STATIC_REQUIRE(static_cast<bool>(constexprCommandDelegate));
+    CHECK(constexprFunctionDelegate(41) == 42);
+    constexprCommandDelegate(1);
+#endif
+}
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::delegate - stateless function objects are not stored") {
+    STATIC_REQUIRE(
+        std::is_nothrow_constructible<rome::delegate<int(int)>, StatelessFunctor>::value);
+    STATIC_REQUIRE(
+        std::is_nothrow_constructible<rome::fwd_delegate<void(int)>, StatelessVoidFunctor>::value);
+
+    const test::AllocationCounter counter;
+    auto dgt                 = rome::delegate<int(int)>{StatelessFunctor{}};
+    const auto result        = dgt(21);
+    const auto allocations   = counter.allocations();
+    const auto deallocations = counter.deallocations();
+    CHECK(result == 42);
+    CHECK(allocations == 0);
+    CHECK(deallocations == 0);
+}
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::delegate - a const delegate calls a mutable small target") {
+    const rome::delegate<int()> dgt = [count = 0]() mutable { return ++count; };
+    CHECK(dgt() == 1);
+    CHECK(dgt() == 2);
+}
@@ -0,0 +1,140 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks that delegates of the same signature but different behavior take over the target of each
+// other directly, without wrapping the other delegate as function object.
+
+#include <rome/delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct Target {
+    int* received = nullptr;
+    void operator()(int value) const {
+        *received = value;
+    }
+};
+
+template<typename Delegate>
+constexpr bool is_mandatory =
+    std::is_same<Delegate, rome::delegate<void(int), rome::target_is_mandatory>>::value
+    || std::is_same<Delegate, rome::command_delegate<void(int)>>::value;
+
+template<typename From, typename To>
+struct input_params {
+    using from = From;
+    using to   = To;
+};
+
+}  // namespace
+
+
+// clang-format off
+using test_vector = std::tuple<
+    input_params<     rome::delegate<void(int), rome::target_is_expected>,  rome::delegate<void(int), rome::target_is_optional> >,
+    input_params<     rome::delegate<void(int), rome::target_is_expected>,  rome::delegate<void(int), rome::target_is_mandatory> >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  rome::delegate<void(int), rome::target_is_expected> >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  rome::delegate<void(int), rome::target_is_mandatory> >,
+    input_params<     rome::delegate<void(int), rome::target_is_mandatory>, rome::delegate<void(int), rome::target_is_expected> >,
+    input_params<     rome::delegate<void(int), rome::target_is_mandatory>, rome::delegate<void(int), rome::target_is_optional> >,
+    input_params<     rome::delegate<void(int), rome::target_is_expected>,  rome::event_delegate<void(int)> >,
+    input_params<     rome::delegate<void(int), rome::target_is_expected>,  rome::command_delegate<void(int)> >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  rome::event_delegate<void(int)> >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  rome::command_delegate<void(int)> >,
+    input_params<   rome::event_delegate<void(int)>,                        rome::delegate<void(int), rome::target_is_expected> >,
+    input_params<   rome::event_delegate<void(int)>,                        rome::command_delegate<void(int)> >,
+    input_params< rome::command_delegate<void(int)>,                        rome::delegate<void(int), rome::target_is_optional> >,
+    input_params< rome::command_delegate<void(int)>,                        rome::event_delegate<void(int)> >
+>;
+// clang-format on
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,readability-function-cognitive-complexity)
+TEST_CASE_TEMPLATE_DEFINE("A delegate takes over the target of a delegate with other behavior",
+    InputParams, convert_behavior) {
+    using From = typename InputParams::from;
+    using To   = typename InputParams::to;
+
+    STATIC_REQUIRE(std::is_convertible<From&&, To>::value);
+    STATIC_REQUIRE(std::is_nothrow_constructible<To, From&&>::value == !is_mandatory<To>);
+
+    int received = 0;
+    SUBCASE("Construct") {
+        From from = Target{&received};
+        const test::AllocationCounter counter;
+        To to                    = std::move(from);
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+        CHECK(!from);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+        REQUIRE(to);
+        CHECK(to.template target<Target>() != nullptr);
+        to(42);
+        CHECK(received == 42);
+    }
+    SUBCASE("Assign") {
+        From from = Target{&received};
+        To to     = Target{nullptr};
+        to        = std::move(from);
+        CHECK(!from);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+        to(43);
+        CHECK(received == 43);
+    }
+}
+TEST_CASE_TEMPLATE_APPLY(convert_behavior, test_vector);
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("A delegate taking over an empty delegate is empty") {
+    SUBCASE("target_is_expected") {
+        rome::event_delegate<void(int)> from;
+        rome::delegate<void(int)> to = std::move(from);
+        CHECK(!to);
+        CHECK_THROWS_AS(to(1), rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_optional") {
+        rome::delegate<void(int)> from;
+        rome::event_delegate<void(int)> to = std::move(from);
+        CHECK(!to);
+        CHECK_NOTHROW(to(1));
+    }
+    SUBCASE("target_is_mandatory throws when constructed") {
+        rome::delegate<void(int)> from;
+        CHECK_THROWS_AS(
+            rome::command_delegate<void(int)>{std::move(from)}, rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_mandatory throws when constructed from a moved mandatory delegate") {
+        int received = 0;
+        rome::command_delegate<void(int)> from = Target{&received};
+        auto other                             = std::move(from);
+        // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+        CHECK_THROWS_AS((rome::delegate<void(int), rome::target_is_mandatory>{std::move(from)}),
+            rome::bad_delegate_call);
+        other(1);
+        CHECK(received == 1);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("Delegates with non-void return take over the target of each other") {
+    rome::delegate<int(int), rome::target_is_mandatory> from = [](int value) { return value + 1; };
+    rome::delegate<int(int)> to                             = std::move(from);
+    CHECK(!from);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(to(1) == 2);
+    auto created = rome::delegate<int(int), rome::target_is_mandatory>::create(std::move(to));
+    CHECK(!to);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(created(2) == 3);
+}
@@ -0,0 +1,186 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::delegate_array`, which stores the targets in separate columns.
+
+#include <rome/delegate_array.hpp>
+
+#include <doctest/doctest.h>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+struct Recorder {
+    std::vector<int>* calls;
+    int id;
+    void operator()(int value) const {
+        calls->push_back(id * 100 + value);
+    }
+};
+
+struct BigRecorder {
+    std::vector<int>* calls;
+    int id;
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    void operator()(int value) const {
+        calls->push_back(id * 100 + value);
+    }
+};
+
+struct Counter {
+    int count = 0;
+    void operator()(int /*unused*/) {
+        ++count;
+    }
+};
+
+struct Listener {
+    std::vector<int>* calls;
+    void notify(int value) {
+        calls->push_back(value);
+    }
+    void peek(int value) const {
+        calls->push_back(-value);
+    }
+};
+
+struct Destructible {
+    int* destructions;
+    explicit Destructible(int* counter) noexcept : destructions{counter} {
+    }
+    Destructible(Destructible&& other) noexcept : destructions{other.destructions} {
+        other.destructions = nullptr;
+    }
+    Destructible(const Destructible&)                    = delete;
+    auto operator=(const Destructible&) -> Destructible& = delete;
+    auto operator=(Destructible&&) -> Destructible&      = delete;
+    ~Destructible() {
+        if (destructions != nullptr) {
+            ++*destructions;
+        }
+    }
+    void operator()(int /*unused*/) const {
+    }
+};
+
+std::vector<int>* functionCalls = nullptr;
+
+void function(int value) {
+    functionCalls->push_back(1000 + value);
+}
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_array calls all kinds of targets in order") {
+    std::vector<int> calls;
+    functionCalls = &calls;
+    Listener listener{&calls};
+
+    rome::delegate_array<void(int)> array;
+    CHECK(array.empty());
+    array.push_back(Recorder{&calls, 1});
+    array.push_back(BigRecorder{&calls, 2});
+    array.push_back<&function>();
+    array.push_back<Listener, &Listener::notify>(listener);
+    array.push_back<Listener, &Listener::peek>(static_cast<const Listener&>(listener));
+    array.push_back([&calls](int value) { calls.push_back(value * 2); });
+    REQUIRE(array.size() == 6);
+
+    array.invoke_all(5);
+    CHECK(calls == std::vector<int>{105, 205, 1005, 5, -5, 10});
+
+    calls.clear();
+    array.invoke(1, 7);
+    CHECK(calls == std::vector<int>{207});
+    functionCalls = nullptr;
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_array stores function objects like delegate") {
+    rome::delegate_array<void(int)> array;
+    array.reserve(3);
+    std::vector<int> calls;
+    const test::AllocationCounter counter;
+    array.push_back([](int /*unused*/) {});
+    auto& stored = array.emplace_back<Counter>();
+    array.emplace_back<BigRecorder>(BigRecorder{&calls, 2});
+    const auto allocations = counter.allocations();
+    CHECK(allocations == 1);
+
+    array.invoke_all(1);
+    array.invoke(1, 1);
+    CHECK(stored.count == 2);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_array destroys its targets") {
+    int destructions = 0;
+    rome::delegate_array<void(int)> array;
+    array.emplace_back<Destructible>(&destructions);
+    array.push_back(Destructible{&destructions});
+    CHECK(destructions == 0);
+
+    SUBCASE("clear") {
+        array.clear();
+        CHECK(destructions == 2);
+        CHECK(array.empty());
+    }
+    SUBCASE("Destructor") {
+        { const auto moved = std::move(array); }
+        CHECK(destructions == 2);
+    }
+    SUBCASE("Move assignment") {
+        rome::delegate_array<void(int)> other;
+        other.emplace_back<Destructible>(&destructions);
+        array = std::move(other);
+        CHECK(destructions == 2);
+        CHECK(array.size() == 1);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("sort_by_target groups targets of the same type and keeps their relative order") {
+    std::vector<int> calls;
+    rome::delegate_array<void(int)> array;
+    array.push_back(Recorder{&calls, 1});
+    array.push_back(BigRecorder{&calls, 2});
+    array.push_back(Recorder{&calls, 3});
+    array.push_back(BigRecorder{&calls, 4});
+    array.push_back(Recorder{&calls, 5});
+
+    array.sort_by_target();
+    REQUIRE(array.size() == 5);
+    array.invoke_all(0);
+
+    std::vector<int> recorders;
+    std::vector<int> bigRecorders;
+    for (const auto call : calls) {
+        (call % 200 == 0 ? bigRecorders : recorders).push_back(call);
+    }
+    CHECK(recorders == std::vector<int>{100, 300, 500});
+    CHECK(bigRecorders == std::vector<int>{200, 400});
+    const bool grouped = (calls == std::vector<int>{100, 300, 500, 200, 400})
+                         || (calls == std::vector<int>{200, 400, 100, 300, 500});
+    CHECK(grouped);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_array with non-void return type") {
+    rome::delegate_array<int(int)> array;
+    array.push_back([](int value) { return value + 1; });
+    array.push_back([](int value) { return value * 2; });
+    CHECK(array.invoke(0, 3) == 4);
+    CHECK(array.invoke(1, 3) == 6);
+    CHECK_NOTHROW(array.invoke_all(3));
+}
@@ -0,0 +1,169 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::delegate_bundle`, which calls several member functions of one object.
+
+#include <rome/delegate_bundle.hpp>
+
+#include <doctest/doctest.h>
+#include <string>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct Motor {
+    int speed = 0;
+    bool on   = false;
+
+    void start() {
+        on = true;
+    }
+    void stop() {
+        on = false;
+    }
+    void set_speed(int value) {
+        speed = value;
+    }
+    auto status(int code) -> std::string {
+        return "motor " + std::to_string(code) + (on ? " on" : " off");
+    }
+};
+
+struct Lamp {
+    int brightness = 0;
+
+    void switch_on() {
+        brightness = 100;
+    }
+    void switch_off() {
+        brightness = 0;
+    }
+    void dim(int value) {
+        brightness = value;
+    }
+    auto describe(int code) -> std::string {
+        return "lamp " + std::to_string(code);
+    }
+};
+
+struct Sensor {
+    int value = 0;
+
+    void reset() {
+        value = 0;
+    }
+    auto read() const -> int {
+        return value;
+    }
+    auto describe(int code) const -> std::string {
+        return "sensor " + std::to_string(code) + " " + std::to_string(value);
+    }
+};
+
+using Device = rome::delegate_bundle<void(), void(), void(int), std::string(int)>;
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_bundle has the size of two pointers for any number of signatures") {
+    STATIC_REQUIRE(sizeof(Device) == 2 * sizeof(void*));
+    STATIC_REQUIRE(sizeof(rome::delegate_bundle<void()>) == 2 * sizeof(void*));
+    STATIC_REQUIRE(std::is_trivially_copyable<Device>::value);
+    STATIC_REQUIRE(std::is_same<Device::signature<3>, std::string(int)>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_bundle calls the member function of each signature") {
+    Motor motor;
+    auto device = Device::of<Motor>::methods<&Motor::start, &Motor::stop, &Motor::set_speed,
+        &Motor::status>::create(motor);
+    CHECK(device);
+    CHECK(device != nullptr);
+
+    device.get<0>()();
+    CHECK(motor.on);
+    device.get<2>()(42);
+    CHECK(motor.speed == 42);
+    CHECK(device.get<3>()(7) == "motor 7 on");
+    device.get<1>()();
+    CHECK(!motor.on);
+
+    SUBCASE("Elements refer to the object, not to the bundle") {
+        const auto setSpeed = device.get<2>();
+        device              = nullptr;
+        setSpeed(3);
+        CHECK(motor.speed == 3);
+    }
+    SUBCASE("Copies refer to the same object") {
+        const auto copy = device;
+        copy.get<2>()(5);
+        CHECK(motor.speed == 5);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_bundles of unrelated classes are interchangeable") {
+    Motor motor;
+    Lamp lamp;
+    using MotorMethods =
+        Device::of<Motor>::methods<&Motor::start, &Motor::stop, &Motor::set_speed, &Motor::status>;
+    using LampMethods =
+        Device::of<Lamp>::methods<&Lamp::switch_on, &Lamp::switch_off, &Lamp::dim, &Lamp::describe>;
+    const Device devices[] = {// NOLINT(cppcoreguidelines-avoid-c-arrays)
+        MotorMethods::create(motor), LampMethods::create(lamp)};
+
+    for (const auto& device : devices) {
+        device.get<0>()();
+    }
+    CHECK(motor.on);
+    CHECK(lamp.brightness == 100);
+    for (const auto& device : devices) {
+        device.get<2>()(10);
+    }
+    CHECK(motor.speed == 10);
+    CHECK(lamp.brightness == 10);
+    CHECK(devices[1].get<3>()(1) == "lamp 1");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("An empty delegate_bundle throws when called") {
+    Device device;
+    CHECK(!device);
+    CHECK(nullptr == device);
+    CHECK_THROWS_AS(device.get<0>()(), rome::bad_delegate_call);
+    CHECK_THROWS_AS(device.get<3>()(1), rome::bad_delegate_call);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_bundle calls const member functions for const qualified signatures") {
+    Sensor sensor{5};
+    using Reader = rome::delegate_bundle<int() const, std::string(int) const>;
+    STATIC_REQUIRE(std::is_same<Reader::signature<0>, int() const>::value);
+    STATIC_REQUIRE(std::is_same<Reader::element_type<0>,
+        rome::delegate_bundle<int()>::element_type<0>>::value);
+
+    SUBCASE("mixed with non-const member functions") {
+        using Resettable = rome::delegate_bundle<void(), int() const>;
+        const auto bundle =
+            Resettable::of<Sensor>::methods<&Sensor::reset, &Sensor::read>::create(sensor);
+        CHECK(bundle.get<1>()() == 5);
+        bundle.get<0>()();
+        CHECK(bundle.get<1>()() == 0);
+    }
+    SUBCASE("of a const object") {
+        const Sensor& constSensor = sensor;
+        const auto reader =
+            Reader::of<Sensor>::methods<&Sensor::read, &Sensor::describe>::create(constSensor);
+        CHECK(reader.get<0>()() == 5);
+        CHECK(reader.get<1>()(2) == "sensor 2 5");
+    }
+}
@@ -0,0 +1,181 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::delegate_registry`, a slot map of event delegates with generational connections.
+
+#include <rome/delegate_registry.hpp>
+
+#include <doctest/doctest.h>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+using Registry = rome::delegate_registry<void(int)>;
+
+struct Adder {
+    int* sum;
+    int factor;
+    void operator()(int value) const {
+        *sum += factor * value;
+    }
+};
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_registry types") {
+    STATIC_REQUIRE(std::is_same<Registry::delegate_type, rome::event_delegate<void(int)>>::value);
+    STATIC_REQUIRE(std::is_trivially_copyable<Registry::connection>::value);
+    STATIC_REQUIRE(sizeof(Registry::connection) == 8);
+    STATIC_REQUIRE(!std::is_copy_constructible<Registry::scoped_connection>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<Registry::scoped_connection>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<Registry>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<Registry>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_registry calls all connected event delegates") {
+    int sum = 0;
+    Registry registry;
+    CHECK(registry.empty());
+    registry(1);
+
+    const auto a = registry.connect(Adder{&sum, 1});
+    const auto b = registry.connect(Adder{&sum, 10});
+    const auto c = registry.connect(Adder{&sum, 100});
+    CHECK(registry.size() == 3);
+    CHECK(a != b);
+    CHECK(registry.contains(a));
+    CHECK(registry.contains(b));
+    CHECK(registry.contains(c));
+    CHECK(!registry.contains(Registry::connection{}));
+    registry(1);
+    CHECK(sum == 111);
+
+    sum = 0;
+    CHECK(registry.disconnect(a));
+    CHECK(registry.size() == 2);
+    registry(1);
+    CHECK(sum == 110);
+    REQUIRE(registry.find(c) != nullptr);
+    CHECK(registry.find(c)->target<Adder>()->factor == 100);
+    CHECK(registry.find(a) == nullptr);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_registry detects stale connections") {
+    int sum = 0;
+    Registry registry;
+    const auto a = registry.connect(Adder{&sum, 1});
+    CHECK(registry.disconnect(a));
+    CHECK(!registry.contains(a));
+    CHECK(!registry.disconnect(a));
+
+    // the slot of `a` is reused with a new generation
+    const auto b = registry.connect(Adder{&sum, 2});
+    CHECK(a != b);
+    CHECK(!registry.contains(a));
+    CHECK(registry.contains(b));
+    CHECK(!registry.disconnect(a));
+    CHECK(registry.size() == 1);
+    registry(1);
+    CHECK(sum == 2);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_registry keeps connections valid when event delegates are moved") {
+    int sum = 0;
+    Registry registry;
+    Registry::connection connections[8];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    for (int i = 0; i < 8; ++i) {
+        connections[i] = registry.connect(Adder{&sum, 1 << i});
+    }
+    CHECK(registry.disconnect(connections[0]));
+    CHECK(registry.disconnect(connections[5]));
+    CHECK(registry.disconnect(connections[3]));
+    for (const int i : {1, 2, 4, 6, 7}) {
+        REQUIRE(registry.find(connections[i]) != nullptr);
+        CHECK(registry.find(connections[i])->target<Adder>()->factor == 1 << i);
+    }
+    registry(1);
+    CHECK(sum == 2 + 4 + 16 + 64 + 128);
+
+    registry.clear();
+    CHECK(registry.empty());
+    for (const auto& conn : connections) {
+        CHECK(!registry.contains(conn));
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_registry scoped_connection disconnects when destroyed") {
+    int sum = 0;
+    Registry registry;
+    {
+        auto scoped = registry.connect_scoped(Adder{&sum, 1});
+        CHECK(scoped.connected());
+        CHECK(registry.contains(scoped.get()));
+        registry(1);
+    }
+    CHECK(registry.empty());
+    registry(1);
+    CHECK(sum == 1);
+
+    SUBCASE("move") {
+        Registry::scoped_connection outer;
+        CHECK(!outer.connected());
+        {
+            auto inner = registry.connect_scoped(Adder{&sum, 1});
+            outer      = std::move(inner);
+            // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+            CHECK(!inner.connected());
+        }
+        CHECK(outer.connected());
+        CHECK(registry.size() == 1);
+        outer.disconnect();
+        CHECK(!outer.connected());
+        CHECK(registry.empty());
+    }
+    SUBCASE("release") {
+        Registry::connection conn;
+        {
+            auto scoped = registry.connect_scoped(Adder{&sum, 1});
+            conn        = scoped.release();
+            CHECK(!scoped.connected());
+        }
+        CHECK(registry.contains(conn));
+    }
+    SUBCASE("explicitly disconnected") {
+        auto scoped = registry.connect_scoped(Adder{&sum, 1});
+        CHECK(registry.disconnect(scoped.get()));
+        CHECK(!scoped.connected());
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("delegate_registry does not allocate after reserve") {
+    int sum = 0;
+    Registry registry;
+    registry.reserve(4);
+    const test::AllocationCounter counter;
+    for (int round = 0; round < 3; ++round) {
+        auto a = registry.connect([&sum](int value) { sum += value; });
+        auto b = registry.connect_scoped([&sum](int value) { sum += value; });
+        registry(1);
+        (void)registry.disconnect(a);
+    }
+    const auto allocations = counter.allocations();
+    CHECK(allocations == 0);
+    CHECK(sum == 6);
+}
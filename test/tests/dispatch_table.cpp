@@ -0,0 +1,134 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::dispatch_table`, which calls one of several delegates selected by a key.
+
+#include <rome/dispatch_table.hpp>
+
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <string>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+
+
+namespace {
+
+enum class MessageId : std::uint8_t { ping, data, close };
+
+struct Frame {
+    int value;
+};
+
+struct Log {
+    std::string text;
+};
+
+void appendPing(Log& log, const Frame& frame) {
+    log.text += "ping " + std::to_string(frame.value) + ";";
+}
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("dispatch_table calls the handler of the key") {
+    using Table = rome::dispatch_table<MessageId, void(const Frame&), MessageId::ping,
+        MessageId::data, MessageId::close>;
+    STATIC_REQUIRE(Table::size() == 3);
+    STATIC_REQUIRE(std::is_same<typename Table::delegate_type,
+        rome::delegate<void(const Frame&), rome::target_is_expected>>::value);
+
+    Log log;
+    Table table;
+    table.get<MessageId::ping>() = [&log](const Frame& frame) { appendPing(log, frame); };
+    table.get<MessageId::data>() = [&log](const Frame& frame) {
+        log.text += "data " + std::to_string(frame.value) + ";";
+    };
+    table.get<MessageId::close>() = [&log](const Frame& /*unused*/) { log.text += "close;"; };
+
+    table(MessageId::data, Frame{2});
+    table(MessageId::ping, Frame{1});
+    table(MessageId::close, Frame{0});
+    CHECK(log.text == "data 2;ping 1;close;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("dispatch_table finds the handler of a key at runtime") {
+    using Table = rome::dispatch_table<int, int(int), 7, -3, 1000, 42>;
+    Table table;
+    table.get<7>()    = [](int value) { return value + 7; };
+    table.get<-3>()   = [](int value) { return value - 3; };
+    table.get<1000>() = [](int value) { return value * 1000; };
+    table.get<42>()   = [](int value) { return value * 42; };
+
+    CHECK(Table::contains(7));
+    CHECK(Table::contains(-3));
+    CHECK(Table::contains(1000));
+    CHECK(Table::contains(42));
+    CHECK(!Table::contains(0));
+    CHECK(!Table::contains(8));
+    CHECK(!Table::contains(-1));
+
+    REQUIRE(table.find(1000) != nullptr);
+    CHECK((*table.find(1000))(2) == 2000);
+    CHECK(table.find(1001) == nullptr);
+    CHECK(table(7, 1) == 8);
+    CHECK(table(-3, 1) == -2);
+    CHECK(table(42, 1) == 42);
+
+    const auto& constTable = table;
+    REQUIRE(constTable.find(-3) != nullptr);
+    CHECK(&constTable.get<-3>() == constTable.find(-3));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("dispatch_table with many sparse keys") {
+    using Table = rome::dispatch_table<std::uint32_t, std::uint32_t(), 0x1000U, 0x2000U, 0x3000U,
+        0x4000U, 0x10000U, 0x20000U, 0x30000U, 0x40000U, 17U, 33U, 65U, 129U, 0xFFFFFFFFU>;
+    Table table;
+    table.get<0x1000U>()     = []() { return 0x1000U; };
+    table.get<0x20000U>()    = []() { return 0x20000U; };
+    table.get<129U>()        = []() { return 129U; };
+    table.get<0xFFFFFFFFU>() = []() { return 0xFFFFFFFFU; };
+    CHECK(table(0x1000U) == 0x1000U);
+    CHECK(table(0x20000U) == 0x20000U);
+    CHECK(table(129U) == 129U);
+    CHECK(table(0xFFFFFFFFU) == 0xFFFFFFFFU);
+    for (std::uint32_t key = 0U; key < 0x50000U; ++key) {
+        const bool known = key == 0x1000U || key == 0x2000U || key == 0x3000U || key == 0x4000U
+                           || key == 0x10000U || key == 0x20000U || key == 0x30000U
+                           || key == 0x40000U || key == 17U || key == 33U || key == 65U
+                           || key == 129U;
+        if (Table::contains(key) != known) {
+            FAIL("wrong result of contains for key " << key);
+        }
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("dispatch_table calls the fallback handler for unknown keys") {
+    SUBCASE("target_is_expected") {
+        rome::dispatch_table<int, int(int), 1, 2> table;
+        CHECK_THROWS_AS(table(3, 0), rome::bad_delegate_call);
+        CHECK_THROWS_AS(table(1, 0), rome::bad_delegate_call);
+        table.fallback() = [](int value) { return -value; };
+        CHECK(table(3, 5) == -5);
+        CHECK_THROWS_AS(table(1, 0), rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_optional") {
+        int calls = 0;
+        rome::basic_dispatch_table<int, void(int), rome::target_is_optional, 1, 2> table;
+        CHECK_NOTHROW(table(3, 0));
+        CHECK_NOTHROW(table(1, 0));
+        table.fallback() = [&calls](int /*unused*/) { ++calls; };
+        table(3, 0);
+        table(1, 0);
+        CHECK(calls == 1);
+    }
+}
@@ -0,0 +1,186 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks that `emplace<F>(args...)` and the constructor taking `rome::in_place_type<F>` construct
+// the target directly in its final location.
+
+#include <rome/delegate.hpp>
+#include <rome/variant_delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <stdexcept>
+#include <test/doctest_extensions.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+// Counts the copies and moves of all function objects.
+int relocations = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+struct StatelessFunctor {
+    void operator()(int /*unused*/) const {
+    }
+};
+
+struct SmallFunctor {
+    int* received = nullptr;
+
+    explicit SmallFunctor(int* target) noexcept : received{target} {
+    }
+    SmallFunctor(const SmallFunctor& other) noexcept : received{other.received} {
+        ++relocations;
+    }
+    SmallFunctor(SmallFunctor&& other) noexcept : received{other.received} {
+        ++relocations;
+    }
+    ~SmallFunctor()                                        = default;
+    auto operator=(const SmallFunctor&) -> SmallFunctor& = delete;
+    auto operator=(SmallFunctor&&) -> SmallFunctor&      = delete;
+
+    void operator()(int value) const {
+        *received = value;
+    }
+};
+
+struct BigFunctor {
+    int* received  = nullptr;
+    int offset     = 0;
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    // throws if `offset` is negative
+    BigFunctor(int* target, int offsetValue) : received{target}, offset{offsetValue} {
+        if (offset < 0) {
+            throw std::invalid_argument{"negative offset"};
+        }
+    }
+    BigFunctor(const BigFunctor& other) : received{other.received}, offset{other.offset} {
+        ++relocations;
+    }
+    BigFunctor(BigFunctor&& other) noexcept : received{other.received}, offset{other.offset} {
+        ++relocations;
+    }
+    ~BigFunctor()                                      = default;
+    auto operator=(const BigFunctor&) -> BigFunctor& = delete;
+    auto operator=(BigFunctor&&) -> BigFunctor&      = delete;
+
+    void operator()(int value) const {
+        *received = value + offset;
+    }
+};
+
+}  // namespace
+
+
+// clang-format off
+using test_vector = std::tuple<
+         rome::delegate<void(int), rome::target_is_expected>,
+         rome::delegate<void(int), rome::target_is_optional>,
+         rome::delegate<void(int), rome::target_is_mandatory>,
+     rome::fwd_delegate<void(int), rome::target_is_expected>,
+     rome::fwd_delegate<void(int), rome::target_is_optional>,
+     rome::fwd_delegate<void(int), rome::target_is_mandatory>
+>;
+// clang-format on
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,readability-function-cognitive-complexity)
+TEST_CASE_TEMPLATE_DEFINE("Constructing the target in place", Delegate, in_place_construction) {
+    STATIC_REQUIRE(std::is_nothrow_constructible<Delegate, rome::in_place_type_t<SmallFunctor>,
+        int*>::value);
+    STATIC_REQUIRE(std::is_nothrow_constructible<Delegate,
+        rome::in_place_type_t<StatelessFunctor>>::value);
+    STATIC_REQUIRE(!std::is_nothrow_constructible<Delegate, rome::in_place_type_t<BigFunctor>,
+        int*, int>::value);
+    STATIC_REQUIRE(!std::is_convertible<rome::in_place_type_t<SmallFunctor>, Delegate>::value);
+    STATIC_REQUIRE(noexcept(std::declval<Delegate&>().template emplace<SmallFunctor>(nullptr)));
+    STATIC_REQUIRE(!noexcept(std::declval<Delegate&>().template emplace<BigFunctor>(nullptr, 0)));
+    STATIC_REQUIRE(std::is_same<decltype(std::declval<Delegate&>().template emplace<BigFunctor>(
+                                    nullptr, 0)),
+        BigFunctor&>::value);
+
+    relocations  = 0;
+    int received = 0;
+    SUBCASE("small function object") {
+        Delegate dgt{rome::in_place_type<SmallFunctor>, &received};
+        dgt(1);
+        CHECK(received == 1);
+        CHECK(dgt.template target<SmallFunctor>() != nullptr);
+    }
+    SUBCASE("big function object") {
+        Delegate dgt{rome::in_place_type<BigFunctor>, &received, 10};
+        dgt(1);
+        CHECK(received == 11);
+        CHECK(dgt.template target<BigFunctor>() != nullptr);
+    }
+    SUBCASE("stateless function object") {
+        Delegate dgt{rome::in_place_type<StatelessFunctor>};
+        CHECK(dgt);
+        CHECK(dgt.template target<StatelessFunctor>() != nullptr);
+    }
+    SUBCASE("emplace") {
+        Delegate dgt{rome::in_place_type<SmallFunctor>, &received};
+        auto& big = dgt.template emplace<BigFunctor>(&received, 20);
+        CHECK(&big == dgt.template target<BigFunctor>());
+        big.offset = 30;
+        dgt(1);
+        CHECK(received == 31);
+
+        auto& small = dgt.template emplace<SmallFunctor>(&received);
+        CHECK(&small == dgt.template target<SmallFunctor>());
+        dgt(2);
+        CHECK(received == 2);
+    }
+    SUBCASE("emplace keeps the current target if the construction throws") {
+        Delegate dgt{rome::in_place_type<BigFunctor>, &received, 1};
+        CHECK_THROWS_AS(dgt.template emplace<BigFunctor>(&received, -1), std::invalid_argument);
+        REQUIRE(dgt);
+        dgt(1);
+        CHECK(received == 2);
+    }
+    CHECK(relocations == 0);
+}
+TEST_CASE_TEMPLATE_APPLY(in_place_construction, test_vector);
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::variant_delegate - constructing the target in place") {
+    using variant =
+        rome::variant_delegate<void(int), rome::target_is_mandatory, SmallFunctor, BigFunctor>;
+    STATIC_REQUIRE(
+        std::is_nothrow_constructible<variant, rome::in_place_type_t<SmallFunctor>, int*>::value);
+    STATIC_REQUIRE(!std::is_nothrow_constructible<variant, rome::in_place_type_t<BigFunctor>, int*,
+        int>::value);
+    STATIC_REQUIRE(
+        !std::is_constructible<variant, rome::in_place_type_t<StatelessFunctor>>::value);
+
+    relocations  = 0;
+    int received = 0;
+    variant dgt{rome::in_place_type<SmallFunctor>, &received};
+    dgt(1);
+    CHECK(received == 1);
+    CHECK(relocations == 0);
+
+    // BigFunctor may throw when constructed, it is constructed aside and moved once
+    auto& big  = dgt.emplace<BigFunctor>(&received, 10);
+    big.offset = 20;
+    dgt(1);
+    CHECK(received == 21);
+    CHECK(relocations == 1);
+
+    CHECK_THROWS_AS(dgt.emplace<BigFunctor>(&received, -1), std::invalid_argument);
+    dgt(2);
+    CHECK(received == 22);
+
+    auto& small = dgt.emplace<SmallFunctor>(&received);
+    CHECK(small.received == &received);
+    dgt(3);
+    CHECK(received == 3);
+    CHECK(relocations == 1);
+}
@@ -0,0 +1,246 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::event_bus`, which publishes messages to the event delegates subscribed to their
+// type.
+
+#include <rome/event_bus.hpp>
+
+#include <doctest/doctest.h>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct Started {
+    int id;
+};
+
+struct Stopped {
+    std::string reason;
+};
+
+using Bus = rome::event_bus<4, Started, Stopped>;
+
+struct Recorder {
+    std::string* log;
+    char name;
+    void operator()(const Started& msg) const {
+        *log += std::string{name} + ":started " + std::to_string(msg.id) + ";";
+    }
+};
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus publishes a message to all subscribers of its type") {
+    STATIC_REQUIRE(!std::is_copy_constructible<Bus>::value);
+    STATIC_REQUIRE(!std::is_move_constructible<Bus>::value);
+    STATIC_REQUIRE(std::is_same<Bus::delegate_type<Started>,
+        rome::event_delegate<void(const Started&)>>::value);
+
+    std::string log;
+    Bus bus;
+    auto a = bus.subscribe<Started>(Recorder{&log, 'a'});
+    auto b = bus.subscribe<Started>(Recorder{&log, 'b'});
+    auto c = bus.subscribe<Stopped>([&log](const Stopped& msg) { log += "stopped " + msg.reason; });
+    CHECK(a);
+    CHECK(b);
+    CHECK(c);
+    CHECK(bus.subscriber_count<Started>() == 2);
+    CHECK(bus.subscriber_count<Stopped>() == 1);
+
+    bus.publish(Started{7});
+    bus.publish(Stopped{"done"});
+    CHECK(log == "a:started 7;b:started 7;stopped done");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus without subscribers") {
+    const Bus bus;
+    CHECK(bus.subscriber_count<Started>() == 0);
+    CHECK_NOTHROW(bus.publish(Started{1}));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus unsubscribes and reuses the slots") {
+    std::string log;
+    Bus bus;
+    auto a = bus.subscribe<Started>(Recorder{&log, 'a'});
+    auto b = bus.subscribe<Started>(Recorder{&log, 'b'});
+    auto c = bus.subscribe<Started>(Recorder{&log, 'c'});
+
+    bus.unsubscribe(b);
+    CHECK(!b);
+    CHECK(bus.subscriber_count<Started>() == 2);
+    bus.unsubscribe(b);  // does nothing
+    CHECK(bus.subscriber_count<Started>() == 2);
+    bus.publish(Started{1});
+    CHECK(log == "a:started 1;c:started 1;");
+
+    log.clear();
+    auto d = bus.subscribe<Started>(Recorder{&log, 'd'});
+    bus.publish(Started{2});
+    CHECK(log == "a:started 2;d:started 2;c:started 2;");
+
+    bus.unsubscribe(a);
+    bus.unsubscribe(c);
+    bus.unsubscribe(d);
+    CHECK(bus.subscriber_count<Started>() == 0);
+    log.clear();
+    bus.publish(Started{3});
+    CHECK(log.empty());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus stops publishing to trailing free slots") {
+    std::string log;
+    Bus bus;
+    auto a = bus.subscribe<Started>(Recorder{&log, 'a'});
+    auto b = bus.subscribe<Started>(Recorder{&log, 'b'});
+    auto c = bus.subscribe<Started>(Recorder{&log, 'c'});
+    auto d = bus.subscribe<Started>(Recorder{&log, 'd'});
+    bus.unsubscribe(d);
+    bus.unsubscribe(b);
+    bus.unsubscribe(c);  // the slots of b, c and d are trailing free slots now
+    CHECK(bus.subscriber_count<Started>() == 1);
+
+    // new subscriptions take the trailing slots in order, not the freed ones in reverse order
+    auto e = bus.subscribe<Started>(Recorder{&log, 'e'});
+    auto f = bus.subscribe<Started>(Recorder{&log, 'f'});
+    bus.publish(Started{1});
+    CHECK(log == "a:started 1;e:started 1;f:started 1;");
+
+    bus.unsubscribe(a);
+    bus.unsubscribe(f);
+    bus.unsubscribe(e);
+    CHECK(bus.subscriber_count<Started>() == 0);
+    auto g = bus.subscribe<Started>(Recorder{&log, 'g'});
+    log.clear();
+    bus.publish(Started{2});
+    CHECK(log == "g:started 2;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus returns an invalid subscription if the topic is full") {
+    int calls = 0;
+    Bus bus;
+    rome::subscription<Started> handles[4];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    for (auto& handle : handles) {
+        handle = bus.subscribe<Started>([&calls](const Started& /*unused*/) { ++calls; });
+        CHECK(handle);
+    }
+    auto full = bus.subscribe<Started>([&calls](const Started& /*unused*/) { calls += 100; });
+    CHECK(!full);
+    bus.publish(Started{1});
+    CHECK(calls == 4);
+
+    bus.unsubscribe(handles[2]);
+    auto reused = bus.subscribe<Started>([&calls](const Started& /*unused*/) { calls += 10; });
+    CHECK(reused);
+    bus.publish(Started{1});
+    CHECK(calls == 17);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus subscriptions can be moved but not copied") {
+    STATIC_REQUIRE(!std::is_copy_constructible<rome::subscription<Started>>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<rome::subscription<Started>>::value);
+
+    std::string log;
+    Bus bus;
+    auto a     = bus.subscribe<Started>(Recorder{&log, 'a'});
+    auto moved = std::move(a);
+    CHECK(!a);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(moved);
+    bus.unsubscribe(a);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    CHECK(bus.subscriber_count<Started>() == 1);
+    bus.unsubscribe(moved);
+    CHECK(bus.subscriber_count<Started>() == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus subscriptions unsubscribe when destroyed or assigned") {
+    std::string log;
+    Bus bus;
+    {
+        auto scoped = bus.subscribe<Started>(Recorder{&log, 's'});
+        CHECK(bus.subscriber_count<Started>() == 1);
+    }
+    CHECK(bus.subscriber_count<Started>() == 0);
+
+    auto a = bus.subscribe<Started>(Recorder{&log, 'a'});
+    a      = bus.subscribe<Started>(Recorder{&log, 'b'});
+    CHECK(a);
+    CHECK(bus.subscriber_count<Started>() == 1);
+    bus.publish(Started{1});
+    CHECK(log == "b:started 1;");
+
+    a.unsubscribe();
+    CHECK(!a);
+    CHECK(bus.subscriber_count<Started>() == 0);
+    a.unsubscribe();  // does nothing
+    CHECK(bus.subscriber_count<Started>() == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus subscriptions can be released") {
+    std::string log;
+    Bus bus;
+    {
+        auto released = bus.subscribe<Started>(Recorder{&log, 'r'});
+        released.release();
+        CHECK(!released);
+    }
+    CHECK(bus.subscriber_count<Started>() == 1);
+    bus.publish(Started{2});
+    CHECK(log == "r:started 2;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus ignores subscriptions of another bus") {
+    std::string log;
+    Bus bus;
+    Bus other;
+    auto a = bus.subscribe<Started>(Recorder{&log, 'a'});
+    other.unsubscribe(a);
+    CHECK(a);
+    CHECK(bus.subscriber_count<Started>() == 1);
+    bus.unsubscribe(a);
+    CHECK(!a);
+    CHECK(bus.subscriber_count<Started>() == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus accepts event delegates") {
+    std::string log;
+    Bus bus;
+    rome::event_delegate<void(const Started&)> dgt = Recorder{&log, 'e'};
+    auto handle                                    = bus.subscribe<Started>(std::move(dgt));
+    CHECK(handle);
+    bus.publish(Started{5});
+    CHECK(log == "e:started 5;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("event_bus does not allocate for small subscribers") {
+    int calls = 0;
+    Bus bus;
+    const test::AllocationCounter counter;
+    auto a = bus.subscribe<Started>([&calls](const Started& /*unused*/) { ++calls; });
+    bus.publish(Started{1});
+    bus.unsubscribe(a);
+    const auto allocations = counter.allocations();
+    CHECK(allocations == 0);
+    CHECK(calls == 1);
+}
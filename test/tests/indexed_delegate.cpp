@@ -0,0 +1,128 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::indexed_delegate`, which calls its target on an object of an arena passed by the
+// caller.
+
+#include <rome/indexed_delegate.hpp>
+
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <vector>
+
+
+namespace {
+
+struct Entity {
+    int position = 0;
+    int speed    = 1;
+
+    void move(int ticks) {
+        position += speed * ticks;
+    }
+    void stop(int /*unused*/) {
+        speed = 0;
+    }
+    auto distance(int target) const -> int {
+        return target - position;
+    }
+};
+
+void accelerate(Entity& entity, int amount) {
+    entity.speed += amount;
+}
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("indexed_delegate has the size of two 32 bit indices and is trivially copyable") {
+    using Delegate = rome::indexed_delegate<void(int), Entity>;
+    STATIC_REQUIRE(sizeof(Delegate) == 2 * sizeof(std::uint32_t));
+    STATIC_REQUIRE(std::is_trivially_copyable<Delegate>::value);
+    STATIC_REQUIRE(std::is_trivially_copyable<
+        rome::indexed_delegate<void(int), Entity, rome::target_is_mandatory>>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("indexed_delegate calls its target on the object at its index of the arena") {
+    std::vector<Entity> arena(3);
+
+    auto move = rome::indexed_delegate<void(int), Entity>::create<&Entity::move>(1);
+    CHECK(move);
+    CHECK(move != nullptr);
+    CHECK(move.index() == 1);
+    move(arena.data(), 5);
+    CHECK(arena[0].position == 0);
+    CHECK(arena[1].position == 5);
+    CHECK(arena[2].position == 0);
+
+    auto accelerateLast = rome::indexed_delegate<void(int), Entity>::create<&accelerate>(2);
+    accelerateLast(arena.data(), 2);
+    CHECK(arena[2].speed == 3);
+
+    auto distance =
+        rome::indexed_delegate<int(int), Entity, rome::target_is_mandatory>::create<
+            &Entity::distance>(1);
+    CHECK(distance(arena.data(), 7) == 2);
+
+    SUBCASE("The arena can change between calls") {
+        std::vector<Entity> other(2);
+        move(other.data(), 3);
+        CHECK(other[1].position == 3);
+        CHECK(arena[1].position == 5);
+    }
+    SUBCASE("Copies call the same target") {
+        auto copy = move;
+        copy(arena.data(), 1);
+        CHECK(arena[1].position == 6);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("indexed_delegates of different targets share the arena") {
+    using Delegate = rome::indexed_delegate<void(int), Entity>;
+    std::vector<Entity> arena(2);
+    std::vector<Delegate> handlers = {Delegate::create<&Entity::move>(0),
+        Delegate::create<&Entity::stop>(1), Delegate::create<&Entity::move>(1),
+        Delegate::create<&accelerate>(0)};
+    for (const auto& handler : handlers) {
+        handler(arena.data(), 2);
+    }
+    CHECK(arena[0].position == 2);
+    CHECK(arena[0].speed == 3);
+    CHECK(arena[1].position == 0);
+    CHECK(arena[1].speed == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("An empty indexed_delegate behaves according to its Behavior") {
+    std::vector<Entity> arena(1);
+    SUBCASE("target_is_expected") {
+        rome::indexed_delegate<void(int), Entity> dgt;
+        CHECK(!dgt);
+        CHECK(dgt == nullptr);
+        CHECK_THROWS_AS(dgt(arena.data(), 1), rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_optional") {
+        rome::indexed_delegate<void(int), Entity, rome::target_is_optional> dgt =
+            rome::indexed_delegate<void(int), Entity, rome::target_is_optional>::create<
+                &Entity::move>(0);
+        dgt = nullptr;
+        CHECK(nullptr == dgt);
+        CHECK_NOTHROW(dgt(arena.data(), 1));
+        CHECK(arena[0].position == 0);
+    }
+    SUBCASE("target_is_mandatory") {
+        using Delegate = rome::indexed_delegate<void(int), Entity, rome::target_is_mandatory>;
+        STATIC_REQUIRE(!std::is_default_constructible<Delegate>::value);
+        STATIC_REQUIRE(!std::is_assignable<Delegate&, std::nullptr_t>::value);
+    }
+}
@@ -0,0 +1,179 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::intrusive_event` and `rome::intrusive_slot`, which link the slots embedded into
+// their subscribers into a list.
+
+#include <rome/intrusive_event.hpp>
+
+#include <doctest/doctest.h>
+#include <memory>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+
+
+namespace {
+
+using Event = rome::intrusive_event<void(int)>;
+using Slot  = rome::intrusive_slot<void(int)>;
+
+void append(std::string& log, char name, int value) {
+    log += name;
+    log += std::to_string(value);
+    log += ';';
+}
+
+// A subscriber with an embedded slot.
+struct Subscriber {
+    std::string* log;
+    char name;
+    Slot slot{[this](int value) { append(*log, name, value); }};
+
+    Subscriber(std::string* output, char id) : log{output}, name{id} {
+    }
+};
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("intrusive_event and intrusive_slot are neither copyable nor movable") {
+    STATIC_REQUIRE(!std::is_copy_constructible<Event>::value);
+    STATIC_REQUIRE(!std::is_move_constructible<Event>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<Slot>::value);
+    STATIC_REQUIRE(!std::is_move_constructible<Slot>::value);
+    STATIC_REQUIRE(std::is_same<Slot::delegate_type, rome::event_delegate<void(int)>>::value);
+    STATIC_REQUIRE(std::is_same<Event::slot_type, Slot>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("intrusive_event calls the connected slots in the order of connection") {
+    std::string log;
+    Subscriber a{&log, 'a'};
+    Subscriber b{&log, 'b'};
+    Subscriber c{&log, 'c'};
+    Event event;
+    CHECK(event.empty());
+    CHECK(!a.slot.connected());
+    event(0);
+    CHECK(log.empty());
+
+    event.connect(a.slot);
+    event.connect(b.slot);
+    event.connect(c.slot);
+    CHECK(!event.empty());
+    CHECK(b.slot.connected());
+    event(1);
+    CHECK(log == "a1;b1;c1;");
+
+    log.clear();
+    b.slot.disconnect();
+    CHECK(!b.slot.connected());
+    event(2);
+    CHECK(log == "a2;c2;");
+
+    log.clear();
+    event.connect(b.slot);
+    event.connect(a.slot);  // reconnecting moves the slot to the end
+    event(3);
+    CHECK(log == "c3;b3;a3;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("intrusive_slot disconnects itself when destroyed") {
+    std::string log;
+    Subscriber a{&log, 'a'};
+    Event event;
+    event.connect(a.slot);
+    {
+        Subscriber b{&log, 'b'};
+        event.connect(b.slot);
+        event(1);
+    }
+    event(2);
+    CHECK(log == "a1;b1;a2;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("intrusive_event disconnects all slots when destroyed") {
+    std::string log;
+    Subscriber a{&log, 'a'};
+    Subscriber b{&log, 'b'};
+    {
+        Event event;
+        event.connect(a.slot);
+        event.connect(b.slot);
+    }
+    CHECK(!a.slot.connected());
+    CHECK(!b.slot.connected());
+
+    Event event;
+    event.connect(a.slot);
+    event.connect(b.slot);
+    event.disconnect_all();
+    CHECK(event.empty());
+    CHECK(!a.slot.connected());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("intrusive_slot can be connected to one event at a time") {
+    std::string log;
+    Subscriber a{&log, 'a'};
+    Event first;
+    Event second;
+    first.connect(a.slot);
+    second.connect(a.slot);
+    CHECK(first.empty());
+    first(1);
+    second(2);
+    CHECK(log == "a2;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("intrusive_slot may disconnect or destroy itself while being called") {
+    std::string log;
+    Event event;
+    Subscriber a{&log, 'a'};
+    auto b = std::make_unique<Slot>();
+    Slot c{[&log](int value) { append(log, 'x', value); }};
+    b->delegate() = [&log, &b](int value) {
+        append(log, 'b', value);
+        b.reset();
+    };
+    c.delegate() = [&log, &c](int value) {
+        append(log, 'c', value);
+        c.disconnect();
+    };
+    event.connect(a.slot);
+    event.connect(*b);
+    event.connect(c);
+    event(1);
+    event(2);
+    CHECK(log == "a1;b1;c1;a2;");
+    CHECK(b == nullptr);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("intrusive_event does not allocate") {
+    int sum = 0;
+    Event event;
+    Slot a{[&sum](int value) { sum += value; }};
+    Slot empty;
+    const test::AllocationCounter counter;
+    event.connect(a);
+    event.connect(empty);
+    event(3);
+    a.disconnect();
+    event.connect(a);
+    event(4);
+    const auto allocations = counter.allocations();
+    CHECK(allocations == 0);
+    CHECK(sum == 7);
+}
@@ -0,0 +1,157 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::multicast_delegate` and its combiners.
+
+#include <rome/multicast_delegate.hpp>
+
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+// Returns `result` and counts its calls.
+struct Returns {
+    int* calls;
+    bool result;
+    auto operator()(int /*unused*/) const -> bool {
+        ++*calls;
+        return result;
+    }
+};
+
+struct Max {
+    auto operator()(const int lhs, const int rhs) const -> int {
+        return std::max(lhs, rhs);
+    }
+};
+
+auto isPositive(int value) -> bool {
+    return value > 0;
+}
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("multicast_delegate types") {
+    using AllOf = rome::multicast_delegate<bool(int), rome::combiners::all_of>;
+    using Find  = rome::multicast_delegate<const int*(int), rome::combiners::first_non_empty>;
+    using Sum   = rome::multicast_delegate<int(int), rome::combiners::fold<long>>;
+    STATIC_REQUIRE(std::is_same<AllOf::result_type, bool>::value);
+    STATIC_REQUIRE(std::is_same<Find::result_type, const int*>::value);
+    STATIC_REQUIRE(std::is_same<Sum::result_type, long>::value);
+    STATIC_REQUIRE(std::is_same<AllOf::delegate_type, rome::delegate<bool(int)>>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<AllOf>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<AllOf>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("multicast_delegate all_of stops at the first false result") {
+    int calls = 0;
+    rome::multicast_delegate<bool(int), rome::combiners::all_of> validate;
+    CHECK(validate.push_back(Returns{&calls, true}));
+    CHECK(validate.push_back(Returns{&calls, true}));
+    CHECK(validate(0));
+    CHECK(calls == 2);
+
+    CHECK(validate.push_back(Returns{&calls, false}));
+    CHECK(validate.push_back(Returns{&calls, true}));
+    calls = 0;
+    CHECK(!validate(0));
+    CHECK(calls == 3);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("multicast_delegate any_of stops at the first true result") {
+    int calls = 0;
+    rome::multicast_delegate<bool(int), rome::combiners::any_of> anyOf;
+    CHECK(anyOf.push_back(Returns{&calls, false}));
+    CHECK(anyOf.push_back(Returns{&calls, false}));
+    CHECK(!anyOf(0));
+    CHECK(calls == 2);
+
+    CHECK(anyOf.push_back(Returns{&calls, true}));
+    CHECK(anyOf.push_back(Returns{&calls, true}));
+    calls = 0;
+    CHECK(anyOf(0));
+    CHECK(calls == 3);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("multicast_delegate first_non_empty returns the first non-empty result") {
+    static const int values[] = {10, 20};
+    rome::multicast_delegate<const int*(int), rome::combiners::first_non_empty> find;
+    CHECK(find.push_back([](int /*unused*/) -> const int* { return nullptr; }));
+    CHECK(find(0) == nullptr);
+
+    CHECK(find.push_back([](int i) -> const int* { return i == 1 ? &values[0] : nullptr; }));
+    CHECK(find.push_back([](int /*unused*/) -> const int* { return &values[1]; }));
+    CHECK(find(1) == &values[0]);
+    CHECK(find(2) == &values[1]);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("multicast_delegate fold combines all results") {
+    rome::multicast_delegate<int(int), rome::combiners::fold<int>> sum;
+    CHECK(sum.push_back([](int i) { return i; }));
+    CHECK(sum.push_back([](int i) { return 2 * i; }));
+    CHECK(sum.push_back([](int i) { return 3 * i; }));
+    CHECK(sum(2) == 12);
+
+    using MaxCombiner = rome::combiners::fold<int, Max>;
+    rome::multicast_delegate<int(int), MaxCombiner> max{MaxCombiner{-1}};
+    CHECK(max.combiner().initial<int>() == -1);
+    CHECK(max.push_back([](int i) { return i - 5; }));
+    CHECK(max.push_back([](int i) { return 2 * i; }));
+    CHECK(max.push_back([](int i) { return i + 5; }));
+    CHECK(max(1) == 6);
+    CHECK(max(10) == 20);
+    CHECK(max(-10) == -1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("multicast_delegate without targets") {
+    rome::multicast_delegate<bool(int), rome::combiners::all_of> expected;
+    CHECK(expected.empty());
+    CHECK_THROWS_AS(expected(0), rome::bad_delegate_call);
+
+    rome::multicast_delegate<bool(int), rome::combiners::all_of, rome::target_is_optional>
+        allOf;
+    rome::multicast_delegate<bool(int), rome::combiners::any_of, rome::target_is_optional>
+        anyOf;
+    rome::multicast_delegate<int(int), rome::combiners::fold<int>, rome::target_is_optional>
+        sum{rome::combiners::fold<int>{7}};
+    CHECK(allOf(0));
+    CHECK(!anyOf(0));
+    CHECK(sum(0) == 7);
+
+    CHECK(allOf.push_back(rome::delegate<bool(int)>::create<&isPositive>()));
+    CHECK(!allOf(0));
+    allOf.clear();
+    CHECK(allOf(0));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("multicast_delegate does not append empty delegates") {
+    rome::multicast_delegate<bool(int), rome::combiners::all_of> validate;
+    CHECK(!validate.push_back(rome::delegate<bool(int)>{}));
+    CHECK(validate.empty());
+    CHECK(validate.push_back(rome::delegate<bool(int)>::create<&isPositive>()));
+    CHECK(validate.size() == 1);
+    CHECK(validate(1));
+    CHECK(!validate(-1));
+
+    auto moved = std::move(validate);
+    CHECK(moved.size() == 1);
+    CHECK(moved(1));
+}
@@ -0,0 +1,300 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks that the delegates never allocate dynamic memory when being called, moved, swapped or
+// assigned a target that is small object optimized. Targets too big for small object optimization
+// are only expected to allocate when being assigned.
+// The targets are not mocked, as mocking allocates memory itself.
+
+#include <rome/delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <test/allocation_counter.hpp>
+#include <test/delegate_traits.hpp>
+#include <test/doctest_extensions.hpp>
+#include <tuple>
+#include <utility>
+
+
+namespace {
+
+template<typename Ret>
+auto returnValue() -> Ret {
+    return static_cast<Ret>(true);
+}
+
+template<typename Ret>
+auto function(int /*unused*/) -> Ret {
+    return returnValue<Ret>();
+}
+
+template<typename Ret>
+struct TargetClass {
+    auto method(int /*unused*/) -> Ret {
+        return returnValue<Ret>();
+    }
+    auto constMethod(int /*unused*/) const -> Ret {
+        return returnValue<Ret>();
+    }
+};
+
+template<typename Ret>
+TargetClass<Ret> targetObject{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+template<typename Ret>
+struct SmallFunctor {
+    void* dummy = nullptr;
+    auto operator()(int /*unused*/) const -> Ret {
+        return returnValue<Ret>();
+    }
+};
+
+template<typename Ret>
+struct TooBigFunctor {
+    void* dummy0 = nullptr;
+    void* dummy1 = nullptr;
+    auto operator()(int /*unused*/) const -> Ret {
+        return returnValue<Ret>();
+    }
+};
+
+template<typename Ret>
+struct BadAlignedFunctor {
+    alignas(alignof(void*) * 2) bool dummy = {};
+    auto operator()(int /*unused*/) const -> Ret {
+        return returnValue<Ret>();
+    }
+};
+
+
+// Tags for the kind of target assigned.
+struct function_target {};
+struct method_target {};
+struct const_method_target {};
+struct small_functor_target {};
+struct too_big_functor_target {};
+struct bad_aligned_functor_target {};
+
+template<typename Delegate, typename Ret = test::delegate_return_type_t<Delegate>>
+auto createDelegate(function_target /*unused*/) -> Delegate {
+    return Delegate::template create<&function<Ret>>();
+}
+
+template<typename Delegate, typename Ret = test::delegate_return_type_t<Delegate>>
+auto createDelegate(method_target /*unused*/) -> Delegate {
+    return Delegate::template create<TargetClass<Ret>, &TargetClass<Ret>::method>(
+        targetObject<Ret>);
+}
+
+template<typename Delegate, typename Ret = test::delegate_return_type_t<Delegate>>
+auto createDelegate(const_method_target /*unused*/) -> Delegate {
+    return Delegate::template create<TargetClass<Ret>, &TargetClass<Ret>::constMethod>(
+        targetObject<Ret>);
+}
+
+template<typename Delegate, typename Ret = test::delegate_return_type_t<Delegate>>
+auto createDelegate(small_functor_target /*unused*/) -> Delegate {
+    return Delegate{SmallFunctor<Ret>{}};
+}
+
+template<typename Delegate, typename Ret = test::delegate_return_type_t<Delegate>>
+auto createDelegate(too_big_functor_target /*unused*/) -> Delegate {
+    return Delegate{TooBigFunctor<Ret>{}};
+}
+
+template<typename Delegate, typename Ret = test::delegate_return_type_t<Delegate>>
+auto createDelegate(bad_aligned_functor_target /*unused*/) -> Delegate {
+    return Delegate{BadAlignedFunctor<Ret>{}};
+}
+
+
+template<typename Delegate, typename TargetType>
+struct input_params {
+    using delegate    = Delegate;
+    using target_type = TargetType;
+};
+
+}  // namespace
+
+
+// clang-format off
+using test_vector_small_targets = std::tuple<
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  function_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, function_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  function_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  method_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, method_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  method_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  const_method_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, const_method_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  const_method_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  small_functor_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, small_functor_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  small_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  function_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, function_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  function_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  const_method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, const_method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  const_method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  small_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, small_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  small_functor_target >
+>;
+// clang-format on
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters,misc-use-anonymous-namespace,readability-function-cognitive-complexity)
+TEST_CASE_TEMPLATE_DEFINE("Assigning a small object optimizable target does not allocate. ",
+    InputParams, assign_small_target_without_allocation) {
+    using Delegate   = typename InputParams::delegate;
+    using TargetType = typename InputParams::target_type;
+
+    SUBCASE("Create") {
+        const test::AllocationCounter counter;
+        {
+            const Delegate dgt = createDelegate<Delegate>(TargetType{});
+            (void)dgt;
+        }
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+    }
+    SUBCASE("Assign to a delegate with a small target") {
+        Delegate dgt = createDelegate<Delegate>(TargetType{});
+        const test::AllocationCounter counter;
+        dgt                      = createDelegate<Delegate>(TargetType{});
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+    }
+}
+TEST_CASE_TEMPLATE_APPLY(assign_small_target_without_allocation, test_vector_small_targets);
+
+
+// clang-format off
+using test_vector_all_targets = std::tuple<
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  function_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, method_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  const_method_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  small_functor_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, small_functor_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  small_functor_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  too_big_functor_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, too_big_functor_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  too_big_functor_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_expected>,  bad_aligned_functor_target >,
+    input_params<     rome::delegate<bool(int), rome::target_is_mandatory>, bad_aligned_functor_target >,
+    input_params<     rome::delegate<void(int), rome::target_is_optional>,  bad_aligned_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  function_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  const_method_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  small_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, small_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  small_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  too_big_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, too_big_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  too_big_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_expected>,  bad_aligned_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_mandatory>, bad_aligned_functor_target >,
+    input_params< rome::fwd_delegate<void(int), rome::target_is_optional>,  bad_aligned_functor_target >
+>;
+// clang-format on
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters,misc-use-anonymous-namespace,readability-function-cognitive-complexity)
+TEST_CASE_TEMPLATE_DEFINE("Calling, moving and swapping a delegate does not allocate. ",
+    InputParams, use_without_allocation) {
+    using Delegate   = typename InputParams::delegate;
+    using TargetType = typename InputParams::target_type;
+
+    Delegate dgt0 = createDelegate<Delegate>(TargetType{});
+    Delegate dgt1 = createDelegate<Delegate>(TargetType{});
+
+    SUBCASE("Call") {
+        const test::AllocationCounter counter;
+        dgt0(42);
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+    }
+    SUBCASE("Move-construct") {
+        const test::AllocationCounter counter;
+        const Delegate to        = std::move(dgt0);
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+        (void)to;
+    }
+    SUBCASE("Move-assign") {
+        const test::AllocationCounter counter;
+        dgt1                   = std::move(dgt0);
+        const auto allocations = counter.allocations();
+        CHECK(allocations == 0);  // the previous target of dgt1 might be deallocated
+    }
+    SUBCASE("Swap") {
+        const test::AllocationCounter counter;
+        dgt0.swap(dgt1);
+        {
+            using std::swap;
+            swap(dgt0, dgt1);
+        }
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+    }
+}
+TEST_CASE_TEMPLATE_APPLY(use_without_allocation, test_vector_all_targets);
+
+
+// clang-format off
+using test_vector_empty = std::tuple<
+        rome::delegate<void(int), rome::target_is_optional>,
+    rome::fwd_delegate<void(int), rome::target_is_optional>
+>;
+// Note: Calling an empty delegate with any other behavior throws an exception, which is not
+// allocated by `operator new`.
+// clang-format on
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters,misc-use-anonymous-namespace)
+TEST_CASE_TEMPLATE_DEFINE(
+    "Creating, calling and dropping an empty delegate does not allocate. ", Delegate, use_empty) {
+    const test::AllocationCounter counter;
+    {
+        Delegate dgt{};
+        dgt(42);
+        dgt = nullptr;
+        dgt(42);
+    }
+    const auto allocations   = counter.allocations();
+    const auto deallocations = counter.deallocations();
+    CHECK(allocations == 0);
+    CHECK(deallocations == 0);
+}
+TEST_CASE_TEMPLATE_APPLY(use_empty, test_vector_empty);
+
+
+// Ensures that the allocation counter is able to detect allocations at all.
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Assigning a target too big for small object optimization allocates exactly once.") {
+    const test::AllocationCounter counter;
+    {
+        const rome::delegate<void(int)> dgt = TooBigFunctor<void>{};
+        (void)dgt;
+    }
+    const auto allocations   = counter.allocations();
+    const auto deallocations = counter.deallocations();
+    CHECK(allocations == 1);
+    CHECK(deallocations == 1);
+}
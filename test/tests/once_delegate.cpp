@@ -0,0 +1,227 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::once_delegate`, which consumes its target when called.
+
+#include <rome/once_delegate.hpp>
+
+#include <array>
+#include <doctest/doctest.h>
+#include <exception>
+#include <memory>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+template<typename T, typename = void>
+struct is_lvalue_callable : std::false_type {};
+
+template<typename T>
+struct is_lvalue_callable<T, decltype(std::declval<T&>()(), void())> : std::true_type {};
+
+// Counts its destructions, is small enough to be stored inside the once delegate.
+struct Counted {
+    int* destructions;
+
+    explicit Counted(int* d) : destructions{d} {
+    }
+    Counted(const Counted&) = delete;
+    Counted(Counted&& orig) noexcept : destructions{orig.destructions} {
+        orig.destructions = nullptr;
+    }
+    ~Counted() {
+        if (destructions != nullptr) {
+            ++*destructions;
+        }
+    }
+
+    auto operator=(const Counted&) -> Counted& = delete;
+    auto operator=(Counted&&) -> Counted&      = delete;
+
+    auto operator()(int value) && -> int {
+        return 2 * value;
+    }
+};
+
+// Counts its destructions, is dynamically allocated by the once delegate.
+struct LargeCounted : Counted {
+    std::array<char, 32> padding = {};
+
+    using Counted::Counted;
+};
+
+auto twice(int value) -> int {
+    return 2 * value;
+}
+
+struct Buffer {
+    int offset = 0;
+    auto add(int value) -> int {
+        return offset + value;
+    }
+    auto sub(int value) const -> int {
+        return offset - value;
+    }
+};
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate types") {
+    using Once = rome::once_delegate<int()>;
+    STATIC_REQUIRE(sizeof(Once) == sizeof(rome::delegate<int()>));
+    STATIC_REQUIRE(rome::detail::delegate::is_small_object_optimizable<Counted>);
+    STATIC_REQUIRE(!rome::detail::delegate::is_small_object_optimizable<LargeCounted>);
+    STATIC_REQUIRE(!std::is_copy_constructible<Once>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<Once>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_assignable<Once>::value);
+    STATIC_REQUIRE(std::is_nothrow_default_constructible<Once>::value);
+    STATIC_REQUIRE(!is_lvalue_callable<Once>::value);
+    STATIC_REQUIRE(std::is_same<decltype(std::declval<Once>()()), int>::value);
+    using Mandatory = rome::once_delegate<int(), rome::target_is_mandatory>;
+    STATIC_REQUIRE(!std::is_default_constructible<Mandatory>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate is empty after the call") {
+    int calls = 0;
+    rome::once_delegate<void(int)> once = [&calls](int value) { calls += value; };
+    CHECK(once != nullptr);
+    std::move(once)(3);
+    CHECK(calls == 3);
+    CHECK(once == nullptr);
+    CHECK_THROWS_AS(std::move(once)(3), rome::bad_delegate_call);
+
+    rome::once_delegate<void(int), rome::target_is_optional> optional = [&calls](int value) {
+        calls += value;
+    };
+    std::move(optional)(4);
+    std::move(optional)(4);
+    CHECK(calls == 7);
+    CHECK(!optional);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate moves the captured state out") {
+    std::vector<int> buffer = {1, 2, 3};
+    const auto* const data  = buffer.data();
+    rome::once_delegate<std::vector<int>()> handBack = [buffer = std::move(buffer)]() mutable {
+        return std::move(buffer);
+    };
+    const auto returned = std::move(handBack)();
+    CHECK(returned == std::vector<int>{1, 2, 3});
+    CHECK(returned.data() == data);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate stores move-only function objects") {
+    auto value = std::make_unique<int>(5);
+    rome::once_delegate<std::unique_ptr<int>(int)> once =
+        [value = std::move(value)](int add) mutable {
+            *value += add;
+            return std::move(value);
+        };
+    const auto result = std::move(once)(2);
+    REQUIRE(result != nullptr);
+    CHECK(*result == 7);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate destroys the target exactly once") {
+    int destructions = 0;
+    SUBCASE("stored locally") {
+        rome::once_delegate<int(int)> once = Counted{&destructions};
+        CHECK(destructions == 0);
+        CHECK(std::move(once)(4) == 8);
+        CHECK(destructions == 1);
+    }
+    SUBCASE("allocated") {
+        rome::once_delegate<int(int)> once = LargeCounted{&destructions};
+        const test::AllocationCounter counter;
+        CHECK(std::move(once)(4) == 8);
+        CHECK(counter.deallocations() == 1);
+        CHECK(destructions == 1);
+    }
+    SUBCASE("not called") {
+        {
+            const rome::once_delegate<int(int)> small = Counted{&destructions};
+            const rome::once_delegate<int(int)> large = LargeCounted{&destructions};
+        }
+        CHECK(destructions == 2);
+    }
+    SUBCASE("dropped") {
+        rome::once_delegate<int(int)> once = LargeCounted{&destructions};
+        once                               = nullptr;
+        CHECK(destructions == 1);
+        CHECK_THROWS_AS(std::move(once)(4), rome::bad_delegate_call);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate destroys the target if it throws") {
+    int destructions = 0;
+    Counted counted{&destructions};
+    rome::once_delegate<void()> once = [counted = std::move(counted)]() {
+        throw std::exception{};
+    };
+    CHECK_THROWS_AS(std::move(once)(), std::exception);
+    CHECK(destructions == 1);
+    CHECK(!once);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate can be reassigned while called") {
+    rome::once_delegate<int(int)> once;
+    once = [&once](int value) {
+        once = [](int other) { return 10 * other; };
+        return value;
+    };
+    CHECK(std::move(once)(1) == 1);
+    CHECK(std::move(once)(2) == 20);
+    CHECK(!once);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate targets functions and member functions") {
+    auto function = rome::once_delegate<int(int)>::create<&twice>();
+    CHECK(std::move(function)(3) == 6);
+
+    Buffer buffer{10};
+    auto member = rome::once_delegate<int(int)>::create<Buffer, &Buffer::add>(buffer);
+    CHECK(std::move(member)(3) == 13);
+    const auto& constBuffer = buffer;
+    auto constMember = rome::once_delegate<int(int)>::create<Buffer, &Buffer::sub>(constBuffer);
+    CHECK(std::move(constMember)(3) == 7);
+
+    rome::once_delegate<int(int), rome::target_is_mandatory> mandatory{[](int value) {
+        return value + 1;
+    }};
+    CHECK(std::move(mandatory)(1) == 2);
+    CHECK_THROWS_AS(std::move(mandatory)(1), rome::bad_delegate_call);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("once_delegate target and in place construction") {
+    int destructions = 0;
+    rome::once_delegate<int(int)> once{rome::in_place_type<Counted>, &destructions};
+    REQUIRE(once.target<Counted>() != nullptr);
+    CHECK(once.target<LargeCounted>() == nullptr);
+    CHECK(once.target<Counted>()->destructions == &destructions);
+
+    rome::once_delegate<int(int)> other;
+    other.swap(once);
+    CHECK(!once);
+    CHECK(std::move(other)(1) == 2);
+    CHECK(destructions == 1);
+}
@@ -0,0 +1,204 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::overload_delegate`, which calls one function object through several signatures.
+
+#include <rome/overload_delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct Ping {
+    int id;
+};
+
+struct Data {
+    std::string payload;
+};
+
+struct Close {};
+
+struct Handler {
+    std::string* log;
+    void operator()(const Ping& ping) const {
+        *log += "ping " + std::to_string(ping.id) + ";";
+    }
+    void operator()(const Data& data) const {
+        *log += "data " + data.payload + ";";
+    }
+    void operator()(const Close& /*unused*/) const {
+        *log += "close;";
+    }
+};
+
+struct BigHandler : Handler {
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    explicit BigHandler(std::string* output) : Handler{output} {
+    }
+};
+
+struct Counter {
+    int pings = 0;
+    void operator()(const Ping& /*unused*/) {
+        ++pings;
+    }
+    void operator()(const Data& /*unused*/) {
+    }
+    void operator()(const Close& /*unused*/) {
+    }
+};
+
+struct Calculator {
+    auto operator()(int value) const -> int {
+        return value * 2;
+    }
+    auto operator()(const std::string& value) const -> std::string {
+        return value + value;
+    }
+};
+
+struct Destructible {
+    int* destructions;
+    explicit Destructible(int* counter) noexcept : destructions{counter} {
+    }
+    Destructible(Destructible&& other) noexcept : destructions{other.destructions} {
+        other.destructions = nullptr;
+    }
+    Destructible(const Destructible&)                    = delete;
+    auto operator=(const Destructible&) -> Destructible& = delete;
+    auto operator=(Destructible&&) -> Destructible&      = delete;
+    ~Destructible() {
+        if (destructions != nullptr) {
+            ++*destructions;
+        }
+    }
+    void operator()(const Ping& /*unused*/) const {
+    }
+    void operator()(const Data& /*unused*/) const {
+    }
+    void operator()(const Close& /*unused*/) const {
+    }
+};
+
+using ProtocolHandler =
+    rome::overload_delegate<void(const Ping&), void(const Data&), void(const Close&)>;
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("overload_delegate has the size of two pointers for any number of signatures") {
+    STATIC_REQUIRE(sizeof(ProtocolHandler) == 2 * sizeof(void*));
+    STATIC_REQUIRE(std::is_same<ProtocolHandler,
+        rome::basic_overload_delegate<rome::target_is_expected, void(const Ping&),
+            void(const Data&), void(const Close&)>>::value);
+    STATIC_REQUIRE(std::is_constructible<ProtocolHandler, Handler>::value);
+    STATIC_REQUIRE(!std::is_constructible<ProtocolHandler, int>::value);
+    STATIC_REQUIRE(!std::is_constructible<ProtocolHandler, Calculator>::value);
+    STATIC_REQUIRE(!std::is_assignable<ProtocolHandler&, Calculator>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<ProtocolHandler>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<ProtocolHandler>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("overload_delegate selects the signature by overload resolution") {
+    std::string log;
+    SUBCASE("Small function object") {
+        const test::AllocationCounter counter;
+        const ProtocolHandler handler = Handler{&log};
+        const auto allocations        = counter.allocations();
+        CHECK(allocations == 0);
+        handler(Ping{1});
+        handler(Data{"abc"});
+        handler(Close{});
+    }
+    SUBCASE("Big function object") {
+        const ProtocolHandler handler = BigHandler{&log};
+        handler(Ping{1});
+        handler(Data{"abc"});
+        handler(Close{});
+    }
+    CHECK(log == "ping 1;data abc;close;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("overload_delegate shares one target between all signatures") {
+    ProtocolHandler handler{rome::in_place_type<Counter>};
+    handler(Ping{1});
+    handler(Data{});
+    handler(Ping{2});
+    REQUIRE(handler.target<Counter>() != nullptr);
+    CHECK(handler.target<Counter>()->pings == 2);
+    CHECK(handler.target<Handler>() == nullptr);
+
+    std::string log;
+    auto& replaced = handler.emplace<Handler>(Handler{&log});
+    CHECK(&replaced == handler.target<Handler>());
+    handler(Close{});
+    CHECK(log == "close;");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("overload_delegate with different return types") {
+    const rome::overload_delegate<int(int), std::string(const std::string&)> dgt = Calculator{};
+    CHECK(dgt(21) == 42);
+    CHECK(dgt(std::string{"ab"}) == "abab");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("overload_delegate destroys its target") {
+    int destructions = 0;
+    {
+        ProtocolHandler handler{rome::in_place_type<Destructible>, &destructions};
+        auto moved = std::move(handler);
+        CHECK(!handler);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+        CHECK(destructions == 0);
+        moved = nullptr;
+        CHECK(destructions == 1);
+        moved = Destructible{&destructions};
+    }
+    CHECK(destructions == 2);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("An empty overload_delegate behaves according to its Behavior") {
+    SUBCASE("target_is_expected") {
+        const ProtocolHandler handler;
+        CHECK(!handler);
+        CHECK(handler == nullptr);
+        CHECK_THROWS_AS(handler(Ping{1}), rome::bad_delegate_call);
+        CHECK_THROWS_AS(handler(Close{}), rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_optional") {
+        const rome::overload_delegate<rome::target_is_optional, void(const Ping&),
+            void(const Close&)>
+            handler = nullptr;
+        CHECK(nullptr == handler);
+        CHECK_NOTHROW(handler(Ping{1}));
+        CHECK_NOTHROW(handler(Close{}));
+    }
+    SUBCASE("target_is_mandatory") {
+        using Mandatory = rome::overload_delegate<rome::target_is_mandatory, void(const Ping&),
+            void(const Close&)>;
+        STATIC_REQUIRE(!std::is_default_constructible<Mandatory>::value);
+        STATIC_REQUIRE(!std::is_assignable<Mandatory&, std::nullptr_t>::value);
+        STATIC_REQUIRE(!std::is_constructible<Mandatory, Calculator>::value);
+        std::string log;
+        Mandatory handler = Handler{&log};
+        handler(Ping{3});
+        CHECK(log == "ping 3;");
+        CHECK(handler != nullptr);
+    }
+}
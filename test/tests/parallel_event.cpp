@@ -0,0 +1,278 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::parallel_event`, which calls its event delegates concurrently.
+
+#include <rome/parallel_event.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <doctest/doctest.h>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+using Event = rome::parallel_event<void(const std::string&)>;
+
+// Runs each task immediately in the posting thread.
+struct InlineExecutor {
+    int posts = 0;
+
+    void post(Event::task_type&& task) {
+        ++posts;
+        task();
+    }
+
+    auto poster() -> Event::executor_type {
+        return Event::executor_type::create<InlineExecutor, &InlineExecutor::post>(*this);
+    }
+};
+
+// Keeps the tasks until they are run explicitly, like an executor whose threads are all busy.
+struct DeferredExecutor {
+    std::vector<Event::task_type> tasks;
+
+    void post(Event::task_type&& task) {
+        tasks.push_back(std::move(task));
+    }
+
+    void run_all() {
+        for (auto& task : tasks) {
+            task();
+        }
+        tasks.clear();
+    }
+
+    auto poster() -> Event::executor_type {
+        return Event::executor_type::create<DeferredExecutor, &DeferredExecutor::post>(*this);
+    }
+};
+
+// Runs the tasks in a fixed number of worker threads.
+class ThreadPool {
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<Event::task_type> tasks_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+
+    void work() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            wakeup_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+  public:
+    explicit ThreadPool(const std::size_t threadCount) {
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this]() { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&)      = delete;
+
+    auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+    auto operator=(ThreadPool&&) -> ThreadPool&      = delete;
+
+    ~ThreadPool() {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wakeup_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void post(Event::task_type&& task) {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.push_back(std::move(task));
+        }
+        wakeup_.notify_one();
+    }
+
+    auto poster() -> Event::executor_type {
+        return Event::executor_type::create<ThreadPool, &ThreadPool::post>(*this);
+    }
+};
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event types") {
+    STATIC_REQUIRE(
+        std::is_same<Event::delegate_type, rome::event_delegate<void(const std::string&)>>::value);
+    STATIC_REQUIRE(std::is_same<Event::task_type, rome::command_delegate<void()>>::value);
+    STATIC_REQUIRE(std::is_same<Event::executor_type,
+        rome::command_delegate<void(rome::command_delegate<void()>&&)>>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<Event>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<Event>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event calls all event delegates") {
+    InlineExecutor executor;
+    Event event{executor.poster(), 4};
+    CHECK(event.concurrency() == 4);
+    CHECK(event.empty());
+    event("nothing");
+    CHECK(executor.posts == 0);
+
+    std::vector<std::string> received(3);
+    CHECK(event.push_back([&received](const std::string& text) { received[0] = text + "0"; }));
+    CHECK(event.push_back([&received](const std::string& text) { received[1] = text + "1"; }));
+    CHECK(!event.push_back(Event::delegate_type{}));
+    CHECK(event.push_back([&received](const std::string& text) { received[2] = text + "2"; }));
+    CHECK(event.size() == 3);
+
+    // three chunks of one event delegate, two tasks help the calling thread
+    event("call");
+    CHECK(executor.posts == 2);
+    CHECK(received == std::vector<std::string>{"call0", "call1", "call2"});
+
+    event.clear();
+    CHECK(event.empty());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event with concurrency 1 calls in the calling thread only") {
+    InlineExecutor executor;
+    Event event{executor.poster(), 0};
+    CHECK(event.concurrency() == 1);
+    int calls = 0;
+    for (int i = 0; i < 10; ++i) {
+        CHECK(event.push_back([&calls](const std::string& /*unused*/) { ++calls; }));
+    }
+    event("serial");
+    CHECK(calls == 10);
+    CHECK(executor.posts == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event rethrows the first exception") {
+    InlineExecutor executor;
+    Event event{executor.poster(), 2};
+    int calls = 0;
+    CHECK(event.push_back([&calls](const std::string& /*unused*/) { ++calls; }));
+    CHECK(event.push_back([](const std::string& /*unused*/) { throw std::exception{}; }));
+    CHECK_THROWS_AS(event("fail"), std::exception);
+    CHECK(calls == 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event does not allocate when called") {
+    InlineExecutor executor;
+    Event event{executor.poster(), 8};
+    std::size_t length = 0;
+    for (int i = 0; i < 100; ++i) {
+        CHECK(event.push_back([&length](const std::string& text) { length += text.size(); }));
+    }
+    const std::string text = "a text too long for the small string optimization";
+    event(text);  // allocates the state shared with the tasks, which is reused afterwards
+    const test::AllocationCounter counter;
+    event(text);
+    const auto allocations = counter.allocations();
+    CHECK(allocations == 0);
+    CHECK(length == 2 * 100 * text.size());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event does not wait for tasks not yet started") {
+    DeferredExecutor executor;
+    int calls = 0;
+    {
+        Event event{executor.poster(), 4};
+        for (int i = 0; i < 8; ++i) {
+            CHECK(event.push_back([&calls](const std::string& /*unused*/) { ++calls; }));
+        }
+        event("first");
+        CHECK(executor.tasks.size() == 3);
+        CHECK(calls == 8);
+
+        // the state of the first call is still referenced by its tasks
+        event("second");
+        CHECK(executor.tasks.size() == 6);
+        CHECK(calls == 16);
+        executor.run_all();
+        CHECK(calls == 16);
+
+        Event moved{std::move(event)};
+        CHECK(moved.size() == 8);
+        moved("third");
+        CHECK(calls == 24);
+    }
+    // tasks starting after the event is destroyed do nothing either
+    CHECK(executor.tasks.size() == 3);
+    executor.run_all();
+    CHECK(calls == 24);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event called by the only thread of its executor") {
+    ThreadPool pool{1};
+    Event event{pool.poster(), 2};
+    std::atomic<int> calls{0};
+    for (int i = 0; i < 4; ++i) {
+        CHECK(event.push_back([&calls](const std::string& /*unused*/) { ++calls; }));
+    }
+    std::atomic<bool> done{false};
+    auto callEvent = [&event, &done]() {
+        event("nested");
+        done = true;
+    };
+    pool.post(Event::task_type{callEvent});
+    while (!done) {
+        std::this_thread::yield();
+    }
+    CHECK(calls == 4);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("parallel_event calls in a thread pool") {
+    constexpr std::size_t delegateCount = 200;
+    ThreadPool pool{3};
+    Event event{pool.poster(), 4};
+    std::vector<int> calls(delegateCount, 0);
+    std::atomic<std::size_t> length{0U};
+    for (std::size_t i = 0; i < delegateCount; ++i) {
+        CHECK(event.push_back([&calls, &length, i](const std::string& text) {
+            ++calls[i];
+            length.fetch_add(text.size());
+        }));
+    }
+    for (int round = 0; round < 100; ++round) {
+        event("text");
+    }
+    CHECK(length.load() == 100 * delegateCount * 4);
+    CHECK(std::all_of(calls.begin(), calls.end(), [](int count) { return count == 100; }));
+}
@@ -0,0 +1,182 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::priority_event`, which calls its event delegates ordered by priority.
+
+#include <rome/priority_event.hpp>
+
+#include <doctest/doctest.h>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+using Event = rome::priority_event<void(int)>;
+
+std::string calls;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,cert-err58-cpp)
+
+// Appends its name to `calls`.
+struct Append {
+    const char* name;
+    void operator()(int /*unused*/) const {
+        calls += name;
+    }
+};
+
+auto emit(const Event& event) -> std::string {
+    calls.clear();
+    event(0);
+    return calls;
+}
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("priority_event types") {
+    STATIC_REQUIRE(std::is_same<Event::delegate_type, rome::event_delegate<void(int)>>::value);
+    STATIC_REQUIRE(std::is_trivially_copyable<Event::connection>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<Event>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<Event>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("priority_event calls by descending priority, then in connection order") {
+    Event event;
+    CHECK(event.empty());
+    CHECK(emit(event).empty());
+
+    const auto b = event.connect(Append{"b"});
+    const auto a = event.connect(Append{"a"}, 10);
+    (void)event.connect(Append{"c"});
+    (void)event.connect(Append{"z"}, -5);
+    (void)event.connect(Append{"A"}, 10);
+    CHECK(event.size() == 5);
+    CHECK(event.priority(a) == 10);
+    CHECK(event.priority(b) == 0);
+    CHECK(a != b);
+    CHECK(emit(event) == "aAbcz");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("priority_event disconnect") {
+    Event event;
+    const auto a = event.connect(Append{"a"}, 1);
+    const auto b = event.connect(Append{"b"});
+    const auto c = event.connect(Append{"c"});
+    CHECK(event.contains(b));
+    CHECK(event.disconnect(b));
+    CHECK(!event.contains(b));
+    CHECK(!event.disconnect(b));
+    CHECK(!event.disconnect(Event::connection{}));
+    CHECK(event.priority(b) == 0);
+    CHECK(emit(event) == "ac");
+
+    // a new connection with the same priority is not confused with the disconnected one
+    const auto d = event.connect(Append{"d"});
+    CHECK(!event.contains(b));
+    CHECK(event.contains(d));
+    CHECK(emit(event) == "acd");
+
+    CHECK(event.disconnect(a));
+    CHECK(event.disconnect(c));
+    CHECK(event.disconnect(d));
+    CHECK(event.empty());
+
+    (void)event.connect(Append{"e"});
+    event.clear();
+    CHECK(event.empty());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("priority_event set_priority") {
+    Event event;
+    auto a = event.connect(Append{"a"});
+    auto b = event.connect(Append{"b"});
+    auto c = event.connect(Append{"c"});
+    auto d = event.connect(Append{"d"});
+    CHECK(emit(event) == "abcd");
+
+    const auto copyOfC = c;
+    CHECK(event.set_priority(c, 5));
+    CHECK(event.priority(c) == 5);
+    CHECK(copyOfC == c);
+    CHECK(event.contains(c));
+    CHECK(emit(event) == "cabd");
+
+    CHECK(event.set_priority(a, -1));
+    CHECK(emit(event) == "cbda");
+
+    // keeps the connection order within the new priority
+    CHECK(event.set_priority(a, 0));
+    CHECK(emit(event) == "cabd");
+    CHECK(event.set_priority(d, 5));
+    CHECK(emit(event) == "cdab");
+    CHECK(event.set_priority(c, 0));
+    CHECK(emit(event) == "dabc");
+
+    // unchanged position
+    CHECK(event.set_priority(b, 0));
+    CHECK(emit(event) == "dabc");
+
+    CHECK(event.disconnect(b));
+    CHECK(!event.set_priority(b, 3));
+    CHECK(event.size() == 3);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("priority_event connections copied before set_priority stay valid") {
+    Event event;
+    const auto a    = event.connect(Append{"a"}, 1);
+    const auto copy = a;
+    CHECK(event.set_priority(a, 5));
+    CHECK(event.contains(copy));
+    CHECK(event.priority(copy) == 5);
+    CHECK(event.set_priority(copy, 2));
+    CHECK(event.priority(a) == 2);
+    CHECK(event.disconnect(copy));
+    CHECK(!event.contains(a));
+    CHECK(event.empty());
+    CHECK(emit(event).empty());
+
+    // the reused slot is not confused with the disconnected event delegate
+    const auto b = event.connect(Append{"b"}, 1);
+    CHECK(!event.contains(copy));
+    CHECK(!event.disconnect(a));
+    CHECK(event.contains(b));
+    CHECK(emit(event) == "b");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("priority_event move") {
+    Event event;
+    const auto a = event.connect(Append{"a"});
+    Event moved{std::move(event)};
+    CHECK(moved.contains(a));
+    CHECK(emit(moved) == "a");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("priority_event does not allocate after reserve") {
+    Event event;
+    event.reserve(8);
+    calls.clear();
+    calls.reserve(16);
+    test::AllocationCounter counter;
+    for (int i = 0; i < 8; ++i) {
+        auto conn = event.connect(Append{"x"}, i % 3);
+        CHECK(event.set_priority(conn, -i));
+    }
+    event(0);
+    CHECK(calls == "xxxxxxxx");
+    CHECK(counter.allocations() == 0);
+}
@@ -0,0 +1,227 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `rome::throttled` and `rome::debounced` driven by a manual clock.
+
+#include <rome/rate_limit.hpp>
+
+#include <chrono>
+#include <doctest/doctest.h>
+#include <memory>
+#include <string>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+// A clock that is advanced by the test. Counts how often it is read.
+struct ManualClock {
+    using rep        = long long;
+    using period     = std::milli;
+    using duration   = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<ManualClock>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point current;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    static int reads;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    static auto now() noexcept -> time_point {
+        ++reads;
+        return current;
+    }
+
+    static void reset() noexcept {
+        current = time_point{};
+        reads   = 0;
+    }
+
+    static void advance(const long long ms) noexcept {
+        current += duration{ms};
+    }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+ManualClock::time_point ManualClock::current{};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+int ManualClock::reads = 0;
+
+using namespace std::chrono_literals;
+
+using Throttled = rome::throttled<rome::event_delegate<void(int)>, ManualClock>;
+using Debounced = rome::debounced<rome::event_delegate<void(int)>, ManualClock>;
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rate_limit types") {
+    STATIC_REQUIRE(std::is_same<Throttled::delegate_type, rome::event_delegate<void(int)>>::value);
+    STATIC_REQUIRE(std::is_same<Throttled::duration, ManualClock::duration>::value);
+    STATIC_REQUIRE(std::is_same<Debounced::time_point, ManualClock::time_point>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<Throttled>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<Debounced>::value);
+    STATIC_REQUIRE(std::is_same<rome::throttled<rome::command_delegate<void()>>::clock,
+        std::chrono::steady_clock>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("throttled forwards at most one call per interval") {
+    ManualClock::reset();
+    int sum = 0;
+    Throttled throttled{10ms, [&sum](int value) { sum += value; }};
+    CHECK(throttled.interval() == 10ms);
+
+    CHECK(throttled(1));
+    CHECK(!throttled(2));
+    ManualClock::advance(9);
+    CHECK(!throttled(4));
+    ManualClock::advance(1);
+    CHECK(throttled(8));
+    CHECK(!throttled(16));
+    CHECK(sum == 9);
+    CHECK(ManualClock::reads == 5);  // once per call
+
+    throttled.reset();
+    CHECK(throttled(32));
+    CHECK(sum == 41);
+
+    // the interval starts with the forwarded call, not with the dropped ones
+    ManualClock::advance(25);
+    CHECK(throttled(64));
+    ManualClock::advance(5);
+    CHECK(!throttled(128));
+    ManualClock::advance(5);
+    CHECK(throttled(256));
+    CHECK(sum == 361);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("throttled keeps the behavior of the fwd_delegate") {
+    ManualClock::reset();
+    rome::throttled<rome::fwd_delegate<void(int)>, ManualClock> expected{1ms};
+    CHECK_THROWS_AS(expected(1), rome::bad_delegate_call);
+    // the failed call does not start the interval
+    int forwarded       = 0;
+    expected.delegate() = [&forwarded](int /*unused*/) { ++forwarded; };
+    CHECK(expected(1));
+    CHECK(forwarded == 1);
+
+    Throttled optional{1ms};
+    CHECK(optional(1));
+    int calls           = 0;
+    optional.delegate() = [&calls](int /*unused*/) { ++calls; };
+    CHECK(!optional(1));
+    ManualClock::advance(1);
+    CHECK(optional(1));
+    CHECK(calls == 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("debounced forwards the newest arguments after the quiet time") {
+    ManualClock::reset();
+    int last  = 0;
+    int calls = 0;
+    Debounced debounced{10ms, [&last, &calls](int value) {
+                            last = value;
+                            ++calls;
+                        }};
+    CHECK(debounced.quiet_time() == 10ms);
+    CHECK(!debounced.poll());
+    CHECK(ManualClock::reads == 0);
+
+    debounced(1);
+    ManualClock::advance(5);
+    debounced(2);
+    ManualClock::advance(5);
+    debounced(3);
+    CHECK(ManualClock::reads == 3);
+    CHECK(debounced.pending());
+    ManualClock::advance(9);
+    CHECK(!debounced.poll());
+    ManualClock::advance(1);
+    CHECK(debounced.poll());
+    CHECK(ManualClock::reads == 5);
+    CHECK(last == 3);
+    CHECK(calls == 1);
+    CHECK(!debounced.pending());
+    CHECK(!debounced.poll());
+
+    debounced(4);
+    CHECK(debounced.flush());
+    CHECK(last == 4);
+    CHECK(!debounced.flush());
+
+    debounced(5);
+    debounced.cancel();
+    ManualClock::advance(100);
+    CHECK(!debounced.poll());
+    CHECK(calls == 2);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("debounced stores copies and moves rvalue arguments") {
+    ManualClock::reset();
+    std::string text;
+    rome::debounced<rome::event_delegate<void(const std::string&)>, ManualClock> copies{
+        1ms, [&text](const std::string& value) { text = value; }};
+    {
+        const std::string temporary = "a text too long for the small string optimization";
+        copies(temporary);
+    }
+    CHECK(copies.flush());
+    CHECK(text == "a text too long for the small string optimization");
+
+    std::unique_ptr<int> received;
+    rome::debounced<rome::event_delegate<void(std::unique_ptr<int>&&)>, ManualClock> moves{
+        1ms, [&received](std::unique_ptr<int>&& value) { received = std::move(value); }};
+    moves(std::make_unique<int>(7));
+    CHECK(moves.flush());
+    REQUIRE(received != nullptr);
+    CHECK(*received == 7);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("debounced releases the stored arguments once forwarded or cancelled") {
+    ManualClock::reset();
+    long useCountInCall = 0;
+    rome::debounced<rome::event_delegate<void(const std::shared_ptr<int>&)>, ManualClock> debounced{
+        1ms, [&useCountInCall](const std::shared_ptr<int>& p) { useCountInCall = p.use_count(); }};
+    STATIC_REQUIRE(noexcept(debounced.cancel()));
+    const auto shared = std::make_shared<int>(3);
+    debounced(shared);
+    CHECK(shared.use_count() == 2);
+    CHECK(debounced.flush());
+    CHECK(useCountInCall == 2);
+    CHECK(shared.use_count() == 1);
+
+    debounced(shared);
+    CHECK(shared.use_count() == 2);
+    debounced.cancel();
+    CHECK(shared.use_count() == 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rate_limit does not allocate") {
+    ManualClock::reset();
+    int sum = 0;
+    const test::AllocationCounter counter;
+    Throttled throttled{1ms, [&sum](int value) { sum += value; }};
+    Debounced debounced{1ms, [&sum](int value) { sum += value; }};
+    for (int i = 0; i < 10; ++i) {
+        (void)throttled(i);
+        debounced(i);
+        ManualClock::advance(1);
+        (void)debounced.poll();
+    }
+    CHECK(sum == 90);
+    CHECK(counter.allocations() == 0);
+}
@@ -0,0 +1,209 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks that assigning a dynamically allocated function object of the same type as the current
+// target reuses the storage of the current target.
+
+#include <rome/delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <stdexcept>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+struct BigFunctor {
+    int* received  = nullptr;
+    int offset     = 0;
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    void operator()(int value) const {
+        *received = value + offset;
+    }
+};
+
+struct OtherBigFunctor {
+    int* received  = nullptr;
+    int offset     = 0;
+    void* dummy[3] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    void operator()(int value) const {
+        *received = value + offset;
+    }
+};
+
+// A big function object that may throw when copied.
+struct ThrowingBigFunctor {
+    int* received  = nullptr;
+    int offset     = 0;
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    ThrowingBigFunctor(int* target, int offsetValue) : received{target}, offset{offsetValue} {
+    }
+    ThrowingBigFunctor(const ThrowingBigFunctor& other)
+        : received{other.received}, offset{other.offset} {
+        if (offset < 0) {
+            throw std::invalid_argument{"negative offset"};
+        }
+    }
+    ThrowingBigFunctor(ThrowingBigFunctor&&) noexcept                  = default;
+    ~ThrowingBigFunctor()                                              = default;
+    auto operator=(const ThrowingBigFunctor&) -> ThrowingBigFunctor& = delete;
+    auto operator=(ThrowingBigFunctor&&) -> ThrowingBigFunctor&      = delete;
+
+    void operator()(int value) const {
+        *received = value + offset;
+    }
+};
+
+// A big function object owning a buffer.
+struct BufferFunctor {
+    std::vector<int> buffer;
+
+    explicit BufferFunctor(std::vector<int> values) noexcept : buffer{std::move(values)} {
+    }
+
+    auto operator()(int value) const -> int {
+        return static_cast<int>(buffer.size()) + value;
+    }
+};
+
+struct SmallFunctor {
+    int* received = nullptr;
+
+    void operator()(int value) const {
+        *received = value;
+    }
+};
+
+}  // namespace
+
+
+// clang-format off
+using test_vector = std::tuple<
+         rome::delegate<void(int), rome::target_is_expected>,
+         rome::delegate<void(int), rome::target_is_optional>,
+         rome::delegate<void(int), rome::target_is_mandatory>,
+     rome::fwd_delegate<void(int), rome::target_is_expected>,
+     rome::fwd_delegate<void(int), rome::target_is_optional>,
+     rome::fwd_delegate<void(int), rome::target_is_mandatory>
+>;
+// clang-format on
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,readability-function-cognitive-complexity)
+TEST_CASE_TEMPLATE_DEFINE("Reassigning a function object of the same type", Delegate,
+    reassign_same_type) {
+    STATIC_REQUIRE(std::is_nothrow_assignable<Delegate&, SmallFunctor>::value);
+    STATIC_REQUIRE(!std::is_nothrow_assignable<Delegate&, BigFunctor>::value);
+
+    int received = 0;
+    Delegate dgt = BigFunctor{&received, 1};
+    const auto* pTarget = dgt.template target<BigFunctor>();
+    REQUIRE(pTarget != nullptr);
+
+    SUBCASE("reuses the storage of the current target") {
+        const BigFunctor lvalue{&received, 3};
+        const test::AllocationCounter counter;
+        dgt = BigFunctor{&received, 2};
+        dgt(1);
+        const auto receivedAfterRvalue = received;
+        dgt = lvalue;
+        (void)dgt.template emplace<BigFunctor>(BigFunctor{&received, 4});
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+        CHECK(receivedAfterRvalue == 3);
+        CHECK(dgt.template target<BigFunctor>() == pTarget);
+        dgt(1);
+        CHECK(received == 5);
+    }
+    SUBCASE("allocates new storage for another type") {
+        const test::AllocationCounter counter;
+        dgt                      = OtherBigFunctor{&received, 2};
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 1);
+        CHECK(deallocations == 1);
+        CHECK(dgt.template target<BigFunctor>() == nullptr);
+        dgt(1);
+        CHECK(received == 3);
+    }
+}
+TEST_CASE_TEMPLATE_APPLY(reassign_same_type, test_vector);
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("Reassigning a function object that may throw when constructed") {
+    int received = 0;
+    rome::command_delegate<void(int)> dgt{ThrowingBigFunctor{&received, 1}};
+
+    SUBCASE("allocates new storage") {
+        const ThrowingBigFunctor lvalue{&received, 2};
+        const test::AllocationCounter counter;
+        dgt                      = lvalue;
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 1);
+        CHECK(deallocations == 1);
+        dgt(1);
+        CHECK(received == 3);
+    }
+    SUBCASE("keeps the current target if the construction throws") {
+        const ThrowingBigFunctor lvalue{&received, -1};
+        CHECK_THROWS_AS(dgt = lvalue, std::invalid_argument);
+        dgt(1);
+        CHECK(received == 2);
+    }
+    SUBCASE("reuses the storage when moved") {
+        const test::AllocationCounter counter;
+        dgt                      = ThrowingBigFunctor{&received, 3};
+        const auto allocations   = counter.allocations();
+        const auto deallocations = counter.deallocations();
+        CHECK(allocations == 0);
+        CHECK(deallocations == 0);
+        dgt(1);
+        CHECK(received == 4);
+    }
+}
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("Reassigning the current target or one of its members") {
+    rome::delegate<int(int)> dgt = BufferFunctor{{1, 2, 3, 4, 5}};
+    auto* pTarget                = dgt.target<BufferFunctor>();
+    REQUIRE(pTarget != nullptr);
+
+    SUBCASE("moved") {
+        dgt = std::move(*pTarget);
+        REQUIRE(dgt.target<BufferFunctor>() != nullptr);
+        CHECK(dgt.target<BufferFunctor>()->buffer.size() == 5);
+        CHECK(dgt(0) == 5);
+    }
+    SUBCASE("copied") {
+        dgt = *pTarget;
+        CHECK(dgt(0) == 5);
+    }
+    SUBCASE("member emplaced") {
+        (void)dgt.emplace<BufferFunctor>(std::move(pTarget->buffer));
+        CHECK(dgt(0) == 5);
+    }
+    SUBCASE("reuses the storage otherwise") {
+        const test::AllocationCounter counter;
+        (void)dgt.emplace<BufferFunctor>(std::vector<int>{1, 2});
+        CHECK(counter.deallocations() == 1);  // the buffer of the current target only
+        CHECK(dgt.target<BufferFunctor>() == pTarget);
+        CHECK(dgt(0) == 2);
+    }
+}
@@ -0,0 +1,149 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+// Checks `target<F>()` and `invoke_as<F>(args...)` for all kinds of stored function objects.
+
+#include <rome/delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <test/doctest_extensions.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+struct StatelessFunctor {
+    auto operator()(int value) const -> int {
+        return value + 1;
+    }
+};
+
+struct StatelessVoidFunctor {
+    void operator()(int /*unused*/) const {
+    }
+};
+
+struct SmallFunctor {
+    int summand = 2;
+    int calls   = 0;
+    auto operator()(int value) -> int {
+        ++calls;
+        return value + summand;
+    }
+};
+
+struct BigFunctor {
+    int summand    = 3;
+    int calls      = 0;
+    void* dummy[2] = {};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    auto operator()(int value) -> int {
+        ++calls;
+        return value + summand;
+    }
+};
+
+auto function(int value) -> int {
+    return value + 4;
+}
+
+
+template<typename Delegate, typename Functor>
+struct input_params {
+    using delegate = Delegate;
+    using functor  = Functor;
+};
+
+}  // namespace
+
+
+// clang-format off
+using test_vector = std::tuple<
+    input_params<     rome::delegate<int(int), rome::target_is_expected>,  StatelessFunctor >,
+    input_params<     rome::delegate<int(int), rome::target_is_mandatory>, StatelessFunctor >,
+    input_params<     rome::delegate<int(int), rome::target_is_expected>,  SmallFunctor >,
+    input_params<     rome::delegate<int(int), rome::target_is_mandatory>, SmallFunctor >,
+    input_params<     rome::delegate<int(int), rome::target_is_expected>,  BigFunctor >,
+    input_params<     rome::delegate<int(int), rome::target_is_mandatory>, BigFunctor >
+>;
+// clang-format on
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,readability-function-cognitive-complexity)
+TEST_CASE_TEMPLATE_DEFINE("target<F>() and invoke_as<F>() of a delegate with a function object",
+    InputParams, delegate_target_access) {
+    using Delegate = typename InputParams::delegate;
+    using Functor  = typename InputParams::functor;
+    using Other    = std::conditional_t<std::is_same<Functor, SmallFunctor>::value, BigFunctor,
+        SmallFunctor>;
+
+    STATIC_REQUIRE(std::is_same<decltype(std::declval<Delegate&>().template target<Functor>()),
+        Functor*>::value);
+    STATIC_REQUIRE(
+        std::is_same<decltype(std::declval<const Delegate&>().template target<Functor>()),
+            const Functor*>::value);
+
+    Delegate dgt{Functor{}};
+    const auto& constDgt = dgt;
+    REQUIRE(dgt.template target<Functor>() != nullptr);
+    CHECK(constDgt.template target<Functor>() == dgt.template target<Functor>());
+    CHECK(dgt.template target<Other>() == nullptr);
+
+    const auto expected = (*dgt.template target<Functor>())(10);
+    CHECK(dgt.template invoke_as<Functor>(10) == expected);
+    CHECK(dgt.template invoke_as<Other>(10) == expected);
+    CHECK(dgt(10) == expected);
+
+    auto moved = std::move(dgt);
+    CHECK(moved.template target<Functor>() != nullptr);
+    CHECK(dgt.template target<Functor>() == nullptr);  // NOLINT(bugprone-use-after-move)
+}
+TEST_CASE_TEMPLATE_APPLY(delegate_target_access, test_vector);
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("target<F>() refers to the stored function object") {
+    rome::delegate<int(int)> small = SmallFunctor{};
+    rome::delegate<int(int)> big   = BigFunctor{};
+    (void)small(1);
+    (void)small.invoke_as<SmallFunctor>(1);
+    (void)big(1);
+    (void)big.invoke_as<BigFunctor>(1);
+    CHECK(small.target<SmallFunctor>()->calls == 2);
+    CHECK(big.target<BigFunctor>()->calls == 2);
+
+    small.target<SmallFunctor>()->summand = 10;
+    CHECK(small(1) == 11);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("target<F>() of an empty delegate or a delegate without function object is nullptr") {
+    rome::delegate<int(int)> empty;
+    CHECK(empty.target<SmallFunctor>() == nullptr);
+    CHECK_THROWS_AS(empty.invoke_as<SmallFunctor>(1), rome::bad_delegate_call);
+
+    rome::event_delegate<void(int)> emptyEvent;
+    CHECK(emptyEvent.target<StatelessVoidFunctor>() == nullptr);
+    CHECK_NOTHROW(emptyEvent.invoke_as<StatelessVoidFunctor>(1));
+
+    auto fromFunction = rome::delegate<int(int)>::create<&function>();
+    CHECK(fromFunction.target<StatelessFunctor>() == nullptr);
+    CHECK(fromFunction.invoke_as<StatelessFunctor>(1) == 5);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("target<F>() and invoke_as<F>() of a fwd_delegate") {
+    int received  = 0;
+    auto functor  = [&received](int value) { received = value; };
+    using Functor = decltype(functor);
+
+    rome::command_delegate<void(int)> dgt{functor};
+    CHECK(dgt.target<Functor>() != nullptr);
+    dgt.invoke_as<Functor>(42);
+    CHECK(received == 42);
+}
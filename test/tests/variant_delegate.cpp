@@ -0,0 +1,227 @@
+//
+// Project: C++ delegates
+//
+// Copyright Roger Mettler 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// https://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <rome/variant_delegate.hpp>
+
+#include <doctest/doctest.h>
+#include <test/allocation_counter.hpp>
+#include <test/doctest_extensions.hpp>
+#include <type_traits>
+#include <utility>
+
+
+namespace {
+
+// Counts the living objects of all target types.
+int liveTargets = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+struct CountedTarget {
+    CountedTarget() noexcept {
+        ++liveTargets;
+    }
+    CountedTarget(const CountedTarget& /*unused*/) noexcept {
+        ++liveTargets;
+    }
+    CountedTarget(CountedTarget&& /*unused*/) noexcept {
+        ++liveTargets;
+    }
+    ~CountedTarget() {
+        --liveTargets;
+    }
+    auto operator=(const CountedTarget&) -> CountedTarget& = delete;
+    auto operator=(CountedTarget&&) -> CountedTarget&      = delete;
+};
+
+struct AddTarget : CountedTarget {
+    int summand = 0;
+
+    explicit AddTarget(int value) noexcept : summand{value} {
+    }
+
+    auto operator()(int value) -> int {
+        return value + summand;
+    }
+};
+
+struct DoubleTarget : CountedTarget {
+    auto operator()(int value) const -> int {
+        return value * 2;
+    }
+};
+
+struct BigTarget : CountedTarget {
+    int values[8] = {1, 2, 3, 4, 5, 6, 7, 8};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    auto operator()(int index) const -> int {
+        return values[index];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+};
+
+struct RecordTarget {
+    int* record = nullptr;
+
+    void operator()(int value) const {
+        *record = value;
+    }
+};
+
+using int_variant = rome::variant_delegate<int(int), AddTarget, DoubleTarget, BigTarget>;
+
+}  // namespace
+
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::variant_delegate - behavior is selected by the optional first parameter") {
+    STATIC_REQUIRE(std::is_same<int_variant, rome::basic_variant_delegate<int(int),
+                                                 rome::target_is_expected, AddTarget, DoubleTarget,
+                                                 BigTarget>>::value);
+    STATIC_REQUIRE(std::is_same<rome::variant_delegate<void(int), rome::target_is_optional,
+                                    RecordTarget>,
+        rome::basic_variant_delegate<void(int), rome::target_is_optional, RecordTarget>>::value);
+    STATIC_REQUIRE(std::is_same<rome::variant_delegate<int(int), rome::target_is_mandatory,
+                                    DoubleTarget>,
+        rome::basic_variant_delegate<int(int), rome::target_is_mandatory, DoubleTarget>>::value);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::variant_delegate - type constraints") {
+    using mandatory_variant =
+        rome::variant_delegate<int(int), rome::target_is_mandatory, AddTarget, DoubleTarget>;
+    STATIC_REQUIRE(std::is_nothrow_default_constructible<int_variant>::value);
+    STATIC_REQUIRE(!std::is_default_constructible<mandatory_variant>::value);
+    STATIC_REQUIRE(!std::is_copy_constructible<int_variant>::value);
+    STATIC_REQUIRE(!std::is_copy_assignable<int_variant>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible<int_variant>::value);
+    STATIC_REQUIRE(std::is_nothrow_move_assignable<int_variant>::value);
+    STATIC_REQUIRE(std::is_nothrow_constructible<int_variant, DoubleTarget>::value);
+    STATIC_REQUIRE(std::is_nothrow_constructible<mandatory_variant, AddTarget>::value);
+    STATIC_REQUIRE(!std::is_constructible<mandatory_variant, BigTarget>::value);
+    STATIC_REQUIRE(!std::is_constructible<int_variant, RecordTarget>::value);
+    STATIC_REQUIRE(!std::is_constructible<int_variant, int (*)(int)>::value);
+    STATIC_REQUIRE(sizeof(int_variant) == sizeof(BigTarget) + sizeof(std::size_t));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::variant_delegate - calling an empty variant delegate") {
+    SUBCASE("target_is_expected") {
+        const int_variant dgt;
+        CHECK(!dgt);
+        CHECK(dgt == nullptr);
+        CHECK(nullptr == dgt);
+        CHECK_THROWS_AS(dgt(1), rome::bad_delegate_call);
+    }
+    SUBCASE("target_is_optional") {
+        const rome::variant_delegate<void(int), rome::target_is_optional, RecordTarget> dgt;
+        CHECK(!dgt);
+        CHECK_NOTHROW(dgt(1));
+    }
+    SUBCASE("target_is_mandatory after move") {
+        rome::variant_delegate<int(int), rome::target_is_mandatory, DoubleTarget> dgt{
+            DoubleTarget{}};
+        auto other = std::move(dgt);
+        CHECK(other(2) == 4);
+        CHECK(!dgt);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+        CHECK_THROWS_AS(dgt(1), rome::bad_delegate_call);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::variant_delegate - calls the assigned target") {
+    REQUIRE(liveTargets == 0);
+    {
+        int_variant dgt = AddTarget{10};
+        CHECK(dgt);
+        CHECK(dgt != nullptr);
+        CHECK(nullptr != dgt);
+        CHECK(dgt(1) == 11);
+        CHECK(liveTargets == 1);
+
+        dgt = DoubleTarget{};
+        CHECK(dgt(3) == 6);
+        CHECK(liveTargets == 1);
+
+        dgt = BigTarget{};
+        CHECK(dgt(3) == 4);
+        CHECK(liveTargets == 1);
+
+        dgt = nullptr;
+        CHECK(!dgt);
+        CHECK(liveTargets == 0);
+
+        dgt = AddTarget{5};
+        CHECK(dgt(1) == 6);
+    }
+    CHECK(liveTargets == 0);
+
+    int record = 0;
+    const rome::variant_delegate<void(int), rome::target_is_optional, RecordTarget> dgt =
+        RecordTarget{&record};
+    dgt(42);
+    CHECK(record == 42);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::variant_delegate - move and swap") {
+    REQUIRE(liveTargets == 0);
+    {
+        int_variant dgt1 = AddTarget{1};
+        int_variant dgt2 = DoubleTarget{};
+
+        SUBCASE("move construct") {
+            int_variant dgt3 = std::move(dgt1);
+            CHECK(!dgt1);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+            CHECK(dgt3(1) == 2);
+            CHECK(liveTargets == 2);
+        }
+        SUBCASE("move assign") {
+            dgt2 = std::move(dgt1);
+            CHECK(!dgt1);  // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+            CHECK(dgt2(1) == 2);
+            CHECK(liveTargets == 1);
+        }
+        SUBCASE("move assign empty") {
+            dgt2 = int_variant{};
+            CHECK(!dgt2);
+            CHECK(liveTargets == 1);
+        }
+        SUBCASE("swap") {
+            dgt1.swap(dgt2);
+            CHECK(dgt1(1) == 2);
+            CHECK(dgt2(1) == 2);
+            CHECK(dgt1(2) == 4);
+            CHECK(dgt2(2) == 3);
+            CHECK(liveTargets == 2);
+        }
+        SUBCASE("swap with empty") {
+            int_variant empty;
+            empty.swap(dgt1);
+            CHECK(!dgt1);
+            CHECK(empty(1) == 2);
+            CHECK(liveTargets == 2);
+        }
+    }
+    CHECK(liveTargets == 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace,cert-err58-cpp)
+TEST_CASE("rome::variant_delegate - never allocates") {
+    const test::AllocationCounter counter;
+    {
+        int_variant dgt1 = BigTarget{};
+        int_variant dgt2 = AddTarget{1};
+        (void)dgt1(1);
+        dgt1.swap(dgt2);
+        dgt2 = std::move(dgt1);
+        (void)dgt2(1);
+    }
+    const auto allocations   = counter.allocations();
+    const auto deallocations = counter.deallocations();
+    CHECK(allocations == 0);
+    CHECK(deallocations == 0);
+}